@@ -0,0 +1,121 @@
+#ifndef RD_CPP_BENCHMARKENTITIES_H
+#define RD_CPP_BENCHMARKENTITIES_H
+
+#include "base/IRdReactive.h"
+#include "base/IWire.h"
+#include "impl/RName.h"
+#include "scheduler/base/IScheduler.h"
+
+#include "std/unordered_map.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace rd
+{
+namespace bench
+{
+/**
+ * \brief Runs actions right on the dispatching thread, so only the cost of the code under test is measured.
+ */
+class InlineScheduler : public IScheduler
+{
+public:
+	void queue(std::function<void()> action) override
+	{
+		action();
+	}
+
+	void flush() override
+	{
+	}
+
+	bool is_active() const override
+	{
+		return true;
+	}
+};
+
+/**
+ * \brief Minimal reactive entity which is not bound to a protocol, only receives messages from a broker or a wire.
+ */
+class ReactiveStub : public IRdReactive
+{
+	mutable RdId id;
+	IScheduler* scheduler;
+
+public:
+	ReactiveStub(RdId id, IScheduler* scheduler) : id(id), scheduler(scheduler)
+	{
+	}
+
+	void set_id(RdId new_id) const override
+	{
+		id = new_id;
+	}
+
+	RdId get_id() const override
+	{
+		return id;
+	}
+
+	void bind(Lifetime, IRdDynamic const*, string_view) const override
+	{
+	}
+
+	void identify(Identities const&, RdId const&) const override
+	{
+	}
+
+	IProtocol const* get_protocol() const override
+	{
+		return nullptr;
+	}
+
+	SerializationCtx& get_serialization_context() const override
+	{
+		throw std::logic_error("not bound to a protocol");
+	}
+
+	RName const& get_location() const override
+	{
+		static RName location("ReactiveStub");
+		return location;
+	}
+
+	IScheduler* get_wire_scheduler() const override
+	{
+		return scheduler;
+	}
+};
+
+/**
+ * \brief Hands every message right away to the entity with the same id behind [counterpart], so a change, its
+ * acknowledgement and the entities' handling of both are measured without a socket or a thread in between.
+ */
+class LoopbackWire : public IWire
+{
+	mutable rd::unordered_map<RdId, IRdReactive const*> entities;
+
+public:
+	LoopbackWire const* counterpart = nullptr;
+
+	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override
+	{
+		Buffer buffer;
+		writer(buffer);
+		const bool compact = buffer.is_compact();
+		Buffer message(std::move(buffer).getRealArray());
+		message.set_compact(compact);
+		counterpart->entities.at(id)->on_wire_received(std::move(message));
+	}
+
+	void advise(Lifetime, IRdReactive const* entity) const override
+	{
+		entities[entity->get_id()] = entity;
+	}
+};
+}	 // namespace bench
+}	 // namespace rd
+
+#endif	  // RD_CPP_BENCHMARKENTITIES_H
@@ -0,0 +1,125 @@
+#include "BenchmarkRunner.h"
+
+#include "spdlog/spdlog.h"
+
+#include <cstdio>
+#include <utility>
+
+namespace rd
+{
+namespace bench
+{
+static std::vector<std::pair<std::string, benchmark_t>>& registry()
+{
+	static std::vector<std::pair<std::string, benchmark_t>> benchmarks;
+	return benchmarks;
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(char const* name, benchmark_t benchmark)
+{
+	registry().emplace_back(name, benchmark);
+}
+
+void BenchmarkState::report(std::string const& variant, int64_t operations, double seconds)
+{
+	BenchmarkResult result{variant.empty() ? name : name + "/" + variant, operations, seconds};
+	std::printf("%-56s %12lld ops %12.1f ns/op %14.0f ops/s\n", result.name.c_str(), static_cast<long long>(operations),
+		result.ns_per_op(), result.ops_per_second());
+	std::fflush(stdout);
+	results.push_back(std::move(result));
+}
+
+static std::string escape_json(std::string const& value)
+{
+	std::string result;
+	for (char c : value)
+	{
+		if (c == '"' || c == '\\')
+		{
+			result += '\\';
+			result += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			char code[8];
+			std::snprintf(code, sizeof(code), "\\u%04x", c);
+			result += code;
+		}
+		else
+		{
+			result += c;
+		}
+	}
+	return result;
+}
+
+/**
+ * \brief Writes [results] as {"benchmarks": [{"name": ..., "operations": ..., ...}]}, so runs can be compared by
+ * tools tracking regressions.
+ */
+static bool write_json(std::string const& path, std::vector<BenchmarkResult> const& results)
+{
+	FILE* file = std::fopen(path.c_str(), "w");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	std::fprintf(file, "{\n  \"benchmarks\": [");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		auto const& result = results[i];
+		std::fprintf(file,
+			"%s\n    {\"name\": \"%s\", \"operations\": %lld, \"seconds\": %.9g, \"ns_per_op\": %.6g, "
+			"\"ops_per_second\": %.6g}",
+			i == 0 ? "" : ",", escape_json(result.name).c_str(), static_cast<long long>(result.operations), result.seconds,
+			result.ns_per_op(), result.ops_per_second());
+	}
+	std::fprintf(file, "\n  ]\n}\n");
+	return std::fclose(file) == 0;
+}
+}	 // namespace bench
+}	 // namespace rd
+
+int main(int argc, char** argv)
+{
+	// same level RiderLink runs with, wire and broker log on every message otherwise
+	spdlog::set_level(spdlog::level::err);
+
+	// rd_benchmarks [filter] [--json <file>]
+	std::string filter;
+	std::string json_path;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--json" && i + 1 < argc)
+		{
+			json_path = argv[++i];
+		}
+		else if (arg.compare(0, 7, "--json=") == 0)
+		{
+			json_path = arg.substr(7);
+		}
+		else
+		{
+			filter = arg;
+		}
+	}
+
+	std::vector<rd::bench::BenchmarkResult> results;
+	for (auto const& benchmark : rd::bench::registry())
+	{
+		if (!filter.empty() && benchmark.first.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+		rd::bench::BenchmarkState state(benchmark.first, results);
+		benchmark.second(state);
+	}
+
+	if (!json_path.empty() && !rd::bench::write_json(json_path, results))
+	{
+		std::fprintf(stderr, "failed to write %s\n", json_path.c_str());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,91 @@
+#ifndef RD_CPP_BENCHMARKRUNNER_H
+#define RD_CPP_BENCHMARKRUNNER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace rd
+{
+namespace bench
+{
+struct BenchmarkResult
+{
+	std::string name;
+	int64_t operations = 0;
+	double seconds = 0;
+
+	double ns_per_op() const
+	{
+		return operations == 0 ? 0 : seconds * 1e9 / static_cast<double>(operations);
+	}
+
+	double ops_per_second() const
+	{
+		return seconds == 0 ? 0 : static_cast<double>(operations) / seconds;
+	}
+};
+
+/**
+ * \brief Handed to every benchmark. One benchmark may measure several variants (thread count, payload size, ...),
+ * each of them is reported as a separate result named "benchmark/variant".
+ */
+class BenchmarkState
+{
+	std::string name;
+	std::vector<BenchmarkResult>& results;
+
+public:
+	BenchmarkState(std::string name, std::vector<BenchmarkResult>& results) : name(std::move(name)), results(results)
+	{
+	}
+
+	/**
+	 * \brief Times a single run of [body] which is expected to perform [operations] operations.
+	 */
+	template <typename F>
+	void measure(std::string const& variant, int64_t operations, F&& body)
+	{
+		using clock = std::chrono::steady_clock;
+
+		const auto start = clock::now();
+		body();
+		const auto finish = clock::now();
+
+		report(variant, operations, std::chrono::duration<double>(finish - start).count());
+	}
+
+	void report(std::string const& variant, int64_t operations, double seconds);
+};
+
+using benchmark_t = void (*)(BenchmarkState&);
+
+struct BenchmarkRegistrar
+{
+	BenchmarkRegistrar(char const* name, benchmark_t benchmark);
+};
+
+/**
+ * \brief Prevents the optimizer from dropping a computation whose result is otherwise unused.
+ */
+template <typename T>
+inline void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile char sink;
+	sink = *reinterpret_cast<char const volatile*>(&value);
+#endif
+}
+}	 // namespace bench
+}	 // namespace rd
+
+#define RD_BENCHMARK(benchmark_name)                                                                \
+	static void benchmark_name(rd::bench::BenchmarkState& state);                                   \
+	static rd::bench::BenchmarkRegistrar benchmark_name##_registrar(#benchmark_name, &benchmark_name); \
+	static void benchmark_name(rd::bench::BenchmarkState& state)
+
+#endif	  // RD_CPP_BENCHMARKRUNNER_H
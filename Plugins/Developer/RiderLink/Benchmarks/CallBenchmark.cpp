@@ -0,0 +1,100 @@
+#include "BenchmarkRunner.h"
+#include "BenchmarkEntities.h"
+
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Protocol.h"
+#include "task/RdCall.h"
+#include "task/RdEndpoint.h"
+#include "wire/SocketWire.h"
+
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using rd::bench::InlineScheduler;
+
+constexpr int32_t CALLS = 2'000;
+constexpr int32_t DELAYED_CALLS = 50;
+constexpr auto RESPONSE_DELAY = std::chrono::milliseconds(5);
+constexpr int64_t CALL_ID = 1;
+constexpr int64_t DELAYED_CALL_ID = 2;
+}	 // namespace
+
+RD_BENCHMARK(RdCall_sync)
+{
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+
+	auto server_wire = std::make_shared<rd::SocketWire::Server>(definition.lifetime, &scheduler, 0, "CallBenchServer");
+	auto client_wire =
+		std::make_shared<rd::SocketWire::Client>(definition.lifetime, &scheduler, server_wire->port, "CallBenchClient");
+	rd::Protocol server(rd::Identities::SERVER, &scheduler, server_wire, definition.lifetime);
+	rd::Protocol client(rd::Identities::CLIENT, &scheduler, client_wire, definition.lifetime);
+
+	// the editor's allowSetForegroundWindow: a small request answered right away by the counterpart
+	rd::RdCall<int32_t, bool> call;
+	rd::RdEndpoint<int32_t, bool> endpoint([](int32_t const& pid) { return pid > 0; });
+	rd::statics(call, CALL_ID).bind(definition.lifetime, &client, "allowSetForegroundWindow");
+	rd::statics(endpoint, CALL_ID).bind(definition.lifetime, &server, "allowSetForegroundWindow");
+
+	// answered after a while by another thread of the counterpart, e.g. when Rider has to bring a window up first
+	std::vector<std::thread> responders;
+	rd::RdCall<int32_t, bool> delayed_call;
+	rd::RdEndpoint<int32_t, bool> delayed_endpoint([&responders](rd::Lifetime, int32_t const&) {
+		rd::RdTask<bool> task;
+		responders.emplace_back([task] {
+			std::this_thread::sleep_for(RESPONSE_DELAY);
+			task.set(true);
+		});
+		return task;
+	});
+	rd::statics(delayed_call, DELAYED_CALL_ID).bind(definition.lifetime, &client, "delayedCall");
+	rd::statics(delayed_endpoint, DELAYED_CALL_ID).bind(definition.lifetime, &server, "delayedCall");
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	while (!(server_wire->connected.get() && client_wire->connected.get()))
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			std::printf("failed to connect\n");
+			return;
+		}
+		std::this_thread::yield();
+	}
+
+	int32_t succeeded = 0;
+	state.measure("round_trip", CALLS, [&] {
+		for (int32_t i = 1; i <= CALLS; ++i)
+		{
+			succeeded += call.sync(i, std::chrono::milliseconds(5000)).value_or_throw().unwrap();
+		}
+	});
+	if (succeeded != CALLS)
+	{
+		std::printf("    %d of %d calls succeeded\n", succeeded, CALLS);
+	}
+	// answered requests used to stay in the endpoint for as long as it was bound
+	const auto stats = endpoint.get_stats();
+	std::printf("    endpoint: %d in flight, %lld completed, handler p50 %lld ns\n", stats.in_flight,
+		static_cast<long long>(stats.completed), static_cast<long long>(stats.handler_latency.percentile(0.5).count()));
+
+	// CPU time of the process while the caller waits, reported as the time of a call
+	const std::clock_t cpu_start = std::clock();
+	for (int32_t i = 1; i <= DELAYED_CALLS; ++i)
+	{
+		delayed_call.sync(i, std::chrono::milliseconds(5000));
+	}
+	const double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+	state.report("delayed_response:5ms/cpu", DELAYED_CALLS, cpu_seconds);
+	for (auto& responder : responders)
+	{
+		responder.join();
+	}
+
+	definition.terminate();
+}
@@ -0,0 +1,160 @@
+#include "BenchmarkRunner.h"
+#include "BenchmarkEntities.h"
+
+#include "impl/RdList.h"
+#include "impl/RdMap.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Protocol.h"
+#include "wire/SocketWire.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using rd::bench::InlineScheduler;
+using rd::bench::LoopbackWire;
+
+constexpr int32_t ENTRIES = 10'000;
+constexpr int32_t UPDATES = 200'000;
+constexpr int32_t KEYS = 256;
+constexpr int64_t MAP_ID = 1;
+constexpr int64_t LIST_ID = 2;
+
+bool wait_for(std::atomic<int64_t> const& counter, int64_t expected)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	while (counter.load() < expected)
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	return true;
+}
+}	 // namespace
+
+RD_BENCHMARK(Collection_batch)
+{
+	for (bool batched : {false, true})
+	{
+		InlineScheduler scheduler;
+		rd::LifetimeDefinition definition(false);
+
+		auto server_wire = std::make_shared<rd::SocketWire::Server>(definition.lifetime, &scheduler, 0, "BatchBenchServer");
+		server_wire->set_batch_messages_enabled(batched);
+		auto client_wire =
+			std::make_shared<rd::SocketWire::Client>(definition.lifetime, &scheduler, server_wire->port, "BatchBenchClient");
+		client_wire->set_batch_messages_enabled(batched);
+
+		rd::Protocol server(rd::Identities::SERVER, &scheduler, server_wire, definition.lifetime);
+		rd::Protocol client(rd::Identities::CLIENT, &scheduler, client_wire, definition.lifetime);
+
+		rd::RdMap<int32_t, std::wstring> server_map;
+		rd::RdMap<int32_t, std::wstring> client_map;
+		rd::RdList<int32_t> server_list;
+		rd::RdList<int32_t> client_list;
+		rd::statics(server_map, MAP_ID).bind(definition.lifetime, &server, "blueprints");
+		rd::statics(client_map, MAP_ID).bind(definition.lifetime, &client, "blueprints");
+		rd::statics(server_list, LIST_ID).bind(definition.lifetime, &server, "selection");
+		rd::statics(client_list, LIST_ID).bind(definition.lifetime, &client, "selection");
+
+		std::atomic<int64_t> received{0};
+		server_map.advise(definition.lifetime, [&received](rd::IViewableMap<int32_t, std::wstring>::Event const&) { ++received; });
+		server_list.advise(definition.lifetime, [&received](rd::IViewableList<int32_t>::Event const&) { ++received; });
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+		while (!(server_wire->connected.get() && client_wire->connected.get()))
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				std::printf("failed to connect\n");
+				return;
+			}
+			std::this_thread::yield();
+		}
+		// capabilities are exchanged right after connecting
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		const std::string suffix = std::string("/batch:") + (batched ? "on" : "off");
+		std::vector<std::pair<int32_t, rd::Wrapper<std::wstring>>> entries;
+		entries.reserve(ENTRIES);
+		for (int32_t i = 0; i < ENTRIES; ++i)
+		{
+			entries.emplace_back(i, L"/Game/Blueprints/BP_Actor_" + std::to_wstring(i));
+		}
+		bool delivered = true;
+		state.measure("map/put_all" + suffix, ENTRIES, [&] {
+			client_map.putAll(std::move(entries));
+			delivered = wait_for(received, ENTRIES);
+		});
+
+		std::vector<int32_t> elements(ENTRIES);
+		for (int32_t i = 0; i < ENTRIES; ++i)
+		{
+			elements[i] = i;
+		}
+		state.measure("list/add_all" + suffix, ENTRIES, [&] {
+			client_list.addAll(std::move(elements));
+			delivered = wait_for(received, 2 * ENTRIES) && delivered;
+		});
+		if (!delivered)
+		{
+			std::printf("    timed out, %lld of %d changes received\n", static_cast<long long>(received.load()), 2 * ENTRIES);
+		}
+
+		definition.terminate();
+	}
+}
+
+RD_BENCHMARK(RdMap_update_round_trip)
+{
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+
+	auto master_wire = std::make_shared<LoopbackWire>();
+	auto slave_wire = std::make_shared<LoopbackWire>();
+	master_wire->counterpart = slave_wire.get();
+	slave_wire->counterpart = master_wire.get();
+	rd::Protocol master(rd::Identities::SERVER, &scheduler, master_wire, definition.lifetime);
+	rd::Protocol slave(rd::Identities::CLIENT, &scheduler, slave_wire, definition.lifetime);
+
+	// a master map is versioned: each update the other side applies is acknowledged back with its key
+	rd::RdMap<std::wstring, int32_t> master_map;
+	rd::RdMap<std::wstring, int32_t> slave_map;
+	master_map.is_master = true;
+	rd::statics(master_map, MAP_ID).bind(definition.lifetime, &master, "assets");
+	rd::statics(slave_map, MAP_ID).bind(definition.lifetime, &slave, "assets");
+
+	std::vector<std::wstring> keys;
+	for (int32_t i = 0; i < KEYS; ++i)
+	{
+		keys.push_back(L"/Game/Maps/Level_" + std::to_wstring(i) + L".Level_" + std::to_wstring(i));
+	}
+
+	state.measure("set/versioned", UPDATES, [&] {
+		for (int32_t i = 0; i < UPDATES; ++i)
+		{
+			master_map.set(keys[i % KEYS], i);
+		}
+	});
+	state.measure("set/unversioned", UPDATES, [&] {
+		for (int32_t i = 0; i < UPDATES; ++i)
+		{
+			slave_map.set(keys[i % KEYS], -i);
+		}
+	});
+	if (master_map.size() != slave_map.size())
+	{
+		std::printf("    maps differ: %zu and %zu entries\n", master_map.size(), slave_map.size());
+	}
+
+	definition.terminate();
+}
@@ -0,0 +1,200 @@
+#include "BenchmarkRunner.h"
+#include "BenchmarkEntities.h"
+
+#include "impl/RName.h"
+#include "intern/InternRoot.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Protocol.h"
+#include "protocol/RdId.h"
+#include "wire/ReplayWire.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using rd::bench::InlineScheduler;
+
+constexpr int32_t VALUES = 100'000;
+constexpr int32_t NAMES = 100'000;
+constexpr int32_t IDS = 1'000'000;
+constexpr int32_t THREADS = 4;
+}	 // namespace
+
+RD_BENCHMARK(InternRoot_intern)
+{
+	// the wire only serializes definitions, so the cost of the root itself is measured
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+	auto wire = std::make_shared<rd::ReplayWire>(&scheduler);
+	rd::Protocol protocol(rd::Identities::SERVER, &scheduler, wire, definition.lifetime);
+
+	rd::InternRoot root;
+	root.set_id(rd::RdId::Null().mix("BenchmarkInternRoot"));
+	root.bind(definition.lifetime, &protocol, "BenchmarkInternRoot");
+
+	std::vector<rd::Wrapper<std::wstring>> values;
+	values.reserve(VALUES);
+	for (int32_t i = 0; i < VALUES; ++i)
+	{
+		values.push_back(rd::wrapper::make_wrapper<std::wstring>(L"/Game/Blueprints/BP_Actor_" + std::to_wstring(i)));
+	}
+
+	std::vector<int32_t> ids(VALUES);
+	state.measure("wstring/new", VALUES, [&] {
+		for (int32_t i = 0; i < VALUES; ++i)
+		{
+			ids[i] = root.intern_value<std::wstring>(values[i]);
+		}
+	});
+
+	state.measure("wstring/existing", VALUES, [&] {
+		for (int32_t i = 0; i < VALUES; ++i)
+		{
+			ids[i] = root.intern_value<std::wstring>(values[i]);
+		}
+	});
+
+	size_t characters = 0;
+	state.measure("wstring/un_intern", VALUES, [&] {
+		for (int32_t i = 0; i < VALUES; ++i)
+		{
+			characters += root.un_intern_value<std::wstring>(ids[i])->size();
+		}
+	});
+	rd::bench::do_not_optimize(characters);
+
+	// definitions of the counterpart as they come from the wire
+	auto& ctx = protocol.get_serialization_context();
+	std::vector<rd::Buffer::ByteArray> messages;
+	messages.reserve(VALUES);
+	for (int32_t i = 0; i < VALUES; ++i)
+	{
+		rd::Buffer buffer;
+		rd::InternedAnySerializer::write<std::wstring>(ctx, buffer, *values[i]);
+		buffer.write_integral<int32_t>(2 * i);
+		messages.push_back(std::move(buffer).getRealArray());
+	}
+	state.measure("wstring/received", VALUES, [&] {
+		for (auto& message : messages)
+		{
+			root.on_wire_received(rd::Buffer(std::move(message)));
+		}
+	});
+
+	state.measure("wstring/un_intern_received", VALUES, [&] {
+		for (int32_t i = 0; i < VALUES; ++i)
+		{
+			characters += root.un_intern_value<std::wstring>(2 * i + 1)->size();
+		}
+	});
+	rd::bench::do_not_optimize(characters);
+
+	definition.terminate();
+}
+
+RD_BENCHMARK(InternRoot_concurrent)
+{
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+	auto wire = std::make_shared<rd::ReplayWire>(&scheduler);
+	rd::Protocol protocol(rd::Identities::SERVER, &scheduler, wire, definition.lifetime);
+
+	rd::InternRoot root;
+	root.set_id(rd::RdId::Null().mix("BenchmarkInternRoot"));
+	root.bind(definition.lifetime, &protocol, "BenchmarkInternRoot");
+
+	// every thread interns values of its own and reads back what it interned, as serializing threads of an editor do
+	std::vector<std::vector<rd::Wrapper<std::wstring>>> values(THREADS);
+	for (int32_t t = 0; t < THREADS; ++t)
+	{
+		values[t].reserve(VALUES / THREADS);
+		for (int32_t i = 0; i < VALUES / THREADS; ++i)
+		{
+			values[t].push_back(rd::wrapper::make_wrapper<std::wstring>(
+				L"/Game/Maps/Level_" + std::to_wstring(t) + L"/Actor_" + std::to_wstring(i)));
+		}
+	}
+
+	const auto run_threads = [&] {
+		std::vector<std::thread> threads;
+		for (int32_t t = 0; t < THREADS; ++t)
+		{
+			threads.emplace_back([&, t] {
+				size_t characters = 0;
+				for (auto const& value : values[t])
+				{
+					const int32_t id = root.intern_value<std::wstring>(value);
+					characters += root.un_intern_value<std::wstring>(id)->size();
+				}
+				rd::bench::do_not_optimize(characters);
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	};
+
+	state.measure("wstring/new/threads:" + std::to_string(THREADS), VALUES, run_threads);
+	state.measure("wstring/existing/threads:" + std::to_string(THREADS), VALUES, run_threads);
+
+	definition.terminate();
+}
+
+RD_BENCHMARK(RName_location)
+{
+	// locations as models nest them: Protocol.Model.map[key].property
+	rd::RName root("Protocol");
+	auto map = root.sub("Model", ".").sub("entities", ".");
+
+	std::vector<rd::RName> entries;
+	entries.reserve(NAMES);
+	state.measure("sub", NAMES, [&] {
+		for (int32_t i = 0; i < NAMES; ++i)
+		{
+			entries.push_back(map.sub("[" + std::to_string(i) + "]", "").sub("property", "."));
+		}
+	});
+
+	size_t length = 0;
+	state.measure("to_string", NAMES, [&] {
+		for (auto const& entry : entries)
+		{
+			length += rd::to_string(entry).size();
+		}
+	});
+	rd::bench::do_not_optimize(length);
+
+	// the same location built again, e.g. by a rebinding entity
+	size_t equal = 0;
+	state.measure("compare", NAMES, [&] {
+		for (int32_t i = 0; i < NAMES; ++i)
+		{
+			equal += map.sub("[" + std::to_string(i) + "]", "").sub("property", ".") == entries[i];
+		}
+	});
+	rd::bench::do_not_optimize(equal);
+}
+
+RD_BENCHMARK(RdId_mix)
+{
+	// a child of a model as identify names it, and an extension name only known at run time
+	const std::string extension = "isGameControlModuleInitialized";
+	rd::RdId::hash_t sum = 0;
+	state.measure("runtime_name", IDS, [&] {
+		for (int32_t i = 0; i < IDS; ++i)
+		{
+			sum += rd::RdId(i).mix(".").mix(extension).get_hash();
+		}
+	});
+	state.measure("baked_suffix", IDS, [&] {
+		for (int32_t i = 0; i < IDS; ++i)
+		{
+			sum += rd::RdId(i).mix(RD_ID_SUFFIX(".isGameControlModuleInitialized")).get_hash();
+		}
+	});
+	rd::bench::do_not_optimize(sum);
+}
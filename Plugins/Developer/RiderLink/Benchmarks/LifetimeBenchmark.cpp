@@ -0,0 +1,88 @@
+#include "BenchmarkRunner.h"
+
+#include "lifetime/LifetimeDefinition.h"
+#include "lifetime/SequentialLifetimes.h"
+#include "reactive/base/SignalX.h"
+
+#include <vector>
+
+namespace
+{
+constexpr int32_t CYCLES = 200'000;
+constexpr int32_t ACTIONS = 16;
+constexpr int32_t SIBLINGS = 20'000;
+}	 // namespace
+
+RD_BENCHMARK(Lifetime_cycle)
+{
+	rd::LifetimeDefinition root(false);
+
+	state.measure("create_terminate", CYCLES, [&] {
+		for (int32_t i = 0; i < CYCLES; ++i)
+		{
+			rd::LifetimeDefinition nested(root.lifetime);
+			nested.terminate();
+		}
+	});
+
+	// a subscription living as long as a nested lifetime, e.g. the view of a map entry
+	rd::Signal<int32_t> signal;
+	state.measure("create_advise_terminate", CYCLES, [&] {
+		for (int32_t i = 0; i < CYCLES; ++i)
+		{
+			rd::LifetimeDefinition nested(root.lifetime);
+			signal.advise(nested.lifetime, [](int32_t const&) {});
+			nested.terminate();
+		}
+	});
+
+	int64_t executed = 0;
+	state.measure("add_terminate/actions:16", CYCLES, [&] {
+		for (int32_t i = 0; i < CYCLES; ++i)
+		{
+			rd::LifetimeDefinition nested(root.lifetime);
+			for (int32_t j = 0; j < ACTIONS; ++j)
+			{
+				nested.lifetime->add_action([&executed] { ++executed; });
+			}
+			nested.terminate();
+		}
+	});
+	rd::bench::do_not_optimize(executed);
+
+	// actions removed before termination, as tasks do once they complete
+	state.measure("add_remove", CYCLES, [&] {
+		for (int32_t i = 0; i < CYCLES; ++i)
+		{
+			auto id = root.lifetime->add_action([&executed] { ++executed; });
+			root.lifetime->remove_action(id);
+		}
+	});
+
+	// many siblings alive at once, terminated in creation order
+	std::vector<rd::LifetimeDefinition> siblings;
+	siblings.reserve(SIBLINGS);
+	state.measure("siblings_create", SIBLINGS, [&] {
+		for (int32_t i = 0; i < SIBLINGS; ++i)
+		{
+			siblings.emplace_back(root.lifetime);
+		}
+	});
+	state.measure("siblings_terminate", SIBLINGS, [&] {
+		for (auto& sibling : siblings)
+		{
+			sibling.terminate();
+		}
+	});
+	siblings.clear();
+
+	rd::SequentialLifetimes sequential(root.lifetime);
+	state.measure("sequential_next", CYCLES, [&] {
+		for (int32_t i = 0; i < CYCLES; ++i)
+		{
+			sequential.next();
+		}
+	});
+
+	root.terminate();
+}
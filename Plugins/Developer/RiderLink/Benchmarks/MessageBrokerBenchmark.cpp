@@ -0,0 +1,179 @@
+#include "BenchmarkRunner.h"
+#include "BenchmarkEntities.h"
+
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/MessageBroker.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using rd::bench::InlineScheduler;
+
+class CountingEntity : public rd::bench::ReactiveStub
+{
+public:
+	mutable std::atomic<int64_t> received{0};
+
+	using ReactiveStub::ReactiveStub;
+
+	void on_wire_received(rd::Buffer buffer) const override
+	{
+		received.fetch_add(buffer.read_integral<int64_t>(), std::memory_order_relaxed);
+	}
+};
+
+constexpr int32_t ENTITIES = 10'000;
+constexpr int64_t MESSAGES_PER_THREAD = 200'000;
+
+rd::RdId entity_id(uint32_t i)
+{
+	return rd::RdId::Null().mix(static_cast<int64_t>(rd::RdId::MAX_STATIC_ID + 2 * i));
+}
+
+std::vector<std::pair<rd::RdId, rd::Buffer>> make_messages(uint32_t seed, int64_t count, uint32_t id_offset)
+{
+	std::vector<std::pair<rd::RdId, rd::Buffer>> messages;
+	messages.reserve(count);
+	uint32_t x = seed * 2654435761u + 1;
+	for (int64_t i = 0; i < count; ++i)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		rd::Buffer buffer(sizeof(int16_t) + sizeof(int64_t));
+		buffer.write_integral<int16_t>(0);	  // context
+		buffer.write_integral<int64_t>(1);
+		buffer.rewind();
+		messages.emplace_back(entity_id(id_offset + x % ENTITIES), std::move(buffer));
+	}
+	return messages;
+}
+}	 // namespace
+
+RD_BENCHMARK(MessageBroker_dispatch)
+{
+	InlineScheduler scheduler;
+	rd::MessageBroker broker(&scheduler);
+	rd::LifetimeDefinition definition(false);
+
+	std::vector<std::unique_ptr<CountingEntity>> entities;
+	entities.reserve(ENTITIES);
+	for (int32_t i = 0; i < ENTITIES; ++i)
+	{
+		entities.push_back(std::make_unique<CountingEntity>(entity_id(i), &scheduler));
+		broker.advise_on(definition.lifetime, entities.back().get());
+	}
+
+	for (int32_t threads : {1, 2, 4, 8})
+	{
+		std::vector<std::vector<std::pair<rd::RdId, rd::Buffer>>> inputs;
+		for (int32_t t = 0; t < threads; ++t)
+		{
+			inputs.push_back(make_messages(t + 1, MESSAGES_PER_THREAD, 0));
+		}
+
+		state.measure("bound/threads:" + std::to_string(threads), threads * MESSAGES_PER_THREAD, [&] {
+			std::vector<std::thread> producers;
+			for (auto& input : inputs)
+			{
+				producers.emplace_back([&broker, &input] {
+					for (auto& message : input)
+					{
+						broker.dispatch(message.first, std::move(message.second));
+					}
+				});
+			}
+			for (auto& producer : producers)
+			{
+				producer.join();
+			}
+		});
+	}
+
+	int64_t received = 0;
+	for (auto const& entity : entities)
+	{
+		received += entity->received;
+	}
+	rd::bench::do_not_optimize(received);
+
+	// ids nobody subscribed to go through the deferred queue and must not grow the subscription table
+	auto unknown = make_messages(42, MESSAGES_PER_THREAD, ENTITIES);
+	state.measure("unbound", MESSAGES_PER_THREAD, [&] {
+		for (auto& message : unknown)
+		{
+			broker.dispatch(message.first, std::move(message.second));
+		}
+	});
+
+	definition.terminate();
+}
+
+RD_BENCHMARK(MessageBroker_metrics)
+{
+	// cost of per-entity counters and dispatch latency on the single-threaded path
+	for (bool enabled : {false, true})
+	{
+		InlineScheduler scheduler;
+		rd::WireMetrics metrics;
+		metrics.set_enabled(enabled);
+		rd::MessageBroker broker(&scheduler, &metrics);
+		rd::LifetimeDefinition definition(false);
+
+		std::vector<std::unique_ptr<CountingEntity>> entities;
+		entities.reserve(ENTITIES);
+		for (int32_t i = 0; i < ENTITIES; ++i)
+		{
+			entities.push_back(std::make_unique<CountingEntity>(entity_id(i), &scheduler));
+			broker.advise_on(definition.lifetime, entities.back().get());
+		}
+
+		auto input = make_messages(1, MESSAGES_PER_THREAD, 0);
+		state.measure(std::string("metrics:") + (enabled ? "on" : "off"), MESSAGES_PER_THREAD, [&] {
+			for (auto& message : input)
+			{
+				broker.dispatch(message.first, std::move(message.second));
+			}
+		});
+
+		definition.terminate();
+	}
+}
+
+RD_BENCHMARK(MessageBroker_trace)
+{
+	// cost of the binary trace ring on the single-threaded path
+	for (bool enabled : {false, true})
+	{
+		InlineScheduler scheduler;
+		rd::TraceRing trace_ring;
+		if (enabled)
+		{
+			trace_ring.start(1 << 16);
+		}
+		rd::MessageBroker broker(&scheduler, nullptr, &trace_ring);
+		rd::LifetimeDefinition definition(false);
+
+		std::vector<std::unique_ptr<CountingEntity>> entities;
+		entities.reserve(ENTITIES);
+		for (int32_t i = 0; i < ENTITIES; ++i)
+		{
+			entities.push_back(std::make_unique<CountingEntity>(entity_id(i), &scheduler));
+			broker.advise_on(definition.lifetime, entities.back().get());
+		}
+
+		auto input = make_messages(1, MESSAGES_PER_THREAD, 0);
+		state.measure(std::string("trace:") + (enabled ? "on" : "off"), MESSAGES_PER_THREAD, [&] {
+			for (auto& message : input)
+			{
+				broker.dispatch(message.first, std::move(message.second));
+			}
+		});
+
+		definition.terminate();
+	}
+}
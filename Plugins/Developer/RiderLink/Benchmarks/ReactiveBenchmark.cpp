@@ -0,0 +1,264 @@
+#include "BenchmarkRunner.h"
+
+#include "lifetime/LifetimeDefinition.h"
+#include "reactive/ViewableList.h"
+#include "reactive/ViewableMap.h"
+#include "reactive/ViewableSet.h"
+#include "reactive/base/SignalX.h"
+
+#include <functional>
+#include <string>
+
+namespace
+{
+constexpr int64_t FIRES = 1'000'000;
+constexpr int32_t ELEMENTS = 100'000;
+
+// not trivially copyable, so viewable collections keep it in a Wrapper as they did every element before
+struct boxed_id
+{
+	int32_t value;
+
+	boxed_id(int32_t value) : value(value)
+	{
+	}
+
+	boxed_id(boxed_id const& other) : value(other.value)
+	{
+	}
+
+	boxed_id& operator=(boxed_id const& other)
+	{
+		value = other.value;
+		return *this;
+	}
+
+	friend bool operator==(boxed_id const& lhs, boxed_id const& rhs)
+	{
+		return lhs.value == rhs.value;
+	}
+
+	friend bool operator!=(boxed_id const& lhs, boxed_id const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	friend std::string to_string(boxed_id const& id)
+	{
+		return std::to_string(id.value);
+	}
+};
+}	 // namespace
+
+namespace std
+{
+template <>
+struct hash<boxed_id>
+{
+	size_t operator()(boxed_id const& id) const noexcept
+	{
+		return std::hash<int32_t>()(id.value);
+	}
+};
+}	 // namespace std
+
+namespace
+{
+static_assert(!rd::util::inline_storage_v<boxed_id>, "boxed_id is expected to be wrapped");
+static_assert(rd::util::inline_storage_v<int32_t>, "int32_t is expected to be inline");
+
+int32_t id_value(int32_t id)
+{
+	return id;
+}
+
+int32_t id_value(boxed_id const& id)
+{
+	return id.value;
+}
+
+template <typename T>
+void measure_layout(rd::bench::BenchmarkState& state, std::string const& layout)
+{
+	rd::LifetimeDefinition definition(false);
+	int64_t sum = 0;
+
+	rd::ViewableMap<T, T> map;
+	map.advise(definition.lifetime, [&sum](typename rd::ViewableMap<T, T>::Event const&) { ++sum; });
+	state.measure("map/insert/" + layout, ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			map.set(T(i), T(i));
+		}
+	});
+	state.measure("map/lookup/" + layout, ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			sum += id_value(*map.get(T(i)));
+		}
+	});
+	state.measure("map/iterate/" + layout, ELEMENTS, [&] {
+		for (auto it = map.begin(); it != map.end(); ++it)
+		{
+			sum += id_value(it.key()) + id_value(it.value());
+		}
+	});
+
+	rd::ViewableSet<T> set;
+	set.advise(definition.lifetime, [&sum](typename rd::ViewableSet<T>::Event const&) { ++sum; });
+	state.measure("set/insert/" + layout, ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			set.add(T(i));
+		}
+	});
+	state.measure("set/lookup/" + layout, ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			sum += set.contains(T(i));
+		}
+	});
+	state.measure("set/iterate/" + layout, ELEMENTS, [&] {
+		for (auto const& element : set)
+		{
+			sum += id_value(element);
+		}
+	});
+
+	rd::ViewableList<T> list;
+	list.advise(definition.lifetime, [&sum](typename rd::ViewableList<T>::Event const&) { ++sum; });
+	state.measure("list/insert/" + layout, ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			list.add(T(i));
+		}
+	});
+	state.measure("list/iterate/" + layout, ELEMENTS, [&] {
+		for (auto const& element : list)
+		{
+			sum += id_value(element);
+		}
+	});
+	rd::bench::do_not_optimize(sum);
+
+	definition.terminate();
+}
+}	 // namespace
+
+RD_BENCHMARK(Signal_fire)
+{
+	for (int32_t subscribers : {1, 16, 256})
+	{
+		rd::Signal<int64_t> signal;
+		rd::LifetimeDefinition definition(false);
+		int64_t sum = 0;
+		for (int32_t i = 0; i < subscribers; ++i)
+		{
+			signal.advise(definition.lifetime, [&sum](int64_t const& value) { sum += value; });
+		}
+
+		const int64_t fires = FIRES / subscribers;
+		state.measure("subscribers:" + std::to_string(subscribers), fires * subscribers, [&] {
+			for (int64_t i = 0; i < fires; ++i)
+			{
+				signal.fire(i);
+			}
+		});
+		rd::bench::do_not_optimize(sum);
+
+		definition.terminate();
+	}
+
+	// advise and terminate of a short-lived subscription, e.g. a handler bound to a sequential lifetime
+	rd::Signal<int64_t> signal;
+	rd::LifetimeDefinition definition(false);
+	state.measure("advise_terminate", FIRES / 10, [&] {
+		for (int64_t i = 0; i < FIRES / 10; ++i)
+		{
+			rd::LifetimeDefinition nested(definition.lifetime);
+			signal.advise(nested.lifetime, [](int64_t const&) {});
+			nested.terminate();
+		}
+	});
+	definition.terminate();
+}
+
+RD_BENCHMARK(ViewableMap_mutation)
+{
+	rd::ViewableMap<int32_t, std::wstring> map;
+	rd::LifetimeDefinition definition(false);
+	int64_t events = 0;
+	map.advise(definition.lifetime, [&events](rd::ViewableMap<int32_t, std::wstring>::Event const&) { ++events; });
+
+	state.measure("add", ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			map.set(i, L"value");
+		}
+	});
+
+	state.measure("update", ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			map.set(i, L"other value");
+		}
+	});
+
+	size_t found = 0;
+	state.measure("get", ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			found += map.get(i) != nullptr;
+		}
+	});
+	rd::bench::do_not_optimize(found);
+
+	state.measure("remove", ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			map.remove(i);
+		}
+	});
+	rd::bench::do_not_optimize(events);
+
+	definition.terminate();
+}
+
+RD_BENCHMARK(ViewableList_mutation)
+{
+	rd::ViewableList<std::wstring> list;
+	rd::LifetimeDefinition definition(false);
+	int64_t events = 0;
+	list.advise(definition.lifetime, [&events](rd::ViewableList<std::wstring>::Event const&) { ++events; });
+
+	state.measure("add", ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			list.add(L"value");
+		}
+	});
+
+	state.measure("set", ELEMENTS, [&] {
+		for (int32_t i = 0; i < ELEMENTS; ++i)
+		{
+			list.set(i, L"other value");
+		}
+	});
+
+	// from the back, removing the front element shifts the whole list
+	state.measure("remove_last", ELEMENTS, [&] {
+		for (int32_t i = ELEMENTS; i > 0; --i)
+		{
+			list.removeAt(i - 1);
+		}
+	});
+	rd::bench::do_not_optimize(events);
+
+	definition.terminate();
+}
+
+RD_BENCHMARK(Viewable_layout)
+{
+	measure_layout<int32_t>(state, "inline");
+	measure_layout<boxed_id>(state, "wrapped");
+}
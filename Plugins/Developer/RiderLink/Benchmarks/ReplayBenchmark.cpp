@@ -0,0 +1,260 @@
+#include "BenchmarkRunner.h"
+#include "BenchmarkEntities.h"
+
+#include "impl/RdList.h"
+#include "impl/RdMap.h"
+#include "impl/RdProperty.h"
+#include "impl/RdSignal.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Protocol.h"
+#include "wire/ReplayWire.h"
+#include "wire/SocketWire.h"
+#include "wire/WireCapture.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace
+{
+using rd::bench::InlineScheduler;
+
+constexpr int64_t CAPTURED_MESSAGES = 100'000;
+constexpr int64_t SIGNAL_ID = 1;
+
+constexpr char const* CAPTURE_PATH = "rd_replay_benchmark.capture";
+
+constexpr int64_t SESSION_ROUNDS = 20'000;
+constexpr int64_t SESSION_MESSAGES = 5 * SESSION_ROUNDS;
+constexpr int64_t LOG_ID = 2;
+constexpr int64_t PLAY_MODE_ID = 3;
+constexpr int64_t PROPERTY_ID = 4;
+constexpr int64_t MAP_ID = 5;
+constexpr int64_t LIST_ID = 6;
+
+/**
+ * \brief Entities shaped like the RiderLink editor model: the log signal, play mode signals and properties, and
+ * collections of blueprint paths and ids.
+ */
+struct SessionModel
+{
+	rd::RdSignal<std::wstring> log;
+	rd::RdSignal<int32_t> play_mode;
+	rd::RdProperty<int32_t> frame{0};
+	rd::RdMap<int32_t, std::wstring> blueprints;
+	rd::RdList<int32_t> selection;
+
+	void bind(rd::Lifetime lifetime, rd::Protocol* protocol)
+	{
+		rd::statics(log, LOG_ID).bind(lifetime, protocol, "log");
+		rd::statics(play_mode, PLAY_MODE_ID).bind(lifetime, protocol, "play_mode");
+		rd::statics(frame, PROPERTY_ID).bind(lifetime, protocol, "frame");
+		rd::statics(blueprints, MAP_ID).bind(lifetime, protocol, "blueprints");
+		rd::statics(selection, LIST_ID).bind(lifetime, protocol, "selection");
+	}
+};
+
+/**
+ * \brief Records the messages a server protocol receives while the client drives a [SessionModel], sent in compact
+ * encoding if [compact].
+ */
+bool record_session(std::string const& path, bool compact)
+{
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+
+	auto server_wire = std::make_shared<rd::SocketWire::Server>(definition.lifetime, &scheduler, 0, "SessionBenchServer");
+	server_wire->set_compact_encoding_enabled(compact);
+	server_wire->start_capture(path);
+	auto client_wire =
+		std::make_shared<rd::SocketWire::Client>(definition.lifetime, &scheduler, server_wire->port, "SessionBenchClient");
+	client_wire->set_compact_encoding_enabled(compact);
+
+	rd::Protocol server(rd::Identities::SERVER, &scheduler, server_wire, definition.lifetime);
+	rd::Protocol client(rd::Identities::CLIENT, &scheduler, client_wire, definition.lifetime);
+
+	SessionModel server_model;
+	SessionModel client_model;
+	server_model.bind(definition.lifetime, &server);
+	client_model.bind(definition.lifetime, &client);
+
+	std::atomic<int64_t> received{0};
+	server_model.log.advise(definition.lifetime, [&received](std::wstring const&) { ++received; });
+	server_model.play_mode.advise(definition.lifetime, [&received](int32_t) { ++received; });
+	server_model.frame.advise(definition.lifetime, [&received](int32_t) { ++received; });
+	server_model.blueprints.advise(definition.lifetime, [&received](rd::IViewableMap<int32_t, std::wstring>::Event const&) { ++received; });
+	server_model.selection.advise(definition.lifetime, [&received](rd::IViewableList<int32_t>::Event const&) { ++received; });
+	// the property reports its initial value on advise
+	const int64_t expected = received + SESSION_MESSAGES;
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	while (!(server_wire->connected.get() && client_wire->connected.get()))
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	// capabilities are exchanged right after connecting
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	for (int64_t i = 0; i < SESSION_ROUNDS; ++i)
+	{
+		const auto index = static_cast<int32_t>(i);
+		client_model.log.fire(L"LogBlueprintUserMessages: [BP_PlayerCharacter_C_" + std::to_wstring(i % 7) +
+							  L"] Warning: Accessed None trying to read property CallFunc_GetActorOfClass");
+		client_model.play_mode.fire(index % 3);
+		client_model.frame.set(index + 1);
+		client_model.blueprints.set(index % 64, L"/Game/Blueprints/BP_Actor_" + std::to_wstring(i));
+		client_model.selection.add(index % 16);
+	}
+	while (received < expected)
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	server_wire->stop_capture();
+	definition.terminate();
+	return true;
+}
+
+/**
+ * \brief Records a session of log-like signal values sent from a client protocol to a server one.
+ */
+bool record_capture(std::string const& path)
+{
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+
+	auto server_wire = std::make_shared<rd::SocketWire::Server>(definition.lifetime, &scheduler, 0, "ReplayBenchServer");
+	server_wire->start_capture(path);
+	auto client_wire =
+		std::make_shared<rd::SocketWire::Client>(definition.lifetime, &scheduler, server_wire->port, "ReplayBenchClient");
+
+	rd::Protocol server(rd::Identities::SERVER, &scheduler, server_wire, definition.lifetime);
+	rd::Protocol client(rd::Identities::CLIENT, &scheduler, client_wire, definition.lifetime);
+
+	rd::RdSignal<std::wstring> server_signal;
+	rd::RdSignal<std::wstring> client_signal;
+	rd::statics(server_signal, SIGNAL_ID).bind(definition.lifetime, &server, "signal");
+	rd::statics(client_signal, SIGNAL_ID).bind(definition.lifetime, &client, "signal");
+
+	std::atomic<int64_t> received{0};
+	server_signal.advise(definition.lifetime, [&received](std::wstring const&) { ++received; });
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+	while (!(server_wire->connected.get() && client_wire->connected.get()))
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+
+	for (int64_t i = 0; i < CAPTURED_MESSAGES; ++i)
+	{
+		client_signal.fire(L"LogBlueprintUserMessages: [BP_PlayerCharacter_C_" + std::to_wstring(i % 7) +
+						   L"] Warning: Accessed None trying to read property CallFunc_GetActorOfClass");
+	}
+	while (received < CAPTURED_MESSAGES)
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	server_wire->stop_capture();
+	definition.terminate();
+	return true;
+}
+}	 // namespace
+
+RD_BENCHMARK(Replay_capture)
+{
+	const std::string path = CAPTURE_PATH;
+	if (!record_capture(path))
+	{
+		std::printf("failed to record a capture\n");
+		return;
+	}
+
+	// replays into a fresh protocol, so deserialization and the handler are measured without any network
+	InlineScheduler scheduler;
+	rd::LifetimeDefinition definition(false);
+	auto wire = std::make_shared<rd::ReplayWire>(&scheduler);
+	rd::Protocol protocol(rd::Identities::SERVER, &scheduler, wire, definition.lifetime);
+
+	rd::RdSignal<std::wstring> signal;
+	rd::statics(signal, SIGNAL_ID).bind(definition.lifetime, &protocol, "signal");
+	int64_t received = 0;
+	size_t characters = 0;
+	signal.advise(definition.lifetime, [&](std::wstring const& value) {
+		++received;
+		characters += value.size();
+	});
+
+	int64_t dispatched = 0;
+	state.measure("signal_wstring/max_speed", CAPTURED_MESSAGES, [&] { dispatched = wire->replay(path); });
+	rd::bench::do_not_optimize(characters);
+	if (dispatched != CAPTURED_MESSAGES || received != CAPTURED_MESSAGES)
+	{
+		std::printf("replayed %lld messages, handled %lld\n", static_cast<long long>(dispatched),
+			static_cast<long long>(received));
+	}
+
+	definition.terminate();
+	std::remove(path.c_str());
+}
+
+RD_BENCHMARK(Replay_compact_encoding)
+{
+	for (bool compact : {false, true})
+	{
+		const std::string path = CAPTURE_PATH;
+		if (!record_session(path, compact))
+		{
+			std::printf("failed to record a capture\n");
+			return;
+		}
+
+		int64_t messages = 0;
+		int64_t bytes = 0;
+		{
+			rd::WireCaptureReader reader(path);
+			rd::WireCapture::Record record;
+			while (reader.next(record))
+			{
+				if (record.direction == rd::WireCapture::Direction::Incoming)
+				{
+					++messages;
+					bytes += static_cast<int64_t>(record.payload.size());
+				}
+			}
+		}
+
+		InlineScheduler scheduler;
+		rd::LifetimeDefinition definition(false);
+		auto wire = std::make_shared<rd::ReplayWire>(&scheduler);
+		rd::Protocol protocol(rd::Identities::SERVER, &scheduler, wire, definition.lifetime);
+		SessionModel model;
+		model.bind(definition.lifetime, &protocol);
+
+		int64_t dispatched = 0;
+		state.measure(std::string("session/compact:") + (compact ? "on" : "off"), messages,
+			[&] { dispatched = wire->replay(path); });
+		std::printf("    %lld messages, %.1f payload bytes/message, %d blueprints, %d selected\n",
+			static_cast<long long>(dispatched), messages == 0 ? 0.0 : static_cast<double>(bytes) / messages,
+			static_cast<int>(model.blueprints.size()), static_cast<int>(model.selection.size()));
+
+		definition.terminate();
+		std::remove(path.c_str());
+	}
+}
@@ -0,0 +1,66 @@
+#include "BenchmarkRunner.h"
+
+#include "lifetime/LifetimeDefinition.h"
+#include "scheduler/MpscScheduler.h"
+#include "scheduler/SingleThreadScheduler.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int64_t TASKS_PER_THREAD = 100'000;
+
+template <typename Scheduler, typename Queue>
+void measure_queue_and_flush(rd::bench::BenchmarkState& state, std::string const& scheduler_name, Queue&& queue)
+{
+	for (int32_t threads : {1, 2, 4})
+	{
+		rd::LifetimeDefinition definition(false);
+		Scheduler scheduler(definition.lifetime, scheduler_name + std::to_string(threads));
+		std::atomic<int64_t> executed{0};
+
+		state.measure(scheduler_name + "/threads:" + std::to_string(threads), threads * TASKS_PER_THREAD, [&] {
+			std::vector<std::thread> producers;
+			for (int32_t t = 0; t < threads; ++t)
+			{
+				producers.emplace_back([&] {
+					for (int64_t i = 0; i < TASKS_PER_THREAD; ++i)
+					{
+						queue(scheduler, executed);
+					}
+				});
+			}
+			for (auto& producer : producers)
+			{
+				producer.join();
+			}
+			scheduler.flush();
+		});
+
+		rd::bench::do_not_optimize(executed.load());
+		definition.terminate();
+	}
+}
+}	 // namespace
+
+RD_BENCHMARK(Scheduler_queue_flush)
+{
+	measure_queue_and_flush<rd::SingleThreadScheduler>(state, "SingleThreadScheduler",
+		[](rd::IScheduler& scheduler, std::atomic<int64_t>& executed) {
+			scheduler.queue([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+		});
+
+	// through IScheduler, closures are wrapped into std::function like every rd caller does
+	measure_queue_and_flush<rd::MpscScheduler>(state, "MpscScheduler",
+		[](rd::IScheduler& scheduler, std::atomic<int64_t>& executed) {
+			scheduler.queue([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+		});
+
+	measure_queue_and_flush<rd::MpscScheduler>(state, "MpscScheduler_direct",
+		[](rd::MpscScheduler& scheduler, std::atomic<int64_t>& executed) {
+			scheduler.queue([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+		});
+}
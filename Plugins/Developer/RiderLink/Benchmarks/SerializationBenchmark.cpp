@@ -0,0 +1,464 @@
+#include "BenchmarkRunner.h"
+
+#include "base/ISerializersOwner.h"
+#include "protocol/Buffer.h"
+#include "serialization/ArraySerializer.h"
+#include "serialization/Polymorphic.h"
+#include "serialization/SerializationCtx.h"
+#include "serialization/Serializers.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/**
+ * \brief Shaped like the small generated structs RiderLink sends around (ids, a name and a couple of flags).
+ */
+class BenchmarkStruct final : public rd::IPolymorphicSerializable
+{
+public:
+	int32_t id = 0;
+	int64_t timestamp = 0;
+	std::wstring name;
+	bool enabled = false;
+
+	BenchmarkStruct() = default;
+
+	BenchmarkStruct(int32_t id, int64_t timestamp, std::wstring name, bool enabled)
+		: id(id), timestamp(timestamp), name(std::move(name)), enabled(enabled)
+	{
+	}
+
+	static std::string static_type_name()
+	{
+		return "BenchmarkStruct";
+	}
+
+	static BenchmarkStruct read(rd::SerializationCtx& /*ctx*/, rd::Buffer& buffer)
+	{
+		BenchmarkStruct result;
+		result.id = buffer.read_integral<int32_t>();
+		result.timestamp = buffer.read_integral<int64_t>();
+		result.name = buffer.read_wstring();
+		result.enabled = buffer.read_bool();
+		return result;
+	}
+
+	void write(rd::SerializationCtx& /*ctx*/, rd::Buffer& buffer) const override
+	{
+		buffer.write_integral(id);
+		buffer.write_integral(timestamp);
+		buffer.write_wstring(name);
+		buffer.write_bool(enabled);
+	}
+
+	std::string type_name() const override
+	{
+		return static_type_name();
+	}
+
+	std::string toString() const override
+	{
+		return "BenchmarkStruct(" + std::to_string(id) + ")";
+	}
+
+	bool equals(rd::ISerializable const& object) const override
+	{
+		auto const& other = static_cast<BenchmarkStruct const&>(object);
+		return id == other.id && timestamp == other.timestamp && name == other.name && enabled == other.enabled;
+	}
+};
+
+/**
+ * \brief Stands in for the other types of a generated library, so the registry has a realistic size.
+ */
+template <int N>
+class FillerStruct final : public rd::IPolymorphicSerializable
+{
+public:
+	static std::string static_type_name()
+	{
+		return "FillerStruct" + std::to_string(N);
+	}
+
+	static FillerStruct read(rd::SerializationCtx& /*ctx*/, rd::Buffer& /*buffer*/)
+	{
+		return {};
+	}
+
+	void write(rd::SerializationCtx& /*ctx*/, rd::Buffer& /*buffer*/) const override
+	{
+	}
+
+	std::string type_name() const override
+	{
+		return static_type_name();
+	}
+
+	std::string toString() const override
+	{
+		return static_type_name();
+	}
+
+	bool equals(rd::ISerializable const& /*object*/) const override
+	{
+		return true;
+	}
+};
+
+/**
+ * \brief Registers like UE4Library::serializersOwner does: the types of a library in one go.
+ */
+class BenchmarkSerializersOwner final : public rd::ISerializersOwner
+{
+	template <int... N>
+	static void register_fillers(rd::Serializers const& serializers, std::integer_sequence<int, N...>)
+	{
+		(serializers.registry<FillerStruct<N>>(), ...);
+	}
+
+public:
+	void registerSerializersCore(rd::Serializers const& serializers) const override
+	{
+		register_fillers(serializers, std::make_integer_sequence<int, 20>());
+		serializers.registry<BenchmarkStruct>();
+	}
+};
+
+constexpr int64_t VALUES = 1'000'000;
+constexpr int64_t STRINGS = 200'000;
+constexpr int64_t ARRAYS = 20'000;
+constexpr int64_t OBJECTS = 200'000;
+}	 // namespace
+
+namespace
+{
+/**
+ * \brief Shaped like StringRange: two fixed-width fields, sent in arrays by log events.
+ */
+class BenchmarkRange final : public rd::IPolymorphicSerializable
+{
+public:
+	int32_t first = 0;
+	int32_t last = 0;
+
+	BenchmarkRange(int32_t first, int32_t last) : first(first), last(last)
+	{
+	}
+
+	static BenchmarkRange read(rd::SerializationCtx& /*ctx*/, rd::Buffer& buffer)
+	{
+		auto first = buffer.read_integral<int32_t>();
+		auto last = buffer.read_integral<int32_t>();
+		return {first, last};
+	}
+
+	void write(rd::SerializationCtx& /*ctx*/, rd::Buffer& buffer) const override
+	{
+		buffer.write_integral(first);
+		buffer.write_integral(last);
+	}
+
+	std::string type_name() const override
+	{
+		return "BenchmarkRange";
+	}
+
+	std::string toString() const override
+	{
+		return "BenchmarkRange(" + std::to_string(first) + ", " + std::to_string(last) + ")";
+	}
+
+	bool equals(rd::ISerializable const& object) const override
+	{
+		auto const& other = static_cast<BenchmarkRange const&>(object);
+		return first == other.first && last == other.last;
+	}
+};
+}	 // namespace
+
+namespace rd
+{
+template <>
+struct fixed_layout<BenchmarkRange>
+{
+	static constexpr size_t size = sizeof(int32_t) + sizeof(int32_t);
+
+	static void store(BenchmarkRange const& value, uint8_t* out)
+	{
+		out = fixed_layout_util::store(out, value.first);
+		out = fixed_layout_util::store(out, value.last);
+	}
+
+	static BenchmarkRange load(uint8_t const* in)
+	{
+		auto first = fixed_layout_util::load<int32_t>(in);
+		auto last = fixed_layout_util::load<int32_t>(in);
+		return {first, last};
+	}
+};
+}	 // namespace rd
+
+RD_BENCHMARK(Buffer_integral)
+{
+	rd::Buffer buffer(VALUES * (sizeof(int32_t) + sizeof(int64_t)));
+
+	state.measure("write", VALUES, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < VALUES; ++i)
+		{
+			buffer.write_integral(static_cast<int32_t>(i));
+			buffer.write_integral(i);
+		}
+	});
+
+	int64_t sum = 0;
+	state.measure("read", VALUES, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < VALUES; ++i)
+		{
+			sum += buffer.read_integral<int32_t>();
+			sum += buffer.read_integral<int64_t>();
+		}
+	});
+
+	// lengths, versions and indices as they go in compact mode
+	buffer.set_compact(true);
+	state.measure("compact/write", VALUES, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < VALUES; ++i)
+		{
+			buffer.write_compact_integral(static_cast<int32_t>(i & 0xff));
+			buffer.write_compact_integral(i);
+		}
+	});
+
+	state.measure("compact/read", VALUES, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < VALUES; ++i)
+		{
+			sum += buffer.read_compact_integral<int32_t>();
+			sum += buffer.read_compact_integral<int64_t>();
+		}
+	});
+	rd::bench::do_not_optimize(sum);
+}
+
+RD_BENCHMARK(Buffer_wstring)
+{
+	for (size_t length : {16, 256, 4096})
+	{
+		const std::wstring value(length, L'x');
+		rd::Buffer buffer;
+
+		state.measure("write/chars:" + std::to_string(length), STRINGS, [&] {
+			buffer.rewind();
+			for (int64_t i = 0; i < STRINGS; ++i)
+			{
+				buffer.write_wstring(value);
+			}
+		});
+
+		size_t characters = 0;
+		state.measure("read/chars:" + std::to_string(length), STRINGS, [&] {
+			buffer.rewind();
+			for (int64_t i = 0; i < STRINGS; ++i)
+			{
+				characters += buffer.read_wstring().size();
+			}
+		});
+		rd::bench::do_not_optimize(characters);
+	}
+
+	// a line of unrealLog, written and read back through the same small buffer as a message would be
+	const std::wstring line = L"LogBlueprintUserMessages: [BP_PlayerCharacter_C_0] Warning: Accessed None trying to read "
+							  L"property CallFunc_GetActorOfClass_ReturnValue";
+	const std::pair<std::string, std::wstring> lines[] = {{"log_line", line}, {"log_line_non_bmp", line + L" \U0001F525"}};
+	for (auto const& entry : lines)
+	{
+		auto const& value = entry.second;
+		rd::Buffer buffer;
+		size_t characters = 0;
+		state.measure(entry.first + "/write_read", STRINGS, [&] {
+			for (int64_t i = 0; i < STRINGS; ++i)
+			{
+				buffer.rewind();
+				buffer.write_wstring(value);
+				buffer.rewind();
+				characters += buffer.read_wstring().size();
+			}
+		});
+		rd::bench::do_not_optimize(characters);
+	}
+}
+
+RD_BENCHMARK(Buffer_array)
+{
+	const std::vector<int32_t> integers(1024, 42);
+	rd::Buffer buffer;
+
+	state.measure("write/int32:1024", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			buffer.write_array(integers);
+		}
+	});
+
+	size_t elements = 0;
+	state.measure("read/int32:1024", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			elements += buffer.read_array<std::vector, int32_t>().size();
+		}
+	});
+	rd::bench::do_not_optimize(elements);
+
+	// strings are written element by element, the way generated code does it
+	using strings_serializer = rd::ArraySerializer<rd::Polymorphic<std::wstring>, std::vector>;
+	rd::Serializers serializers;
+	rd::SerializationCtx ctx(&serializers);
+	std::vector<rd::Wrapper<std::wstring>> strings;
+	for (int32_t i = 0; i < 64; ++i)
+	{
+		strings.push_back(rd::wrapper::make_wrapper<std::wstring>(L"UnrealEditor.BlueprintNode_" + std::to_wstring(i)));
+	}
+	state.measure("write/wstring:64", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			strings_serializer::write(ctx, buffer, strings);
+		}
+	});
+
+	state.measure("read/wstring:64", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			elements += strings_serializer::read(ctx, buffer).size();
+		}
+	});
+	rd::bench::do_not_optimize(elements);
+
+	// ranges of a log line, as generated code wrote them before the fixed layout and as it does now
+	std::vector<rd::Wrapper<BenchmarkRange>> ranges;
+	for (int32_t i = 0; i < 64; ++i)
+	{
+		ranges.push_back(rd::wrapper::make_wrapper<BenchmarkRange>(2 * i, 2 * i + 1));
+	}
+	state.measure("write/range:64/field_by_field", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			buffer.write_array<std::vector, BenchmarkRange>(
+				ranges, [&](BenchmarkRange const& range) { rd::Polymorphic<BenchmarkRange>::write(ctx, buffer, range); });
+		}
+	});
+
+	state.measure("read/range:64/field_by_field", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			elements += buffer.read_array<std::vector, BenchmarkRange>([&] { return BenchmarkRange::read(ctx, buffer); }).size();
+		}
+	});
+	rd::bench::do_not_optimize(elements);
+
+	state.measure("write/range:64/fixed_layout", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			buffer.write_array<std::vector, BenchmarkRange>(ranges);
+		}
+	});
+
+	state.measure("read/range:64/fixed_layout", ARRAYS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < ARRAYS; ++i)
+		{
+			elements += buffer.read_array<std::vector, BenchmarkRange>().size();
+		}
+	});
+	rd::bench::do_not_optimize(elements);
+}
+
+RD_BENCHMARK(Serializers_polymorphic)
+{
+	rd::Serializers serializers;
+	BenchmarkSerializersOwner owner;
+	owner.registry(serializers);
+	rd::SerializationCtx ctx(&serializers);
+	rd::Buffer buffer;
+
+	const BenchmarkStruct value(7, 1234567890, L"BP_PlayerCharacter_C_0", true);
+	state.measure("struct/write", OBJECTS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			serializers.writePolymorphic(ctx, buffer, value);
+		}
+	});
+
+	int64_t ids = 0;
+	state.measure("struct/read", OBJECTS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			auto any = serializers.readAny(ctx, buffer);
+			ids += rd::any::get<BenchmarkStruct>(*std::move(any))->id;
+		}
+	});
+	rd::bench::do_not_optimize(ids);
+
+	// registered outside of an owner, found in the registry the table falls back to
+	rd::Serializers late_serializers;
+	late_serializers.registry<BenchmarkStruct>();
+	rd::SerializationCtx late_ctx(&late_serializers);
+	state.measure("struct/read:late_registered", OBJECTS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			auto any = late_serializers.readAny(late_ctx, buffer);
+			ids += rd::any::get<BenchmarkStruct>(*std::move(any))->id;
+		}
+	});
+	rd::bench::do_not_optimize(ids);
+
+	const std::wstring text = L"LogBlueprintUserMessages: Warning: Accessed None";
+	state.measure("wstring/write", OBJECTS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			serializers.writePolymorphic(ctx, buffer, text);
+		}
+	});
+
+	size_t characters = 0;
+	state.measure("wstring/read", OBJECTS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			auto any = serializers.readAny(ctx, buffer);
+			characters += rd::any::get<std::wstring>(*std::move(any))->size();
+		}
+	});
+	rd::bench::do_not_optimize(characters);
+
+	// what RdProperty<int32_t> and friends do for every value
+	state.measure("int32/round_trip", OBJECTS, [&] {
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			rd::Polymorphic<int32_t>::write(ctx, buffer, static_cast<int32_t>(i));
+		}
+		buffer.rewind();
+		for (int64_t i = 0; i < OBJECTS; ++i)
+		{
+			ids += rd::Polymorphic<int32_t>::read(ctx, buffer);
+		}
+	});
+	rd::bench::do_not_optimize(ids);
+}
@@ -0,0 +1,290 @@
+#include "BenchmarkRunner.h"
+#include "BenchmarkEntities.h"
+
+#include "lifetime/LifetimeDefinition.h"
+#include "wire/ShmWire.h"
+#include "wire/SocketWire.h"
+#include "wire/UnixSocketWire.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using rd::bench::InlineScheduler;
+
+class EchoEntity : public rd::bench::ReactiveStub
+{
+	rd::IWire const* wire;
+
+public:
+	EchoEntity(rd::RdId id, rd::IScheduler* scheduler, rd::IWire const* wire) : ReactiveStub(id, scheduler), wire(wire)
+	{
+	}
+
+	void on_wire_received(rd::Buffer buffer) const override
+	{
+		const auto seqn = buffer.read_integral<int64_t>();
+		wire->send(get_id(), [seqn](rd::Buffer& reply) { reply.write_integral(seqn); });
+	}
+};
+
+class CountingEntity : public rd::bench::ReactiveStub
+{
+public:
+	mutable std::atomic<int64_t> received{0};
+
+	using ReactiveStub::ReactiveStub;
+
+	void on_wire_received(rd::Buffer buffer) const override
+	{
+		buffer.read_integral<int64_t>();
+		received.fetch_add(1, std::memory_order_release);
+	}
+};
+
+constexpr int64_t ROUND_TRIPS = 5'000;
+constexpr int64_t MESSAGES = 50'000;
+constexpr int64_t LARGE_MESSAGES = 200;
+constexpr int64_t PRIORITY_ROUND_TRIPS = 100;
+constexpr int64_t BULK_BACKLOG = 1024;
+
+const rd::RdId ECHO_ID = rd::RdId::Null().mix(static_cast<int64_t>(rd::RdId::MAX_STATIC_ID + 2));
+const rd::RdId SINK_ID = rd::RdId::Null().mix(static_cast<int64_t>(rd::RdId::MAX_STATIC_ID + 4));
+
+bool wait_for(std::function<bool()> const& condition)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (!condition())
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+using wire_factory_t =
+	std::function<std::shared_ptr<rd::SocketWire::Base>(rd::Lifetime, rd::IScheduler*, rd::SocketWire::Base const* server)>;
+
+struct Transport
+{
+	std::string name;
+	wire_factory_t server;
+	wire_factory_t client;
+};
+
+std::vector<Transport> transports()
+{
+	std::vector<Transport> result;
+	result.push_back({"tcp",
+		[](rd::Lifetime lifetime, rd::IScheduler* scheduler, rd::SocketWire::Base const*) {
+			return std::make_shared<rd::SocketWire::Server>(lifetime, scheduler, 0, "BenchServer");
+		},
+		[](rd::Lifetime lifetime, rd::IScheduler* scheduler, rd::SocketWire::Base const* server) {
+			const auto port = static_cast<rd::SocketWire::Server const*>(server)->port;
+			return std::make_shared<rd::SocketWire::Client>(lifetime, scheduler, port, "BenchClient");
+		}});
+	if (rd::UnixSocketWire::is_supported())
+	{
+		result.push_back({"unix",
+			[](rd::Lifetime lifetime, rd::IScheduler* scheduler, rd::SocketWire::Base const*) {
+				return std::make_shared<rd::UnixSocketWire::Server>(lifetime, scheduler, "", "BenchUnixServer");
+			},
+			[](rd::Lifetime lifetime, rd::IScheduler* scheduler, rd::SocketWire::Base const* server) {
+				const auto& path = static_cast<rd::UnixSocketWire::Server const*>(server)->path;
+				return std::make_shared<rd::UnixSocketWire::Client>(lifetime, scheduler, path, "BenchUnixClient");
+			}});
+	}
+	if (rd::ShmWire::is_supported())
+	{
+		result.push_back({"shm",
+			[](rd::Lifetime lifetime, rd::IScheduler* scheduler, rd::SocketWire::Base const*) {
+				return std::make_shared<rd::ShmWire::Server>(
+					lifetime, scheduler, "", rd::ShmWire::DEFAULT_CAPACITY, "BenchShmServer");
+			},
+			[](rd::Lifetime lifetime, rd::IScheduler* scheduler, rd::SocketWire::Base const* server) {
+				const auto& name = static_cast<rd::ShmWire::Server const*>(server)->name;
+				return std::make_shared<rd::ShmWire::Client>(lifetime, scheduler, name, "BenchShmClient");
+			}});
+	}
+	return result;
+}
+}	 // namespace
+
+RD_BENCHMARK(Wire_transport)
+{
+	for (auto const& transport : transports())
+	{
+		InlineScheduler scheduler;
+		rd::LifetimeDefinition definition(false);
+
+		auto server = transport.server(definition.lifetime, &scheduler, nullptr);
+		auto client = transport.client(definition.lifetime, &scheduler, server.get());
+
+		EchoEntity echo(ECHO_ID, &scheduler, server.get());
+		CountingEntity sink(SINK_ID, &scheduler);
+		CountingEntity replies(ECHO_ID, &scheduler);
+		server->advise(definition.lifetime, &echo);
+		server->advise(definition.lifetime, &sink);
+		client->advise(definition.lifetime, &replies);
+
+		if (!wait_for([&] { return server->connected.get() && client->connected.get(); }))
+		{
+			std::printf("%s: failed to connect\n", transport.name.c_str());
+			continue;
+		}
+
+		state.measure(transport.name + "/round_trip", ROUND_TRIPS, [&] {
+			for (int64_t i = 0; i < ROUND_TRIPS; ++i)
+			{
+				client->send(ECHO_ID, [i](rd::Buffer& buffer) { buffer.write_integral(i); });
+				while (replies.received.load(std::memory_order_acquire) <= i)
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		// the last one is split into chunks and paced by the send window
+		for (auto const& run : {std::make_pair(64, MESSAGES), std::make_pair(4096, MESSAGES), std::make_pair(1 << 20, LARGE_MESSAGES)})
+		{
+			const int32_t size = run.first;
+			const int64_t count = run.second;
+			const rd::Buffer::ByteArray payload(size, 42);
+			const int64_t before = sink.received.load();
+			state.measure(transport.name + "/throughput/bytes:" + std::to_string(size), count, [&] {
+				for (int64_t i = 0; i < count; ++i)
+				{
+					client->send(SINK_ID, [i, &payload](rd::Buffer& buffer) {
+						buffer.write_integral(i);
+						buffer.write_byte_array_raw(payload);
+					});
+				}
+				wait_for([&] { return sink.received.load(std::memory_order_acquire) - before >= count; });
+			});
+		}
+
+		definition.terminate();
+	}
+}
+
+RD_BENCHMARK(Wire_priority)
+{
+	using clock = std::chrono::steady_clock;
+
+	// round trip of one request sent right after a backlog of bulk messages, in the bulk lane itself and in the lanes
+	// above it
+	const auto transport = transports().front();
+	for (auto const& lane : {std::make_pair("bulk", rd::MessagePriority::Bulk), std::make_pair("normal", rd::MessagePriority::Normal),
+			 std::make_pair("interactive", rd::MessagePriority::Interactive)})
+	{
+		InlineScheduler scheduler;
+		rd::LifetimeDefinition definition(false);
+
+		auto server = transport.server(definition.lifetime, &scheduler, nullptr);
+		auto client = transport.client(definition.lifetime, &scheduler, server.get());
+
+		EchoEntity echo(ECHO_ID, &scheduler, server.get());
+		CountingEntity sink(SINK_ID, &scheduler);
+		CountingEntity replies(ECHO_ID, &scheduler);
+		server->advise(definition.lifetime, &echo);
+		server->advise(definition.lifetime, &sink);
+		client->advise(definition.lifetime, &replies);
+
+		if (!wait_for([&] { return server->connected.get() && client->connected.get(); }))
+		{
+			std::printf("%s: failed to connect\n", transport.name.c_str());
+			continue;
+		}
+
+		const rd::Buffer::ByteArray payload(4096, 42);
+		double seconds = 0;
+		for (int64_t i = 0; i < PRIORITY_ROUND_TRIPS; ++i)
+		{
+			for (int64_t j = 0; j < BULK_BACKLOG; ++j)
+			{
+				client->send(
+					SINK_ID,
+					[j, &payload](rd::Buffer& buffer) {
+						buffer.write_integral(j);
+						buffer.write_byte_array_raw(payload);
+					},
+					rd::MessagePriority::Bulk);
+			}
+
+			const auto start = clock::now();
+			client->send(ECHO_ID, [i](rd::Buffer& buffer) { buffer.write_integral(i); }, lane.second);
+			wait_for([&] { return replies.received.load(std::memory_order_acquire) > i; });
+			seconds += std::chrono::duration<double>(clock::now() - start).count();
+
+			wait_for([&] { return sink.received.load(std::memory_order_acquire) >= (i + 1) * BULK_BACKLOG; });
+		}
+		state.report(transport.name + "/round_trip_after_backlog/lane:" + lane.first, PRIORITY_ROUND_TRIPS, seconds);
+
+		definition.terminate();
+	}
+}
+
+RD_BENCHMARK(Wire_compression)
+{
+	// UTF-16 log lines like the ones unrealLog carries
+	std::u16string text;
+	for (int32_t i = 0; text.size() * sizeof(char16_t) < 4096; ++i)
+	{
+		const std::string line = "LogBlueprintUserMessages: [BP_PlayerCharacter_C_" + std::to_string(i % 7) +
+								 "] Warning: Accessed None trying to read property CallFunc_GetActorOfClass\n";
+		text.append(line.begin(), line.end());
+	}
+	const rd::Buffer::ByteArray payload(reinterpret_cast<uint8_t const*>(text.data()),
+		reinterpret_cast<uint8_t const*>(text.data() + text.size()));
+
+	const auto transport = transports().front();
+	for (bool compression : {false, true})
+	{
+		InlineScheduler scheduler;
+		rd::LifetimeDefinition definition(false);
+
+		auto server = transport.server(definition.lifetime, &scheduler, nullptr);
+		server->set_compression_enabled(compression);
+		auto client = transport.client(definition.lifetime, &scheduler, server.get());
+		client->set_compression_enabled(compression);
+
+		CountingEntity sink(SINK_ID, &scheduler);
+		server->advise(definition.lifetime, &sink);
+
+		if (!wait_for([&] { return server->connected.get() && client->connected.get(); }))
+		{
+			std::printf("%s: failed to connect\n", transport.name.c_str());
+			continue;
+		}
+		// capabilities are exchanged right after connecting
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		state.measure(transport.name + "/log_lines/compression:" + (compression ? "on" : "off"), MESSAGES, [&] {
+			for (int64_t i = 0; i < MESSAGES; ++i)
+			{
+				client->send(SINK_ID, [i, &payload](rd::Buffer& buffer) {
+					buffer.write_integral(i);
+					buffer.write_byte_array_raw(payload);
+				});
+			}
+			wait_for([&] { return sink.received.load(std::memory_order_acquire) >= MESSAGES; });
+		});
+
+		const auto stats = client->get_compression_stats();
+		if (stats.raw_bytes_sent != 0)
+		{
+			std::printf("    sent %lld bytes as %lld\n", static_cast<long long>(stats.raw_bytes_sent),
+				static_cast<long long>(stats.compressed_bytes_sent));
+		}
+
+		definition.terminate();
+	}
+}
@@ -46,6 +46,16 @@ public class RD : ModuleRules
 			PublicDefinitions.Add("_DARWIN");
 		}
 
+		if (Target.Platform == UnrealTargetPlatform.Linux)
+		{
+			// shm_open of ShmWire lives in librt before glibc 2.34
+#if UE_4_24_OR_LATER
+			PublicSystemLibraries.Add("rt");
+#else
+			PublicAdditionalLibraries.Add("rt");
+#endif
+		}
+
 		// Common dependencies
 		PrivateDefinitions.Add("rd_framework_cpp_EXPORTS");
 		PrivateDefinitions.Add("rd_core_cpp_EXPORTS");
@@ -8,6 +8,8 @@
 
 #include "LifetimeImpl.h"
 
+#include <util/pool_allocator.h>
+
 #include <std/hash.h>
 
 #include <memory>
@@ -27,7 +29,7 @@ struct RD_CORE_API hash<Lifetime>
 class RD_CORE_API Lifetime final
 {
 private:
-	using Allocator = std::allocator<LifetimeImpl>;
+	using Allocator = util::pool_allocator<LifetimeImpl>;
 
 	static /*thread_local */ Allocator allocator;
 
@@ -1,41 +1,120 @@
 #include "LifetimeImpl.h"
 
+#include <stdexcept>
 #include <utility>
 
 namespace rd
 {
 #if __cplusplus < 201703L
-LifetimeImpl::counter_t LifetimeImpl::get_id = 0;
+std::atomic<LifetimeImpl::counter_t> LifetimeImpl::get_id{0};
 #endif
 
-LifetimeImpl::LifetimeImpl(bool is_eternal) : eternaled(is_eternal), id(LifetimeImpl::get_id++)
+LifetimeImpl::LifetimeImpl(bool is_eternal) : eternaled(is_eternal), id(LifetimeImpl::get_id.fetch_add(1, std::memory_order_relaxed))
 {
 }
 
+constexpr int32_t LifetimeImpl::NONE;
+
+LifetimeImpl::action_id_t LifetimeImpl::Actions::insert(action_t action)
+{
+	int32_t slot = free;
+	if (slot != NONE)
+	{
+		free = slots[slot].next;
+	}
+	else
+	{
+		slot = static_cast<int32_t>(slots.size());
+		slots.emplace_back();
+	}
+	auto& it = slots[slot];
+	it.action = std::move(action);
+	it.prev = tail;
+	it.next = NONE;
+	(tail == NONE ? head : slots[tail].next) = slot;
+	tail = slot;
+	return static_cast<action_id_t>(it.generation) << 32 | static_cast<uint32_t>(slot);
+}
+
+LifetimeImpl::action_t LifetimeImpl::Actions::erase(action_id_t id)
+{
+	const auto slot = static_cast<int32_t>(id & 0xFFFFFFFF);
+	const auto generation = static_cast<uint32_t>(id >> 32);
+	if (id < 0 || slot >= static_cast<int32_t>(slots.size()))
+	{
+		return nullptr;
+	}
+	auto& it = slots[slot];
+	if (it.generation != generation || !it.action)
+	{
+		return nullptr;
+	}
+	(it.prev == NONE ? head : slots[it.prev].next) = it.next;
+	(it.next == NONE ? tail : slots[it.next].prev) = it.prev;
+	++it.generation;
+	it.next = free;
+	free = slot;
+	return std::move(it.action);
+}
+
 void LifetimeImpl::terminate()
 {
 	if (is_eternal())
 		return;
 
-	terminated = true;
+	if (terminated.exchange(true))
+		return;
 
 	// region thread-safety section
 
-	actions_t actions_copy;
+	Actions actions_copy;
 	{
 		std::lock_guard<decltype(actions_lock)> guard(actions_lock);
 		actions_copy = std::move(actions);
 
-		actions.clear();
+		actions = Actions{};
 	}
 	// endregion
 
-	for (auto it = actions_copy.rbegin(); it != actions_copy.rend(); ++it)
+	for (int32_t slot = actions_copy.tail; slot != NONE; slot = actions_copy.slots[slot].prev)
 	{
-		it->second();
+		actions_copy.slots[slot].action();
 	}
 }
 
+bool LifetimeImpl::try_add_action(action_t action, action_id_t& id)
+{
+	std::lock_guard<decltype(actions_lock)> guard(actions_lock);
+
+	if (is_terminated())
+	{
+		return false;
+	}
+	id = actions.insert(std::move(action));
+	return true;
+}
+
+LifetimeImpl::action_id_t LifetimeImpl::add_action_impl(action_t action)
+{
+	action_id_t result = -1;
+	if (!try_add_action(std::move(action), result))
+	{
+		throw std::invalid_argument("Already Terminated");
+	}
+	return result;
+}
+
+void LifetimeImpl::remove_action(action_id_t i)
+{
+	action_t removed;
+	{
+		std::lock_guard<decltype(actions_lock)> guard(actions_lock);
+
+		removed = actions.erase(i);
+	}
+	// destroyed outside of the lock, the captures may hold other lifetimes
+}
+
 bool LifetimeImpl::is_terminated() const
 {
 	return terminated;
@@ -51,9 +130,25 @@ void LifetimeImpl::attach_nested(std::shared_ptr<LifetimeImpl> nested)
 	if (nested->is_terminated() || is_eternal())
 		return;
 
-	std::function<void()> action = [nested] { nested->terminate(); };
-	counter_t action_id = add_action(action);
-	nested->add_action([this, id = action_id] { actions.erase(id); });
+	action_id_t action_id = -1;
+	if (!try_add_action([nested] { nested->terminate(); }, action_id))
+	{
+		nested->terminate();
+		return;
+	}
+	// the parent may be gone by the time [nested] terminates, so it's held weakly
+	action_id_t nested_action_id = -1;
+	if (!nested->try_add_action(
+			[parent = std::weak_ptr<LifetimeImpl>(shared_from_this()), action_id] {
+				if (auto locked = parent.lock())
+				{
+					locked->remove_action(action_id);
+				}
+			},
+			nested_action_id))
+	{
+		remove_action(action_id);
+	}
 }
 
 LifetimeImpl::~LifetimeImpl()
@@ -7,6 +7,8 @@
 #endif
 
 #include <std/hash.h>
+#include <util/small_function.h>
+#include <util/small_vector.h>
 
 #include <functional>
 #include <map>
@@ -21,7 +23,7 @@
 
 namespace rd
 {
-class RD_CORE_API LifetimeImpl final
+class RD_CORE_API LifetimeImpl final : public std::enable_shared_from_this<LifetimeImpl>
 {
 public:
 	friend class LifetimeDefinition;
@@ -30,20 +32,59 @@ public:
 
 	using counter_t = int32_t;
 
+	/**
+	 * \brief Handle of an added action: its slot in the low half and the slot's generation in the high half, so the handle
+	 * of a removed action never matches an action reusing the slot.
+	 */
+	using action_id_t = int64_t;
+
 private:
+	using action_t = util::small_function<void(), sizeof(std::function<void()>)>;
+
+	static constexpr int32_t NONE = -1;
+
+	struct Action
+	{
+		action_t action;
+		uint32_t generation = 0;
+		int32_t prev = NONE;
+		int32_t next = NONE;
+	};
+
+	/**
+	 * \brief Slab of actions linked in order of addition, so adding and removing are O(1) and [terminate] runs them
+	 * newest first. Free slots are chained through [Action::next] and reused.
+	 */
+	struct Actions
+	{
+		util::small_vector<Action, 2> slots;
+		int32_t head = NONE;
+		int32_t tail = NONE;
+		int32_t free = NONE;
+
+		action_id_t insert(action_t action);
+
+		action_t erase(action_id_t id);
+	};
+
 	bool eternaled = false;
 	std::atomic<bool> terminated{false};
 
 	counter_t id = 0;
 
-	counter_t action_id_in_map = 0;
-	using actions_t = ordered_map<int, std::function<void()>, rd::hash<int>>;
-	actions_t actions;
+	Actions actions;
 
 	void terminate();
 
 	std::mutex actions_lock;
 
+	/**
+	 * \brief Adds [action] unless the lifetime is terminated, in which case [id] is left untouched.
+	 */
+	bool try_add_action(action_t action, action_id_t& id);
+
+	action_id_t add_action_impl(action_t action);
+
 public:
 	// region ctor/dtor
 	explicit LifetimeImpl(bool is_eternal = false);
@@ -54,34 +95,21 @@ public:
 	// endregion
 
 	template <typename F>
-	counter_t add_action(F&& action)
+	action_id_t add_action(F&& action)
 	{
-		std::lock_guard<decltype(actions_lock)> guard(actions_lock);
-
 		if (is_eternal())
 		{
 			return -1;
 		}
-		if (is_terminated())
-		{
-			throw std::invalid_argument("Already Terminated");
-		}
-
-		actions[action_id_in_map] = std::forward<F>(action);
-		return action_id_in_map++;
+		return add_action_impl(action_t(std::forward<F>(action)));
 	}
 
-	void remove_action(counter_t i)
-	{
-		std::lock_guard<decltype(actions_lock)> guard(actions_lock);
-
-		actions.erase(i);
-	}
+	void remove_action(action_id_t i);
 
 #if __cplusplus >= 201703L
-	static inline counter_t get_id = 0;
+	static inline std::atomic<counter_t> get_id{0};
 #else
-	static counter_t get_id;
+	static std::atomic<counter_t> get_id;
 #endif
 
 	template <typename F, typename G>
@@ -97,6 +125,9 @@ public:
 
 	bool is_eternal() const;
 
+	/**
+	 * \brief Terminates [nested] with this lifetime, or right away if this one is already terminated.
+	 */
 	void attach_nested(std::shared_ptr<LifetimeImpl> nested);
 };
 }	 // namespace rd
@@ -21,16 +21,17 @@ public:
 	using Event = typename IViewableList<T>::Event;
 
 private:
-	using WA = typename std::allocator_traits<A>::template rebind_alloc<Wrapper<T>>;
+	using storage = viewable_storage<T>;
+	using WA = typename std::allocator_traits<A>::template rebind_alloc<typename storage::element_t>;
 
-	using data_t = std::vector<Wrapper<T>, WA>;
+	using data_t = std::vector<typename storage::element_t, WA>;
 	mutable data_t list;
 	Signal<Event> change;
 
 protected:
 	using WT = typename IViewableList<T>::WT;
 
-	const std::vector<Wrapper<T>>& getList() const override
+	const std::vector<typename storage::element_t>& getList() const override
 	{
 		return list;
 	}
@@ -162,22 +163,22 @@ public:
 
 		reference operator*() noexcept
 		{
-			return **it_;
+			return storage::get(*it_);
 		}
 
 		reference operator*() const noexcept
 		{
-			return **it_;
+			return storage::get(*it_);
 		}
 
 		pointer operator->() noexcept
 		{
-			return (*it_).get();
+			return &storage::get(*it_);
 		}
 
 		pointer operator->() const noexcept
 		{
-			return (*it_).get();
+			return &storage::get(*it_);
 		}
 	};
 
@@ -211,21 +212,24 @@ public:
 		change.advise(lifetime, handler);
 		for (int32_t i = 0; i < static_cast<int32_t>(size()); ++i)
 		{
-			handler(typename Event::Add(i, &(*list[i])));
+			auto&& value = storage::event_value(list[i]);
+			handler(typename Event::Add(i, &value));
 		}
 	}
 
 	bool add(WT element) const override
 	{
 		list.emplace_back(std::move(element));
-		change.fire(typename Event::Add(static_cast<int32_t>(size()) - 1, &(*list.back())));
+		auto&& value = storage::event_value(list.back());
+		change.fire(typename Event::Add(static_cast<int32_t>(size()) - 1, &value));
 		return true;
 	}
 
 	bool add(size_t index, WT element) const override
 	{
 		list.emplace(list.begin() + index, std::move(element));
-		change.fire(typename Event::Add(static_cast<int32_t>(index), &(*list[index])));
+		auto&& value = storage::event_value(list[index]);
+		change.fire(typename Event::Add(static_cast<int32_t>(index), &value));
 		return true;
 	}
 
@@ -234,13 +238,13 @@ public:
 		auto res = std::move(list[index]);
 		list.erase(list.begin() + index);
 
-		change.fire(typename Event::Remove(static_cast<int32_t>(index), &(*res)));
-		return wrapper::unwrap<T>(std::move(res));
+		change.fire(typename Event::Remove(static_cast<int32_t>(index), &storage::get(res)));
+		return storage::release(std::move(res));
 	}
 
 	bool remove(T const& element) const override
 	{
-		auto it = std::find_if(list.begin(), list.end(), [&element](auto const& p) { return *p == element; });
+		auto it = std::find_if(list.begin(), list.end(), [&element](auto const& p) { return storage::get(p) == element; });
 		if (it == list.end())
 		{
 			return false;
@@ -251,15 +255,16 @@ public:
 
 	T const& get(size_t index) const override
 	{
-		return *list[index];
+		return storage::get(list[index]);
 	}
 
 	WT set(size_t index, WT element) const override
 	{
 		auto old_value = std::move(list[index]);
-		list[index] = Wrapper<T>(std::move(element));
-		change.fire(typename Event::Update(static_cast<int32_t>(index), &(*old_value), &(*list[index])));	   //???
-		return wrapper::unwrap<T>(std::move(old_value));
+		list[index] = typename storage::element_t(std::move(element));
+		auto&& new_value = storage::event_value(list[index]);
+		change.fire(typename Event::Update(static_cast<int32_t>(index), &storage::get(old_value), &new_value));
+		return storage::release(std::move(old_value));
 	}
 
 	bool addAll(size_t index, std::vector<WT> elements) const override
@@ -283,14 +288,11 @@ public:
 
 	void clear() const override
 	{
-		std::vector<Event> changes;
-		for (size_t i = size(); i > 0; --i)
+		// events point into a copy, handlers may change the list meanwhile
+		const data_t elements = list;
+		for (size_t i = elements.size(); i > 0; --i)
 		{
-			changes.push_back(typename Event::Remove(static_cast<int32_t>(i - 1), &(*list[i - 1])));
-		}
-		for (auto const& e : changes)
-		{
-			change.fire(e);
+			change.fire(typename Event::Remove(static_cast<int32_t>(i - 1), &storage::get(elements[i - 1])));
 		}
 		list.clear();
 	}
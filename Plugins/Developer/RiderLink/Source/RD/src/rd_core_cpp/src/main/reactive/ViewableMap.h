@@ -27,11 +27,17 @@ private:
 	using WK = typename IViewableMap<K, V>::WK;
 	using WV = typename IViewableMap<K, V>::WV;
 	using OV = typename IViewableMap<K, V>::OV;
-	using PA = typename std::allocator_traits<VA>::template rebind_alloc<std::pair<Wrapper<K>, Wrapper<V>>>;
+	using key_storage = viewable_storage<K>;
+	using value_storage = viewable_storage<V>;
+	using entry_t = std::pair<typename key_storage::element_t, typename value_storage::element_t>;
+	using PA = typename std::allocator_traits<VA>::template rebind_alloc<entry_t>;
 
 	Signal<Event> change;
 
-	using data_t = ordered_map<Wrapper<K>, Wrapper<V>, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>, PA>;
+	// entries lie in a deque in insertion order, found through an open-addressed index; appending doesn't move them,
+	// so the values [get] and [set] return stay put until their entry or an earlier one is removed
+	using data_t = ordered_map<typename key_storage::element_t, typename value_storage::element_t, wrapper::TransparentHash<K>,
+		wrapper::TransparentKeyEqual<K>, PA>;
 	mutable data_t map;
 
 public:
@@ -162,22 +168,22 @@ public:
 
 		reference operator*() const noexcept
 		{
-			return *it_.value();
+			return value_storage::get(it_.value());
 		}
 
 		pointer operator->() const noexcept
 		{
-			return it_.value().get();
+			return &value_storage::get(it_.value());
 		}
 
 		key_type const& key() const
 		{
-			return *it_.key();
+			return key_storage::get(it_.key());
 		}
 
 		value_type const& value() const
 		{
-			return *it_.value();
+			return value_storage::get(it_.value());
 		}
 	};
 
@@ -245,10 +251,9 @@ public:
 		/*for (auto const &[key, value] : map) {*/
 		for (auto const& it : map)
 		{
-			auto& key = it.first;
-			auto& value = it.second;
-			handler(Event(typename Event::Add(&(*key), &(*value))));
-			;
+			auto&& key = key_storage::event_value(it.first);
+			auto&& value = value_storage::event_value(it.second);
+			handler(Event(typename Event::Add(&key, &value)));
 		}
 	}
 
@@ -259,61 +264,59 @@ public:
 		{
 			return nullptr;
 		}
-		return &(*it->second);
+		return &value_storage::get(it->second);
 	}
 
 	const V* set(WK key, WV value) const override
 	{
-		if (map.count(key) == 0)
+		auto it = map.find(key);
+		if (it == map.end())
 		{
 			/*auto[it, success] = map.emplace(std::make_unique<K>(std::move(key)), std::make_unique<V>(std::move(value)));*/
 			auto node = map.emplace(std::move(key), std::move(value));
-			auto& it = node.first;
-			auto const& key_ptr = it->first;
-			auto const& value_ptr = it->second;
-			change.fire(typename Event::Add(&(*key_ptr), &(*value_ptr)));
+			auto&& key_value = key_storage::event_value(node.first->first);
+			auto&& new_value = value_storage::event_value(node.first->second);
+			change.fire(typename Event::Add(&key_value, &new_value));
 			return nullptr;
 		}
 		else
 		{
-			auto it = map.find(key);
-			auto const& key_ptr = it->first;
-			auto const& value_ptr = it->second;
-
-			if (*value_ptr != wrapper::get<V>(value))
+			if (value_storage::get(it->second) != wrapper::get<V>(value))
 			{	 // TO-DO more effective
-				Wrapper<V> old_value = std::move(map.at(key));
-
-				map.at(key_ptr) = Wrapper<V>(std::move(value));
-				change.fire(typename Event::Update(&(*key_ptr), &(*old_value), &(*value_ptr)));
+				auto old_value = std::move(it.value());
+
+				it.value() = typename value_storage::element_t(std::move(value));
+				auto&& key_value = key_storage::event_value(it->first);
+				auto&& new_value = value_storage::event_value(it->second);
+				// handlers may change the map, which invalidates [it]
+				const V* result = &value_storage::get(it->second);
+				change.fire(typename Event::Update(&key_value, &value_storage::get(old_value), &new_value));
+				return result;
 			}
-			return &*(value_ptr);
+			return &value_storage::get(it->second);
 		}
 	}
 
 	OV remove(K const& key) const override
 	{
-		if (map.count(key) > 0)
+		auto it = map.find(key);
+		if (it != map.end())
 		{
-			Wrapper<V> old_value = std::move(map.at(key));
-			change.fire(typename Event::Remove(&key, &(*old_value)));
+			auto old_value = std::move(it.value());
+			change.fire(typename Event::Remove(&key, &value_storage::get(old_value)));
 			map.erase(key);
-			return wrapper::unwrap<V>(std::move(old_value));
+			return value_storage::release(std::move(old_value));
 		}
 		return nullopt;
 	}
 
 	void clear() const override
 	{
-		std::vector<Event> changes;
-		/*for (auto const &[key, value] : map) {*/
-		for (auto const& it : map)
-		{
-			changes.push_back(typename Event::Remove(&(*it.first), &(*it.second)));
-		}
-		for (auto const& it : changes)
+		// events point into a copy, handlers may change the map meanwhile
+		const auto entries = map.values_container();
+		for (auto const& entry : entries)
 		{
-			change.fire(it);
+			change.fire(typename Event::Remove(&key_storage::get(entry.first), &value_storage::get(entry.second)));
 		}
 		map.clear();
 	}
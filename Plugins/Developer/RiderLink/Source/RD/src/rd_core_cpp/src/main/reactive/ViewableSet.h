@@ -23,10 +23,13 @@ public:
 
 private:
 	using WT = typename IViewableSet<T, A>::WT;
-	using WA = typename std::allocator_traits<A>::template rebind_alloc<Wrapper<T>>;
+	using storage = viewable_storage<T>;
+	using WA = typename std::allocator_traits<A>::template rebind_alloc<typename storage::element_t>;
 
 	Signal<Event> change;
-	using data_t = ordered_set<Wrapper<T>, wrapper::TransparentHash<T>, wrapper::TransparentKeyEqual<T>, WA>;
+	// elements lie in one array in insertion order, found through an open-addressed index
+	using data_t = ordered_set<typename storage::element_t, wrapper::TransparentHash<T>, wrapper::TransparentKeyEqual<T>, WA,
+		std::vector<typename storage::element_t, WA>>;
 	mutable data_t set;
 
 public:
@@ -155,12 +158,12 @@ public:
 
 		reference operator*() const noexcept
 		{
-			return **it_;
+			return storage::get(*it_);
 		}
 
 		pointer operator->() const noexcept
 		{
-			return (*it_).get();
+			return &storage::get(*it_);
 		}
 	};
 
@@ -196,7 +199,8 @@ public:
 		{
 			return false;
 		}
-		change.fire(Event(AddRemove::ADD, &(wrapper::get<T>(*it.first))));
+		auto&& value = storage::event_value(*it.first);
+		change.fire(Event(AddRemove::ADD, &value));
 		return true;
 	}
 
@@ -211,14 +215,11 @@ public:
 
 	void clear() const override
 	{
-		std::vector<Event> changes;
-		for (auto const& element : set)
+		// events point into a copy, handlers may change the set meanwhile
+		const auto elements = set.values_container();
+		for (auto const& element : elements)
 		{
-			changes.push_back(Event(AddRemove::REMOVE, &(*element)));
-		}
-		for (auto const& e : changes)
-		{
-			change.fire(e);
+			change.fire(Event(AddRemove::REMOVE, &storage::get(element)));
 		}
 		set.clear();
 	}
@@ -230,7 +231,8 @@ public:
 			return false;
 		}
 		auto it = set.find(element);
-		change.fire(Event(AddRemove::REMOVE, &(wrapper::get<T>(*it))));
+		auto&& value = storage::event_value(*it);
+		change.fire(Event(AddRemove::REMOVE, &value));
 		set.erase(it);
 		return true;
 	}
@@ -239,7 +241,8 @@ public:
 	{
 		for (auto const& x : set)
 		{
-			handler(Event(AddRemove::ADD, &(*x)));
+			auto&& value = storage::event_value(x);
+			handler(Event(AddRemove::ADD, &value));
 		}
 		change.advise(lifetime, handler);
 	}
@@ -3,6 +3,7 @@
 
 #include "interfaces.h"
 #include "viewable_collections.h"
+#include "viewable_storage.h"
 
 #include <lifetime/LifetimeDefinition.h>
 #include <util/overloaded.h>
@@ -239,14 +240,15 @@ public:
 		IViewableList<U> const& list);
 
 protected:
-	virtual const std::vector<Wrapper<T>>& getList() const = 0;
+	virtual const std::vector<typename viewable_storage<T>::element_t>& getList() const = 0;
 };
 
 template <typename T>
 typename std::enable_if<(!std::is_abstract<T>::value), std::vector<T>>::type convert_to_list(IViewableList<T> const& list)
 {
 	std::vector<T> res(list.size());
-	std::transform(list.getList().begin(), list.getList().end(), res.begin(), [](Wrapper<T> const& ptr) { return *ptr; });
+	std::transform(list.getList().begin(), list.getList().end(), res.begin(),
+		[](typename viewable_storage<T>::element_t const& element) { return viewable_storage<T>::get(element); });
 	return res;
 }
 }	 // namespace rd
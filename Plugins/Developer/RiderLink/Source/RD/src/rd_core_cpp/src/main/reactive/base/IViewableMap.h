@@ -5,6 +5,7 @@
 #include "util/overloaded.h"
 #include "interfaces.h"
 #include "viewable_collections.h"
+#include "viewable_storage.h"
 #include "util/core_util.h"
 
 #include "std/unordered_map.h"
@@ -122,7 +123,8 @@ protected:
 	using OV = opt_or_wrapper<V>;
 
 	mutable rd::unordered_map<Lifetime,
-		ordered_map<K const*, LifetimeDefinition, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>>>
+		ordered_map<typename viewable_storage<K>::handle_t, LifetimeDefinition, wrapper::TransparentHash<K>,
+			wrapper::TransparentKeyEqual<K>>>
 		lifetimes;
 
 public:
@@ -156,7 +158,8 @@ public:
 					if (lifetimes[lifetime].count(key) == 0)
 					{
 						/*auto const &[it, inserted] = lifetimes[lifetime].emplace(key, LifetimeDefinition(lifetime));*/
-						auto const& pair = lifetimes[lifetime].emplace(&key, LifetimeDefinition(lifetime));
+						auto const& pair =
+							lifetimes[lifetime].emplace(viewable_storage<K>::handle(key), LifetimeDefinition(lifetime));
 						auto& it = pair.first;
 						auto& inserted = pair.second;
 						RD_ASSERT_MSG(inserted, "lifetime definition already exists in viewable map by key:" + to_string(key));
@@ -169,7 +172,8 @@ public:
 					RD_ASSERT_MSG(lifetimes.at(lifetime).count(key) > 0,
 						"attempting to remove non-existing lifetime in viewable map by key:" + to_string(key));
 					LifetimeDefinition def = std::move(lifetimes.at(lifetime).at(key));
-					lifetimes.at(lifetime).erase(key);
+					// entries are never iterated, so the last one fills the gap rather than all after it moving
+					lifetimes.at(lifetime).unordered_erase(key);
 					def.terminate();
 					break;
 				}
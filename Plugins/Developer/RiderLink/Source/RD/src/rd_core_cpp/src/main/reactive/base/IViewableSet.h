@@ -3,6 +3,7 @@
 
 #include "interfaces.h"
 #include "viewable_collections.h"
+#include "viewable_storage.h"
 
 #include <lifetime/LifetimeDefinition.h>
 #include <util/core_util.h>
@@ -43,7 +44,8 @@ class IViewableSet : public IViewable<T>, public ISource<detail::SetEvent<T>>
 protected:
 	using WT = value_or_wrapper<T>;
 	mutable rd::unordered_map<Lifetime,
-		ordered_map<T const*, LifetimeDefinition, wrapper::TransparentHash<T>, wrapper::TransparentKeyEqual<T>>>
+		ordered_map<typename viewable_storage<T>::handle_t, LifetimeDefinition, wrapper::TransparentHash<T>,
+			wrapper::TransparentKeyEqual<T>>>
 		lifetimes;
 
 public:
@@ -93,7 +95,7 @@ public:
 				case AddRemove::ADD:
 				{
 					/*auto const &[it, inserted] = lifetimes[lifetime].emplace(key, LifetimeDefinition(lifetime));*/
-					auto const& it = lifetimes[lifetime].emplace(&key, lifetime);
+					auto const& it = lifetimes[lifetime].emplace(viewable_storage<T>::handle(key), lifetime);
 					RD_ASSERT_MSG(it.second, "lifetime definition already exists in viewable set by key:" + to_string(key));
 					handler(it.first->second.lifetime, key);
 					break;
@@ -103,7 +105,8 @@ public:
 					RD_ASSERT_MSG(lifetimes.at(lifetime).count(key) > 0,
 						"attempting to remove non-existing lifetime in viewable set by key:" + to_string(key));
 					LifetimeDefinition def = std::move(lifetimes.at(lifetime).at(key));
-					lifetimes.at(lifetime).erase(key);
+					// entries are never iterated, so the last one fills the gap rather than all after it moving
+					lifetimes.at(lifetime).unordered_erase(key);
 					def.terminate();
 					break;
 				}
@@ -6,10 +6,14 @@
 
 #include <lifetime/Lifetime.h>
 #include <util/core_util.h>
+#include <util/core_traits.h>
+#include <util/small_function.h>
+#include <util/small_vector.h>
 
 #include <utility>
 #include <functional>
 #include <atomic>
+#include <vector>
 
 namespace rd
 {
@@ -22,10 +26,16 @@ class Signal final : public ISignal<T>
 private:
 	using WT = typename ISignal<T>::WT;
 
+	/**
+	 * \brief Handlers as large as std::function are kept inline, so wrapping the one passed to the virtual [advise]
+	 * doesn't allocate again.
+	 */
+	using handler_t = util::small_function<void(T const&), sizeof(std::function<void(T const&)>)>;
+
 	class Event
 	{
 	private:
-		std::function<void(T const&)> action;
+		handler_t action;
 		Lifetime lifetime;
 
 	public:
@@ -33,11 +43,13 @@ private:
 		Event() = delete;
 
 		template <typename F>
-		Event(F&& action, Lifetime lifetime) : action(std::forward<F>(action)), lifetime(lifetime)
+		Event(F&& action, Lifetime lifetime) : action(std::forward<F>(action)), lifetime(std::move(lifetime))
 		{
 		}
 
 		Event(Event&&) = default;
+
+		Event& operator=(Event&&) = default;
 		// endregion
 
 		bool is_alive() const
@@ -45,44 +57,107 @@ private:
 			return !lifetime->is_terminated();
 		}
 
-		void execute_if_alive(T const& value) const
+		void execute(T const& value) const
 		{
-			if (is_alive())
-			{
-				action(value);
-			}
+			action(value);
 		}
 	};
 
-	using counter_t = int32_t;
-	using listeners_t = std::map<counter_t, Event>;
+	static constexpr size_t INLINE_LISTENERS = 2;
+
+	using listeners_t = util::small_vector<Event, INLINE_LISTENERS>;
 
-	mutable counter_t advise_id = 0;
 	mutable listeners_t listeners, priority_listeners;
+	/**
+	 * \brief Listeners advised from a handler, appended to their queue once the outermost [fire] returns. Until then
+	 * queues are only read, so a nested [fire] or [advise] never moves an event being executed.
+	 */
+	mutable std::vector<std::pair<bool, Event>> advised_while_firing;
+	mutable int32_t firing_depth = 0;
+	/**
+	 * \brief Terminated listeners met by fires since the last compaction.
+	 */
+	mutable size_t dead_listeners = 0;
+
+	class FireScope
+	{
+		Signal const& signal;
+
+	public:
+		explicit FireScope(Signal const& signal) : signal(signal)
+		{
+			++signal.firing_depth;
+		}
+
+		FireScope(FireScope const&) = delete;
+
+		~FireScope()
+		{
+			if (--signal.firing_depth == 0)
+			{
+				signal.settle();
+			}
+		}
+	};
 
 	static void cleanup(listeners_t& queue)
 	{
-		util::erase_if(queue, [](Event const& e) -> bool { return !e.is_alive(); });
+		queue.erase_if([](Event const& e) -> bool { return !e.is_alive(); });
+	}
+
+	void settle() const
+	{
+		if (dead_listeners != 0)
+		{
+			cleanup(priority_listeners);
+			cleanup(listeners);
+			dead_listeners = 0;
+		}
+		if (!advised_while_firing.empty())
+		{
+			for (auto& it : advised_while_firing)
+			{
+				(it.first ? priority_listeners : listeners).push_back(std::move(it.second));
+			}
+			advised_while_firing.clear();
+		}
 	}
 
-	void fire_impl(T const& value, listeners_t& queue) const
+	void fire_impl(T const& value, listeners_t const& queue) const
 	{
-		for (auto const& p : queue)
+		// the size is taken once: events advised from handlers wait in [advised_while_firing] and don't see this value
+		const size_t count = queue.size();
+		for (size_t i = 0; i < count; ++i)
 		{
-			auto const& event = p.second;
-			event.execute_if_alive(value);
+			auto const& event = queue[i];
+			if (event.is_alive())
+			{
+				event.execute(value);
+			}
+			else
+			{
+				++dead_listeners;
+			}
 		}
-		cleanup(queue);
 	}
 
 	template <typename F>
-	void advise0(const Lifetime& lifetime, F&& handler, listeners_t& queue) const
+	void advise0(const Lifetime& lifetime, F&& handler, bool priority) const
 	{
 		if (lifetime->is_terminated())
 			return;
-		counter_t id = advise_id /*.load()*/;
-		queue.emplace(id, Event(std::forward<F>(handler), lifetime));
-		++advise_id;
+		if (firing_depth > 0)
+		{
+			advised_while_firing.emplace_back(priority, Event(std::forward<F>(handler), lifetime));
+			return;
+		}
+		auto& queue = priority ? priority_listeners : listeners;
+		if (queue.size() == queue.capacity())
+		{
+			// terminated listeners are dropped before growing, so a signal advised and unadvised in a loop stays small
+			cleanup(queue);
+		}
+		queue.emplace_back(std::forward<F>(handler), lifetime);
 	}
 
 public:
@@ -106,6 +181,7 @@ public:
 
 	void fire(T const& value) const override
 	{
+		FireScope scope(*this);
 		fire_impl(value, priority_listeners);
 		fire_impl(value, listeners);
 	}
@@ -114,7 +190,17 @@ public:
 
 	void advise(Lifetime lifetime, std::function<void(T const&)> handler) const override
 	{
-		advise0(lifetime, std::move(handler), isPriorityAdvise() ? priority_listeners : listeners);
+		advise0(lifetime, std::move(handler), isPriorityAdvise());
+	}
+
+	/**
+	 * \brief Same as the virtual [advise], but [handler] is stored as is instead of through std::function.
+	 */
+	template <typename F, typename = std::enable_if_t<util::is_invocable_v<F, T const&> &&
+												  !std::is_same<std::decay_t<F>, std::function<void(T const&)>>::value>>
+	void advise(Lifetime lifetime, F&& handler) const
+	{
+		advise0(lifetime, std::forward<F>(handler), isPriorityAdvise());
 	}
 
 	static bool isPriorityAdvise()
@@ -0,0 +1,82 @@
+#ifndef RD_CPP_VIEWABLE_STORAGE_H
+#define RD_CPP_VIEWABLE_STORAGE_H
+
+#include <types/wrapper.h>
+#include <util/core_traits.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace rd
+{
+/**
+ * \brief How viewable collections store elements of [T]: in a [Wrapper] each, whose value stays put while the
+ * container moves it around, or, for [util::inline_storage_v] types, inline, so that elements lie in one array and
+ * the hash index of maps and sets compares them without following a pointer.
+ *
+ * Events point to the value while they are fired, inline values are copied for it, so a handler changing the
+ * collection doesn't move the value from under the next one. What outlives an event, e.g. the lifetime of a view
+ * entry, keys its element by [handle_t]: the address of a wrapped value, a copy of an inline one.
+ */
+template <typename T, typename = void>
+struct viewable_storage
+{
+	using element_t = Wrapper<T>;
+	using handle_t = T const*;
+
+	static T const& get(element_t const& element)
+	{
+		return *element;
+	}
+
+	/**
+	 * \brief Value for an event about [element] to point to, bind it to auto&&.
+	 */
+	static T const& event_value(element_t const& element)
+	{
+		return *element;
+	}
+
+	static handle_t handle(T const& value)
+	{
+		return &value;
+	}
+
+	/**
+	 * \brief [element] as collections return removed elements: the value, or the wrapper of a type kept in one.
+	 */
+	static decltype(auto) release(element_t&& element)
+	{
+		return wrapper::unwrap<T>(std::move(element));
+	}
+};
+
+template <typename T>
+struct viewable_storage<T, typename std::enable_if_t<util::inline_storage_v<T>>>
+{
+	using element_t = T;
+	using handle_t = T;
+
+	static T const& get(element_t const& element)
+	{
+		return element;
+	}
+
+	static T event_value(element_t const& element)
+	{
+		return element;
+	}
+
+	static handle_t handle(T const& value)
+	{
+		return value;
+	}
+
+	static T release(element_t&& element)
+	{
+		return element;
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_VIEWABLE_STORAGE_H
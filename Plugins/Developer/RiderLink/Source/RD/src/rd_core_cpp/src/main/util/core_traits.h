@@ -3,6 +3,7 @@
 
 #include <types/Void.h>
 
+#include <cstdint>
 #include <type_traits>
 #include <string>
 
@@ -110,6 +111,24 @@ static_assert(!in_heap_v<int>, "int shouldn't be placed in shared memory");
 
 // endregion
 
+// region inline_storage
+
+/**
+ * \brief Small trivially copyable types, e.g. numbers, enums and ids, which viewable collections keep inline rather
+ * than in a [Wrapper] each, see [viewable_storage]. Copying one is as cheap as passing a pointer to it.
+ */
+template <typename T>
+using inline_storage = conjunction<negation<in_heap<T>>, std::is_trivially_copyable<T>, negation<std::is_same<T, bool>>,
+	bool_constant<sizeof(T) <= 16>>;
+
+template <typename T>
+/*inline */ constexpr bool inline_storage_v = inline_storage<T>::value;
+
+static_assert(inline_storage_v<int64_t>, "int64_t should be stored inline");
+static_assert(!inline_storage_v<std::wstring>, "std::wstring shouldn't be stored inline");
+
+// endregion
+
 // region literal
 
 template <typename T>
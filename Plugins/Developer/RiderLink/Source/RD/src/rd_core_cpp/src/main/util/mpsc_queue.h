@@ -0,0 +1,86 @@
+#ifndef RD_CPP_MPSC_QUEUE_H
+#define RD_CPP_MPSC_QUEUE_H
+
+#include <atomic>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Intrusive multi-producer single-consumer queue (D. Vyukov). Producers never block each other: push is one
+ * exchange and one store. [Node] must expose `std::atomic<Node*> next`.
+ *
+ * pop() may return nullptr while a producer is in the middle of push, so emptiness must be tracked separately
+ * by whoever needs to sleep on it.
+ */
+template <typename Node>
+class intrusive_mpsc_queue
+{
+	std::atomic<Node*> head;
+	Node* tail;
+	Node stub;
+
+public:
+	// region ctor/dtor
+
+	intrusive_mpsc_queue() : head(&stub), tail(&stub)
+	{
+		stub.next.store(nullptr, std::memory_order_relaxed);
+	}
+
+	intrusive_mpsc_queue(intrusive_mpsc_queue const&) = delete;
+
+	intrusive_mpsc_queue& operator=(intrusive_mpsc_queue const&) = delete;
+	// endregion
+
+	/**
+	 * \brief Can be called from any thread.
+	 */
+	void push(Node* node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		Node* prev = head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	/**
+	 * \brief Must be called from the consumer thread only.
+	 */
+	Node* pop()
+	{
+		Node* current = tail;
+		Node* next = current->next.load(std::memory_order_acquire);
+		if (current == &stub)
+		{
+			if (next == nullptr)
+			{
+				return nullptr;
+			}
+			tail = next;
+			current = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next != nullptr)
+		{
+			tail = next;
+			return current;
+		}
+		if (current != head.load(std::memory_order_acquire))
+		{
+			return nullptr;
+		}
+		push(&stub);
+		next = current->next.load(std::memory_order_acquire);
+		if (next != nullptr)
+		{
+			tail = next;
+			return current;
+		}
+		return nullptr;
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_MPSC_QUEUE_H
@@ -0,0 +1,166 @@
+#ifndef RD_CPP_PERFECT_HASH_TABLE_H
+#define RD_CPP_PERFECT_HASH_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Immutable map from 64-bit keys to [Value], built once from a known set of keys so that every key has a slot
+ * of its own: a lookup is two array reads and one key comparison, no probing. Keys are spread into buckets, each
+ * bucket gets a displacement under which its keys land in free slots ("hash and displace").
+ *
+ * Keys must be distinct. Looking up a key that wasn't in the set yields nullptr.
+ */
+template <typename Value>
+class perfect_hash_table
+{
+	struct Slot
+	{
+		int64_t key = 0;
+		Value value{};
+		bool used = false;
+	};
+
+	std::vector<uint32_t> displacements;
+	std::vector<Slot> slots;
+	uint64_t bucket_mask = 0;
+	uint64_t slot_mask = 0;
+
+	// the splitmix64 finalizer, ids hashed from type names differ in few bits
+	static uint64_t mix(uint64_t x)
+	{
+		x ^= x >> 30;
+		x *= 0xBF58476D1CE4E5B9ULL;
+		x ^= x >> 27;
+		x *= 0x94D049BB133111EBULL;
+		x ^= x >> 31;
+		return x;
+	}
+
+	static uint64_t displace(uint64_t hash, uint32_t displacement)
+	{
+		return mix(hash + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(displacement) + 1));
+	}
+
+	static size_t power_of_two_at_least(size_t n)
+	{
+		size_t result = 1;
+		while (result < n)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+
+	// fails if some bucket finds no displacement, the caller retries with more slots
+	bool place(std::vector<std::pair<int64_t, Value>> const& entries, size_t slot_count)
+	{
+		const size_t bucket_count = power_of_two_at_least(entries.size());
+		bucket_mask = bucket_count - 1;
+		slot_mask = slot_count - 1;
+		displacements.assign(bucket_count, 0);
+		slots.assign(slot_count, Slot{});
+
+		std::vector<std::vector<size_t>> buckets(bucket_count);
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			buckets[mix(static_cast<uint64_t>(entries[i].first)) & bucket_mask].push_back(i);
+		}
+		// the fuller a bucket the harder it is to place, so those go first while most slots are free
+		std::vector<size_t> order(bucket_count);
+		for (size_t i = 0; i < bucket_count; ++i)
+		{
+			order[i] = i;
+		}
+		std::stable_sort(
+			order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+		constexpr uint32_t MAX_DISPLACEMENT = 1u << 16;
+		std::vector<uint64_t> taken;
+		for (size_t bucket : order)
+		{
+			auto const& members = buckets[bucket];
+			if (members.empty())
+			{
+				break;
+			}
+			uint32_t displacement = 0;
+			for (; displacement < MAX_DISPLACEMENT; ++displacement)
+			{
+				taken.clear();
+				bool fits = true;
+				for (size_t member : members)
+				{
+					const uint64_t slot = displace(mix(static_cast<uint64_t>(entries[member].first)), displacement) & slot_mask;
+					if (slots[slot].used || std::find(taken.begin(), taken.end(), slot) != taken.end())
+					{
+						fits = false;
+						break;
+					}
+					taken.push_back(slot);
+				}
+				if (fits)
+				{
+					break;
+				}
+			}
+			if (displacement == MAX_DISPLACEMENT)
+			{
+				return false;
+			}
+			displacements[bucket] = displacement;
+			for (size_t i = 0; i < members.size(); ++i)
+			{
+				auto& slot = slots[taken[i]];
+				slot.key = entries[members[i]].first;
+				slot.value = entries[members[i]].second;
+				slot.used = true;
+			}
+		}
+		return true;
+	}
+
+public:
+	perfect_hash_table() = default;
+
+	explicit perfect_hash_table(std::vector<std::pair<int64_t, Value>> const& entries)
+	{
+		if (entries.empty())
+		{
+			return;
+		}
+		// half the slots free makes a displacement quick to find, more are added only if some bucket doesn't fit
+		size_t slot_count = power_of_two_at_least(2 * entries.size());
+		while (!place(entries, slot_count))
+		{
+			slot_count <<= 1;
+		}
+	}
+
+	Value const* find(int64_t key) const
+	{
+		if (slots.empty())
+		{
+			return nullptr;
+		}
+		const uint64_t hash = mix(static_cast<uint64_t>(key));
+		Slot const& slot = slots[displace(hash, displacements[hash & bucket_mask]) & slot_mask];
+		return slot.used && slot.key == key ? &slot.value : nullptr;
+	}
+
+	size_t slot_count() const
+	{
+		return slots.size();
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_PERFECT_HASH_TABLE_H
@@ -0,0 +1,126 @@
+#ifndef RD_CPP_POOL_ALLOCATOR_H
+#define RD_CPP_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Allocator which keeps up to [MaxCached] freed single-object blocks per thread and hands them out again, for
+ * objects created and destroyed at a high rate, e.g. with std::allocate_shared. Arrays go to operator new directly.
+ *
+ * A block freed on another thread joins that thread's cache. Caches are released when their thread exits.
+ */
+template <typename T, size_t MaxCached = 256>
+class pool_allocator
+{
+	struct block
+	{
+		block* next;
+	};
+
+	struct cache_t
+	{
+		block* head;
+		size_t size;
+	};
+
+	/**
+	 * \brief Releases the cache of its thread, blocks freed after that go straight to operator delete.
+	 */
+	struct release_on_exit
+	{
+		cache_t& cache;
+
+		~release_on_exit()
+		{
+			while (cache.head != nullptr)
+			{
+				block* next = cache.head->next;
+				::operator delete(cache.head);
+				cache.head = next;
+			}
+			cache.size = MaxCached;
+		}
+	};
+
+	static cache_t& cache()
+	{
+		// trivially destructible, so the storage stays usable for frees made by other thread_local destructors
+		static thread_local cache_t cache{nullptr, 0};
+		static thread_local release_on_exit release{cache};
+		(void) release;
+		return cache;
+	}
+
+public:
+	static_assert(sizeof(T) >= sizeof(block), "block must fit a pointer");
+	static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+	using value_type = T;
+
+	template <typename U>
+	struct rebind
+	{
+		using other = pool_allocator<U, MaxCached>;
+	};
+
+	pool_allocator() noexcept = default;
+
+	template <typename U>
+	pool_allocator(pool_allocator<U, MaxCached> const&) noexcept
+	{
+	}
+
+	T* allocate(size_t n)
+	{
+		if (n == 1)
+		{
+			auto& free = cache();
+			if (free.head != nullptr)
+			{
+				block* result = free.head;
+				free.head = result->next;
+				--free.size;
+				return reinterpret_cast<T*>(result);
+			}
+		}
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		if (n == 1)
+		{
+			auto& free = cache();
+			if (free.size < MaxCached)
+			{
+				auto* freed = reinterpret_cast<block*>(p);
+				freed->next = free.head;
+				free.head = freed;
+				++free.size;
+				return;
+			}
+		}
+		::operator delete(p);
+	}
+
+	template <typename U>
+	bool operator==(pool_allocator<U, MaxCached> const&) const noexcept
+	{
+		return true;
+	}
+
+	template <typename U>
+	bool operator!=(pool_allocator<U, MaxCached> const&) const noexcept
+	{
+		return false;
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_POOL_ALLOCATOR_H
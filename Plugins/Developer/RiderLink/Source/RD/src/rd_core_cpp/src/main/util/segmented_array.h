@@ -0,0 +1,141 @@
+#ifndef RD_CPP_SEGMENTED_ARRAY_H
+#define RD_CPP_SEGMENTED_ARRAY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Append-only array kept in segments, each twice the size of the one before, so an element never moves once
+ * written. Reads take no lock and never wait: one load of the segment and one of the element. Writes are serialized
+ * by a mutex of the array.
+ *
+ * An element may be read once its write happens-before the read: after [size] returned more than its index, or when
+ * the index came from the writer through a lock or a message. Slots are default constructed with their segment, so
+ * [set] may fill them in any order.
+ */
+template <typename T, size_t FirstSegment = 64>
+class segmented_array
+{
+	static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0, "FirstSegment must be a power of two");
+
+	// FirstSegment * (2^32 - 1) elements, more than any int32_t index
+	static constexpr size_t SEGMENTS = 32;
+
+	std::array<std::atomic<T*>, SEGMENTS> segments{};
+	std::atomic<size_t> size_{0};
+	std::mutex write_lock;
+
+	// floor(log2(index / FirstSegment + 1))
+	static size_t segment_of(size_t index)
+	{
+		const uint64_t scaled = static_cast<uint64_t>(index / FirstSegment) + 1;
+#if defined(_MSC_VER)
+		unsigned long bit = 0;
+		_BitScanReverse64(&bit, scaled);
+		return static_cast<size_t>(bit);
+#else
+		return static_cast<size_t>(63 - __builtin_clzll(scaled));
+#endif
+	}
+
+	static size_t segment_start(size_t segment)
+	{
+		return FirstSegment * ((size_t{1} << segment) - 1);
+	}
+
+	// requires write_lock
+	T& slot(size_t index)
+	{
+		const size_t segment = segment_of(index);
+		T* data = segments[segment].load(std::memory_order_relaxed);
+		if (data == nullptr)
+		{
+			data = new T[FirstSegment << segment]();
+			segments[segment].store(data, std::memory_order_release);
+		}
+		return data[index - segment_start(segment)];
+	}
+
+public:
+	// region ctor/dtor
+
+	segmented_array() = default;
+
+	segmented_array(segmented_array const&) = delete;
+
+	segmented_array& operator=(segmented_array const&) = delete;
+
+	~segmented_array()
+	{
+		clear();
+	}
+	// endregion
+
+	/**
+	 * \brief One past the highest index written.
+	 */
+	size_t size() const
+	{
+		return size_.load(std::memory_order_acquire);
+	}
+
+	T const& operator[](size_t index) const
+	{
+		const size_t segment = segment_of(index);
+		return segments[segment].load(std::memory_order_acquire)[index - segment_start(segment)];
+	}
+
+	/**
+	 * \brief Appends [value] and returns its index.
+	 */
+	size_t push_back(T value)
+	{
+		std::lock_guard<std::mutex> guard(write_lock);
+		const size_t index = size_.load(std::memory_order_relaxed);
+		slot(index) = std::move(value);
+		size_.store(index + 1, std::memory_order_release);
+		return index;
+	}
+
+	/**
+	 * \brief Writes [value] at [index], which mustn't be read meanwhile.
+	 */
+	void set(size_t index, T value)
+	{
+		std::lock_guard<std::mutex> guard(write_lock);
+		slot(index) = std::move(value);
+		if (index >= size_.load(std::memory_order_relaxed))
+		{
+			size_.store(index + 1, std::memory_order_release);
+		}
+	}
+
+	/**
+	 * \brief Frees all segments, which mustn't be read meanwhile.
+	 */
+	void clear()
+	{
+		std::lock_guard<std::mutex> guard(write_lock);
+		for (auto& segment : segments)
+		{
+			delete[] segment.exchange(nullptr, std::memory_order_relaxed);
+		}
+		size_.store(0, std::memory_order_release);
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_SEGMENTED_ARRAY_H
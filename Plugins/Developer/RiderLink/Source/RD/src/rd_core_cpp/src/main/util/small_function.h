@@ -0,0 +1,145 @@
+#ifndef RD_CPP_SMALL_FUNCTION_H
+#define RD_CPP_SMALL_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rd
+{
+namespace util
+{
+template <typename Signature, size_t Capacity = 64>
+class small_function;
+
+/**
+ * \brief Move-only replacement for std::function which keeps callables up to [Capacity] bytes inline.
+ * Bigger or throwing-on-move callables fall back to the heap, so it accepts everything std::function does, including
+ * callables whose result is dropped by a void signature.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class small_function<R(Args...), Capacity>
+{
+	struct vtable_t
+	{
+		R (*invoke)(void* storage, Args&&... args);
+		void (*move)(void* dst, void* src) noexcept;
+		void (*destroy)(void* storage) noexcept;
+	};
+
+	template <typename F>
+	using fits_inline = std::integral_constant<bool, sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+														 std::is_nothrow_move_constructible<F>::value>;
+
+	template <typename F>
+	static vtable_t const* inline_vtable()
+	{
+		static constexpr vtable_t vtable{
+			[](void* storage, Args&&... args) -> R { return static_cast<R>((*static_cast<F*>(storage))(std::forward<Args>(args)...)); },
+			[](void* dst, void* src) noexcept {
+				new (dst) F(std::move(*static_cast<F*>(src)));
+				static_cast<F*>(src)->~F();
+			},
+			[](void* storage) noexcept { static_cast<F*>(storage)->~F(); }};
+		return &vtable;
+	}
+
+	template <typename F>
+	static vtable_t const* heap_vtable()
+	{
+		static constexpr vtable_t vtable{
+			[](void* storage, Args&&... args) -> R { return static_cast<R>((**static_cast<F**>(storage))(std::forward<Args>(args)...)); },
+			[](void* dst, void* src) noexcept { *static_cast<F**>(dst) = *static_cast<F**>(src); },
+			[](void* storage) noexcept { delete *static_cast<F**>(storage); }};
+		return &vtable;
+	}
+
+	alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+	vtable_t const* vtable = nullptr;
+
+	void reset() noexcept
+	{
+		if (vtable != nullptr)
+		{
+			vtable->destroy(storage);
+			vtable = nullptr;
+		}
+	}
+
+public:
+	template <typename F>
+	static constexpr bool is_inline_v = fits_inline<std::decay_t<F>>::value;
+
+	// region ctor/dtor
+
+	small_function() noexcept = default;
+
+	small_function(std::nullptr_t) noexcept
+	{
+	}
+
+	template <typename F, typename Fn = std::decay_t<F>,
+		typename = typename std::enable_if_t<!std::is_same<Fn, small_function>::value>>
+	small_function(F&& f)
+	{
+		if (fits_inline<Fn>::value)
+		{
+			new (storage) Fn(std::forward<F>(f));
+			vtable = inline_vtable<Fn>();
+		}
+		else
+		{
+			*reinterpret_cast<Fn**>(storage) = new Fn(std::forward<F>(f));
+			vtable = heap_vtable<Fn>();
+		}
+	}
+
+	small_function(small_function const&) = delete;
+
+	small_function& operator=(small_function const&) = delete;
+
+	small_function(small_function&& other) noexcept : vtable(other.vtable)
+	{
+		if (vtable != nullptr)
+		{
+			vtable->move(storage, other.storage);
+			other.vtable = nullptr;
+		}
+	}
+
+	small_function& operator=(small_function&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			if (other.vtable != nullptr)
+			{
+				other.vtable->move(storage, other.storage);
+				vtable = other.vtable;
+				other.vtable = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	~small_function()
+	{
+		reset();
+	}
+	// endregion
+
+	explicit operator bool() const noexcept
+	{
+		return vtable != nullptr;
+	}
+
+	R operator()(Args... args) const
+	{
+		return vtable->invoke(storage, std::forward<Args>(args)...);
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_SMALL_FUNCTION_H
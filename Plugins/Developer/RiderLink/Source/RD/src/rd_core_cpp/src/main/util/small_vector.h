@@ -0,0 +1,221 @@
+#ifndef RD_CPP_SMALL_VECTOR_H
+#define RD_CPP_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Contiguous sequence which keeps up to [N] elements inline and moves to the heap when it grows past them.
+ * Only the operations the library needs: appending, indexing and stable removal.
+ */
+template <typename T, size_t N>
+class small_vector
+{
+	static_assert(N > 0, "inline capacity must be positive");
+
+	alignas(T) unsigned char inline_storage[N * sizeof(T)];
+	T* data_ = reinterpret_cast<T*>(inline_storage);
+	size_t size_ = 0;
+	size_t capacity_ = N;
+
+	bool is_inline() const
+	{
+		return data_ == reinterpret_cast<T const*>(inline_storage);
+	}
+
+	void destroy_all() noexcept
+	{
+		for (size_t i = 0; i < size_; ++i)
+		{
+			data_[i].~T();
+		}
+		size_ = 0;
+	}
+
+	void release_heap() noexcept
+	{
+		if (!is_inline())
+		{
+			std::allocator<T>().deallocate(data_, capacity_);
+			data_ = reinterpret_cast<T*>(inline_storage);
+			capacity_ = N;
+		}
+	}
+
+	void grow()
+	{
+		const size_t new_capacity = capacity_ * 2;
+		T* new_data = std::allocator<T>().allocate(new_capacity);
+		for (size_t i = 0; i < size_; ++i)
+		{
+			new (new_data + i) T(std::move_if_noexcept(data_[i]));
+			data_[i].~T();
+		}
+		if (!is_inline())
+		{
+			std::allocator<T>().deallocate(data_, capacity_);
+		}
+		data_ = new_data;
+		capacity_ = new_capacity;
+	}
+
+	void steal(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		if (other.is_inline())
+		{
+			for (size_t i = 0; i < other.size_; ++i)
+			{
+				new (data_ + i) T(std::move(other.data_[i]));
+			}
+			size_ = other.size_;
+			other.destroy_all();
+		}
+		else
+		{
+			data_ = other.data_;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.data_ = reinterpret_cast<T*>(other.inline_storage);
+			other.size_ = 0;
+			other.capacity_ = N;
+		}
+	}
+
+public:
+	// region ctor/dtor
+
+	small_vector() noexcept = default;
+
+	small_vector(small_vector const&) = delete;
+
+	small_vector& operator=(small_vector const&) = delete;
+
+	small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		steal(other);
+	}
+
+	small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		if (this != &other)
+		{
+			destroy_all();
+			release_heap();
+			steal(other);
+		}
+		return *this;
+	}
+
+	~small_vector()
+	{
+		destroy_all();
+		release_heap();
+	}
+	// endregion
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (size_ == capacity_)
+		{
+			grow();
+		}
+		T* element = new (data_ + size_) T(std::forward<Args>(args)...);
+		++size_;
+		return *element;
+	}
+
+	void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	/**
+	 * \brief Removes elements matching [predicate] keeping the order of the rest.
+	 * \return number of removed elements.
+	 */
+	template <typename P>
+	size_t erase_if(P&& predicate)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < size_; ++i)
+		{
+			if (!predicate(data_[i]))
+			{
+				if (kept != i)
+				{
+					data_[kept] = std::move(data_[i]);
+				}
+				++kept;
+			}
+		}
+		const size_t removed = size_ - kept;
+		for (size_t i = kept; i < size_; ++i)
+		{
+			data_[i].~T();
+		}
+		size_ = kept;
+		return removed;
+	}
+
+	void clear() noexcept
+	{
+		destroy_all();
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	size_t capacity() const
+	{
+		return capacity_;
+	}
+
+	bool empty() const
+	{
+		return size_ == 0;
+	}
+
+	T& operator[](size_t index)
+	{
+		return data_[index];
+	}
+
+	T const& operator[](size_t index) const
+	{
+		return data_[index];
+	}
+
+	T* begin()
+	{
+		return data_;
+	}
+
+	T* end()
+	{
+		return data_ + size_;
+	}
+
+	T const* begin() const
+	{
+		return data_;
+	}
+
+	T const* end() const
+	{
+		return data_ + size_;
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_SMALL_VECTOR_H
@@ -7,6 +7,8 @@
 
 #include <rd_framework_export.h>
 
+#include <vector>
+
 namespace rd
 {
 class Identities;
@@ -96,6 +98,22 @@ typename std::enable_if_t<util::is_base_of_v<IRdBindable, T>> inline bindPolymor
 		obj.bind(lf, parent, name);
 	}
 }
+
+/**
+ * \brief Whether [bindPolymorphic] binds values of [T]: collections of values it doesn't bind don't view their elements.
+ */
+template <typename T>
+struct is_bindable : util::bool_constant<util::is_base_of_v<IRdBindable, T>>
+{
+};
+
+template <typename T>
+struct is_bindable<std::vector<T>> : is_bindable<T>
+{
+};
+
+template <typename T>
+constexpr bool is_bindable_v = is_bindable<T>::value;
 }	 // namespace rd
 
 #endif	  // RD_CPP_FRAMEWORK_IRDBINDABLE_H
@@ -1,5 +1,7 @@
 #include "ISerializersOwner.h"
 
+#include "serialization/Serializers.h"
+
 namespace rd
 {
 void ISerializersOwner::registry(Serializers const& serializers) const
@@ -11,5 +13,6 @@ void ISerializersOwner::registry(Serializers const& serializers) const
 	}
 
 	registerSerializersCore(serializers);
+	serializers.build_dispatch();
 }
 }	 // namespace rd
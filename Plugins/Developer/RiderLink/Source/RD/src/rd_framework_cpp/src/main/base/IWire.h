@@ -8,6 +8,7 @@
 
 #include "reactive/base/interfaces.h"
 #include "base/IRdReactive.h"
+#include "base/MessagePriority.h"
 #include "reactive/Property.h"
 
 #include <rd_framework_export.h>
@@ -35,10 +36,28 @@ public:
 	/**
 	 * \brief Sends a data block with the given [id] and the given [writer] function that can write the data.
 	 * \param id of recipient.
-	 * \param writer is used to serialise data before send.
+	 * \param writer is used to serialise data before send. It is called before [send] returns, so it may refer to the
+	 * caller's locals and be passed in [std::ref] not to be copied.
 	 */
 	virtual void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const = 0;
 
+	/**
+	 * \brief Same as [send] with the lane to queue the data block in, wires without lanes ignore [priority].
+	 */
+	virtual void send(RdId const& id, std::function<void(Buffer& buffer)> writer, MessagePriority /*priority*/) const
+	{
+		send(id, std::move(writer));
+	}
+
+	/**
+	 * \brief Whether the counterpart announced it reads changes of a collection sent as one message, see [MessageBatch].
+	 * Wires which negotiate nothing send them one by one.
+	 */
+	virtual bool counterpart_reads_batches() const
+	{
+		return false;
+	}
+
 	/**
 	 * \brief Adds a [handler] for receiving updated values of the object with the given [id]. The handler is removed
 	 * when the given [lifetime] is terminated.
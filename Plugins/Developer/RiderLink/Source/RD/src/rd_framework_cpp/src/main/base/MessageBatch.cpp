@@ -0,0 +1,45 @@
+#include "MessageBatch.h"
+
+#include "base/IWire.h"
+
+#include <functional>
+
+namespace rd
+{
+void MessageBatch::flush(IWire const* wire, RdId const& id, MessagePriority priority,
+	std::function<void(Buffer& buffer, int32_t count)> const& write_header)
+{
+	if (offsets.empty())
+	{
+		return;
+	}
+	auto const* data = buffer.data();
+	const size_t end = buffer.get_position();
+	// the wire calls the writer before send returns, so messages are copied straight from [buffer]
+	if (wire->counterpart_reads_batches())
+	{
+		const auto count = static_cast<int32_t>(offsets.size());
+		auto writer = [&write_header, count, data, end](Buffer& inner) {
+			inner.set_compact(false);
+			write_header(inner, count);
+			inner.write_byte_array_raw(data, end);
+		};
+		wire->send(id, std::ref(writer), priority);
+	}
+	else
+	{
+		for (size_t i = 0; i < offsets.size(); ++i)
+		{
+			const size_t begin = offsets[i];
+			const size_t next = i + 1 < offsets.size() ? offsets[i + 1] : end;
+			auto writer = [data, begin, next](Buffer& inner) {
+				inner.set_compact(false);
+				inner.write_byte_array_raw(data + begin, next - begin);
+			};
+			wire->send(id, std::ref(writer), priority);
+		}
+	}
+	offsets.clear();
+	buffer.rewind();
+}
+}	 // namespace rd
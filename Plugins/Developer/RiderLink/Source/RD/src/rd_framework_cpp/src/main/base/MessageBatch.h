@@ -0,0 +1,107 @@
+#ifndef RD_CPP_MESSAGEBATCH_H
+#define RD_CPP_MESSAGEBATCH_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "base/MessagePriority.h"
+#include "protocol/Buffer.h"
+#include "protocol/RdId.h"
+
+#include <functional>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+// region predeclared
+
+class IWire;
+// endregion
+
+/**
+ * \brief Messages of one entity collected while a batch is open, e.g. by [RdMap::batch]. They are serialized as they
+ * come, because changes point into storage that later changes may free, and sent when the outermost batch closes: as
+ * one message of a header and all of them if the counterpart reads batches, see [IWire::counterpart_reads_batches], as
+ * a message each otherwise. They are written fixed-width, the mode of the message they end up in isn't known yet.
+ * Messages added without a batch open are sent by [flush], as [InternRoot] does with definitions of interned values.
+ */
+class RD_FRAMEWORK_API MessageBatch
+{
+	Buffer buffer;
+	std::vector<size_t> offsets;
+	int32_t depth = 0;
+
+public:
+	// region ctor/dtor
+
+	MessageBatch() = default;
+
+	MessageBatch(MessageBatch&&) = default;
+
+	MessageBatch& operator=(MessageBatch&&) = default;
+	// endregion
+
+	bool is_open() const
+	{
+		return depth > 0;
+	}
+
+	size_t size() const
+	{
+		return offsets.size();
+	}
+
+	/**
+	 * \brief Serializes a message with [writer].
+	 */
+	template <typename F>
+	void add(F&& writer)
+	{
+		offsets.push_back(buffer.get_position());
+		writer(buffer);
+	}
+
+	/**
+	 * \brief Sends the messages added so far to [id], see [run].
+	 */
+	void flush(IWire const* wire, RdId const& id, MessagePriority priority,
+		std::function<void(Buffer& buffer, int32_t count)> const& write_header);
+
+	/**
+	 * \brief Runs [action] in a batch and sends what it collected to [id] once the outermost batch closes, also if
+	 * [action] throws: the changes it made are applied locally either way. Nested batches join the outer one.
+	 * \param write_header writes the header a batch of [count] messages starts with.
+	 */
+	template <typename F, typename H>
+	void run(IWire const* wire, RdId const& id, MessagePriority priority, H&& write_header, F&& action)
+	{
+		++depth;
+		try
+		{
+			action();
+		}
+		catch (...)
+		{
+			if (--depth == 0)
+			{
+				flush(wire, id, priority, write_header);
+			}
+			throw;
+		}
+		if (--depth == 0)
+		{
+			flush(wire, id, priority, write_header);
+		}
+	}
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_MESSAGEBATCH_H
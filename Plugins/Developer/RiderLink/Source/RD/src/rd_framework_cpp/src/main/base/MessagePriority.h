@@ -0,0 +1,31 @@
+#ifndef RD_CPP_MESSAGEPRIORITY_H
+#define RD_CPP_MESSAGEPRIORITY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rd
+{
+/**
+ * \brief Send lane of an entity's messages. Wire control frames (pings and acknowledges) are sent ahead of all of them.
+ *
+ * Messages of one lane keep their order, messages of different lanes may overtake each other, so only entities whose
+ * messages don't depend on each other should be put in different lanes.
+ */
+enum class MessagePriority : uint8_t
+{
+	/**
+	 * \brief Short requests a user waits for, sent before anything else queued.
+	 */
+	Interactive,
+	Normal,
+	/**
+	 * \brief Bulky streams like logs, gets a smaller share of the wire than [Normal].
+	 */
+	Bulk
+};
+
+constexpr size_t MESSAGE_PRIORITY_COUNT = 3;
+}	 // namespace rd
+
+#endif	  // RD_CPP_MESSAGEPRIORITY_H
@@ -5,6 +5,8 @@
 #include "serialization/Polymorphic.h"
 #include "reactive/Property.h"
 
+#include <functional>
+
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 4250)
@@ -78,17 +80,18 @@ public:
 			{
 				master_version++;
 			}
-			get_wire()->send(rdid, [this, &v](Buffer& buffer) {
-				buffer.write_integral<int32_t>(master_version);
+			auto writer = [this, &v](Buffer& buffer) {
+				buffer.write_compact_integral<int32_t>(master_version);
 				S::write(this->get_serialization_context(), buffer, v);
-				spdlog::get("logSend")->trace("SEND property {} + {}:: ver = {}, value = {}", to_string(location), to_string(rdid),
+				RD_LOG_TRACE(logSend, "SEND property {} + {}:: ver = {}, value = {}", to_string(location), to_string(rdid),
 					std::to_string(master_version), to_string(v));
-			});
+			};
+			get_wire()->send(rdid, std::ref(writer), priority);
 		});
 
 		get_wire()->advise(lifetime, this);
 
-		if (!optimize_nested)
+		if (!optimize_nested && is_bindable_v<T>)
 		{
 			this->view(lifetime, [this](Lifetime lf, T const& v) {
 				if (this->has_value())
@@ -101,11 +104,11 @@ public:
 
 	void on_wire_received(Buffer buffer) const override
 	{
-		int32_t version = buffer.read_integral<int32_t>();
+		int32_t version = buffer.read_compact_integral<int32_t>();
 		WT v = S::read(this->get_serialization_context(), buffer);
 
 		bool rejected = is_master && version < master_version;
-		spdlog::get("logSend")->trace("RECV property {} {}:: oldver={}, ver={}, value = {}{}", to_string(location), to_string(rdid),
+		RD_LOG_TRACE(logSend, "RECV property {} {}:: oldver={}, ver={}, value = {}{}", to_string(location), to_string(rdid),
 			master_version, version, to_string(v), (rejected ? ">> REJECTED" : ""));
 		if (rejected)
 		{
@@ -4,19 +4,21 @@
 
 namespace rd
 {
-static std::shared_ptr<spdlog::logger> logReceived =
+std::shared_ptr<spdlog::logger> RdReactiveBase::logReceived =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("logReceived", spdlog::color_mode::automatic);
-std::shared_ptr<spdlog::logger> logSend =
+std::shared_ptr<spdlog::logger> RdReactiveBase::logSend =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("logSend", spdlog::color_mode::automatic);
 
 RdReactiveBase::RdReactiveBase(RdReactiveBase&& other) : RdBindableBase(std::move(other)) /*, async(other.async)*/
 {
 	async = other.async;
+	priority = other.priority;
 }
 
 RdReactiveBase& RdReactiveBase::operator=(RdReactiveBase&& other)
 {
 	async = other.async;
+	priority = other.priority;
 	static_cast<RdBindableBase&>(*this) = std::move(other);
 	return *this;
 }
@@ -3,7 +3,9 @@
 
 #include "base/RdBindableBase.h"
 #include "base/IRdReactive.h"
+#include "base/MessagePriority.h"
 #include "guards.h"
+#include "util/trace.h"
 
 #include "spdlog/spdlog.h"
 
@@ -39,10 +41,24 @@ public:
 	virtual ~RdReactiveBase() = default;
 	// endregion
 
+	/**
+	 * \brief Loggers of protocol messages named "logSend" and "logReceived", held here so entities don't look them up
+	 * in the spdlog registry per message.
+	 */
+	static std::shared_ptr<spdlog::logger> logSend;
+
+	static std::shared_ptr<spdlog::logger> logReceived;
+
 	const IWire* get_wire() const;
 
 	mutable bool is_local_change = false;
 
+	/**
+	 * \brief Wire lane of this entity's messages. Mutable, so that it can be set on the const entities a generated
+	 * model exposes before the model is bound.
+	 */
+	mutable MessagePriority priority = MessagePriority::Normal;
+
 	// delegated
 
 	const Serializers& get_serializers() const;
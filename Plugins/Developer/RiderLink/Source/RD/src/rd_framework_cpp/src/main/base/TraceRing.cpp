@@ -0,0 +1,174 @@
+#include "TraceRing.h"
+
+#include "util/core_util.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace rd
+{
+namespace
+{
+template <typename T>
+void write_integral(std::ofstream& out, T value)
+{
+	out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_integral(std::ifstream& in, T& value)
+{
+	return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+char const* to_string(TraceRing::Op op)
+{
+	switch (op)
+	{
+		case TraceRing::Op::Send:
+			return "send";
+		case TraceRing::Op::Receive:
+			return "receive";
+	}
+	return "unknown";
+}
+}	 // namespace
+
+constexpr uint32_t TraceRing::MAGIC;
+constexpr uint32_t TraceRing::VERSION;
+
+void TraceRing::start(size_t capacity)
+{
+	if (!slots)
+	{
+		size_t size = 1;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+		slots.reset(new Slot[size]);
+		mask = size - 1;
+		start_time = std::chrono::steady_clock::now();
+	}
+	enabled.store(true, std::memory_order_release);
+}
+
+void TraceRing::stop()
+{
+	enabled.store(false, std::memory_order_release);
+}
+
+void TraceRing::record(RdId const& id, Op op, size_t size)
+{
+	if (!is_enabled())
+	{
+		return;
+	}
+	const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time);
+	const uint64_t index = next.fetch_add(1, std::memory_order_relaxed);
+	auto& slot = slots[index & mask];
+	slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.timestamp.store(timestamp.count(), std::memory_order_relaxed);
+	slot.id.store(id.get_hash(), std::memory_order_relaxed);
+	slot.size.store(static_cast<uint32_t>(size), std::memory_order_relaxed);
+	slot.op.store(static_cast<uint8_t>(op), std::memory_order_relaxed);
+	slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+std::vector<TraceRing::Record> TraceRing::snapshot() const
+{
+	std::vector<Record> result;
+	if (!slots)
+	{
+		return result;
+	}
+	const uint64_t end = next.load(std::memory_order_acquire);
+	const uint64_t begin = end > mask + 1 ? end - (mask + 1) : 0;
+	result.reserve(static_cast<size_t>(end - begin));
+	for (uint64_t index = begin; index < end; ++index)
+	{
+		auto const& slot = slots[index & mask];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != 2 * index + 2)
+		{
+			continue;
+		}
+		Record record;
+		record.timestamp = std::chrono::nanoseconds(slot.timestamp.load(std::memory_order_relaxed));
+		record.id = RdId(slot.id.load(std::memory_order_relaxed));
+		record.size = slot.size.load(std::memory_order_relaxed);
+		record.op = static_cast<Op>(slot.op.load(std::memory_order_relaxed));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+		{
+			result.push_back(record);
+		}
+	}
+	return result;
+}
+
+bool TraceRing::save(std::string const& path) const
+{
+	const auto records = snapshot();
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out.is_open())
+	{
+		return false;
+	}
+	write_integral(out, MAGIC);
+	write_integral(out, VERSION);
+	write_integral(out, static_cast<uint32_t>(records.size()));
+	for (auto const& record : records)
+	{
+		write_integral(out, static_cast<int64_t>(record.timestamp.count()));
+		write_integral(out, record.id.get_hash());
+		write_integral(out, static_cast<uint8_t>(record.op));
+		write_integral(out, record.size);
+	}
+	out.flush();
+	return static_cast<bool>(out);
+}
+
+std::vector<TraceRing::Record> TraceRing::load(std::string const& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	RD_ASSERT_THROW_MSG(in.is_open(), "failed to open trace file: " + path);
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t count = 0;
+	RD_ASSERT_THROW_MSG(read_integral(in, magic) && magic == MAGIC, "not a trace file: " + path);
+	RD_ASSERT_THROW_MSG(read_integral(in, version) && version == VERSION,
+		"unsupported trace version " + std::to_string(version) + ": " + path);
+	RD_ASSERT_THROW_MSG(read_integral(in, count), "truncated trace file: " + path);
+
+	std::vector<Record> result;
+	result.reserve(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		int64_t timestamp = 0;
+		RdId::hash_t id = 0;
+		uint8_t op = 0;
+		uint32_t size = 0;
+		if (!read_integral(in, timestamp) || !read_integral(in, id) || !read_integral(in, op) || !read_integral(in, size))
+		{
+			break;
+		}
+		result.push_back(Record{std::chrono::nanoseconds(timestamp), RdId(id), static_cast<Op>(op), size});
+	}
+	return result;
+}
+
+std::string TraceRing::format(std::vector<Record> const& records)
+{
+	std::string result;
+	char line[128];
+	for (auto const& record : records)
+	{
+		std::snprintf(line, sizeof(line), "%.6f ms %s %lld %u B\n", static_cast<double>(record.timestamp.count()) / 1e6,
+			to_string(record.op), static_cast<long long>(record.id.get_hash()), record.size);
+		result += line;
+	}
+	return result;
+}
+}	 // namespace rd
@@ -0,0 +1,125 @@
+#ifndef RD_CPP_TRACERING_H
+#define RD_CPP_TRACERING_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "protocol/RdId.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Fixed-size in-memory log of the messages passed through a wire: when, which entity, which way and how many
+ * bytes. Recording is a few relaxed stores into a preallocated slot, without locks or formatting, so it can stay on
+ * while the problem it should explain is reproduced. The newest [capacity] records are kept.
+ *
+ * [save] writes them to a file decoded offline with [load] and [format]: the magic "RDTR", the format version and the
+ * record count (uint32 each), followed by records of nanoseconds since [start] (int64), RdId (int64), op (uint8) and
+ * size (uint32).
+ */
+class RD_FRAMEWORK_API TraceRing
+{
+public:
+	enum class Op : uint8_t
+	{
+		Send = 0,
+		Receive = 1
+	};
+
+	struct Record
+	{
+		std::chrono::nanoseconds timestamp{0};
+		RdId id = RdId::Null();
+		Op op = Op::Send;
+		uint32_t size = 0;
+	};
+
+	static constexpr uint32_t MAGIC = 0x52544452;	 // "RDTR"
+	static constexpr uint32_t VERSION = 1;
+
+private:
+	/**
+	 * \brief Fields are written by the producer holding the slot's index and read concurrently by [snapshot],
+	 * [sequence] tells whether they belong together: 2 * index + 1 while written, 2 * index + 2 once complete.
+	 */
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence{0};
+		std::atomic<int64_t> timestamp{0};
+		std::atomic<RdId::hash_t> id{0};
+		std::atomic<uint32_t> size{0};
+		std::atomic<uint8_t> op{0};
+	};
+
+	std::atomic<bool> enabled{false};
+	std::atomic<uint64_t> next{0};
+	std::unique_ptr<Slot[]> slots;
+	uint64_t mask = 0;
+	std::chrono::steady_clock::time_point start_time;
+
+public:
+	// region ctor/dtor
+
+	TraceRing() = default;
+
+	TraceRing(TraceRing const&) = delete;
+
+	TraceRing& operator=(TraceRing const&) = delete;
+	// endregion
+
+	/**
+	 * \brief Allocates [capacity] records, rounded up to a power of two, and starts recording. Must not race with
+	 * [record]. Once allocated the ring is reused by later starts, which keep its capacity and records.
+	 */
+	void start(size_t capacity);
+
+	/**
+	 * \brief Stops recording, the records stay until the next [start].
+	 */
+	void stop();
+
+	bool is_enabled() const
+	{
+		return enabled.load(std::memory_order_acquire);
+	}
+
+	void record(RdId const& id, Op op, size_t size);
+
+	/**
+	 * \return complete records, oldest first. Records overwritten or being written meanwhile are skipped.
+	 */
+	std::vector<Record> snapshot() const;
+
+	/**
+	 * \brief Writes [snapshot] to [path].
+	 * \return false if the file couldn't be written, it's meant to be called on teardown where nothing should throw.
+	 */
+	bool save(std::string const& path) const;
+
+	/**
+	 * \brief Reads records written by [save], throws if [path] isn't a trace of this version.
+	 */
+	static std::vector<Record> load(std::string const& path);
+
+	/**
+	 * \brief One line per record: milliseconds since start, op, entity and size.
+	 */
+	static std::string format(std::vector<Record> const& records);
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_TRACERING_H
@@ -1,9 +1,47 @@
 #include "WireBase.h"
 
+#include "scheduler/TimerWheel.h"
+
 namespace rd
 {
 void WireBase::advise(Lifetime lifetime, const IRdReactive* entity) const
 {
 	message_broker.advise_on(lifetime, entity);
 }
+
+void WireBase::set_metrics_enabled(bool enabled)
+{
+	metrics.set_enabled(enabled);
+}
+
+WireMetrics& WireBase::get_metrics() const
+{
+	return metrics;
+}
+
+WireMetrics::Snapshot WireBase::get_metrics_snapshot() const
+{
+	auto result = metrics.snapshot();
+	if (scheduler != nullptr)
+	{
+		result.schedulers.insert(result.schedulers.begin(), WireMetrics::SchedulerStats{"wire", scheduler->get_queue_depth()});
+	}
+	return result;
+}
+
+void WireBase::start_metrics_dump(Lifetime lifetime, std::chrono::milliseconds interval, std::string name) const
+{
+	TimerWheel::Instance().schedule_periodic(
+		lifetime, interval, [this, name = std::move(name)] { WireMetrics::dump(name, get_metrics_snapshot()); });
+}
+
+void WireBase::start_trace(size_t capacity)
+{
+	trace_ring.start(capacity);
+}
+
+TraceRing& WireBase::get_trace_ring() const
+{
+	return trace_ring;
+}
 }	 // namespace rd
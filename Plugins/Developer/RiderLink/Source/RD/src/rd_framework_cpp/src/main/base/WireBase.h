@@ -3,8 +3,12 @@
 
 #include "reactive/Property.h"
 #include "base/IWire.h"
+#include "base/TraceRing.h"
+#include "base/WireMetrics.h"
 #include "protocol/MessageBroker.h"
 
+#include <chrono>
+
 #include <rd_framework_export.h>
 
 namespace rd
@@ -14,11 +18,15 @@ class RD_FRAMEWORK_API WireBase : public IWire
 protected:
 	IScheduler* scheduler = nullptr;
 
+	mutable WireMetrics metrics;
+
+	mutable TraceRing trace_ring;
+
 	MessageBroker message_broker;
 
 public:
 	// region ctor/dtor
-	explicit WireBase(IScheduler* scheduler) : scheduler(scheduler), message_broker(scheduler)
+	explicit WireBase(IScheduler* scheduler) : scheduler(scheduler), message_broker(scheduler, &metrics, &trace_ring)
 	{
 	}
 
@@ -26,6 +34,32 @@ public:
 	// endregion
 
 	void advise(Lifetime lifetime, IRdReactive const* entity) const override;
+
+	/**
+	 * \brief Starts counting messages of this wire. Entities advised before the call are named after their first
+	 * incoming message.
+	 */
+	void set_metrics_enabled(bool enabled);
+
+	WireMetrics& get_metrics() const;
+
+	/**
+	 * \brief Counters of [get_metrics] with the queue depth of the wire scheduler.
+	 */
+	virtual WireMetrics::Snapshot get_metrics_snapshot() const;
+
+	/**
+	 * \brief Writes [get_metrics_snapshot] to the rd log under [name] every [interval] until [lifetime], which must not
+	 * outlive the wire, terminates.
+	 */
+	void start_metrics_dump(Lifetime lifetime, std::chrono::milliseconds interval, std::string name) const;
+
+	/**
+	 * \brief Starts recording messages of this wire into a ring of [capacity] records, see [TraceRing].
+	 */
+	void start_trace(size_t capacity);
+
+	TraceRing& get_trace_ring() const;
 };
 }	 // namespace rd
 
@@ -0,0 +1,178 @@
+#include "WireMetrics.h"
+
+#include "base/IRdReactive.h"
+#include "scheduler/base/IScheduler.h"
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace rd
+{
+std::shared_ptr<spdlog::logger> WireMetrics::logger =
+	spdlog::stderr_color_mt<spdlog::synchronous_factory>("wireMetricsLog", spdlog::color_mode::automatic);
+
+constexpr size_t WireMetrics::SHARDS;
+
+WireMetrics::Shard& WireMetrics::shard_of(RdId const& id) const
+{
+	// same scrambling as MessageBroker's subscription table, ids are mixed with a small factor
+	auto h = static_cast<uint64_t>(id.get_hash());
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return shards[h & (SHARDS - 1)];
+}
+
+void WireMetrics::set_enabled(bool value)
+{
+	enabled.store(value, std::memory_order_relaxed);
+}
+
+void WireMetrics::record_message(RdId const& id, Direction direction, size_t bytes, IRdReactive const* entity)
+{
+	if (!is_enabled())
+	{
+		return;
+	}
+	auto& shard = shard_of(id);
+	std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+	auto& stats = shard.entities[id];
+	stats.id = id;
+	if (entity != nullptr && stats.location.empty())
+	{
+		stats.location = to_string(entity->get_location());
+	}
+	const auto index = static_cast<size_t>(direction);
+	++stats.messages[index];
+	stats.bytes[index] += static_cast<int64_t>(bytes);
+}
+
+void WireMetrics::record_dispatch(RdId const& id, util::latency_histogram::duration_t latency)
+{
+	auto& shard = shard_of(id);
+	std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+	auto it = shard.entities.find(id);
+	if (it != shard.entities.end())
+	{
+		it->second.dispatch_latency.record(latency);
+	}
+}
+
+void WireMetrics::set_location(RdId const& id, std::string location)
+{
+	auto& shard = shard_of(id);
+	std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+	auto& stats = shard.entities[id];
+	stats.id = id;
+	stats.location = std::move(location);
+}
+
+void WireMetrics::remove(RdId const& id)
+{
+	auto& shard = shard_of(id);
+	std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+	shard.entities.erase(id);
+}
+
+void WireMetrics::add_scheduler(Lifetime lifetime, std::string name, IScheduler const* scheduler)
+{
+	{
+		std::lock_guard<decltype(schedulers_lock)> guard(schedulers_lock);
+		schedulers.emplace_back(std::move(name), scheduler);
+	}
+	lifetime->add_action([this, scheduler] {
+		std::lock_guard<decltype(schedulers_lock)> guard(schedulers_lock);
+		schedulers.erase(std::remove_if(schedulers.begin(), schedulers.end(),
+							 [scheduler](std::pair<std::string, IScheduler const*> const& it) { return it.second == scheduler; }),
+			schedulers.end());
+	});
+}
+
+WireMetrics::Snapshot WireMetrics::snapshot() const
+{
+	Snapshot result;
+	for (auto& shard : shards)
+	{
+		std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+		for (auto const& it : shard.entities)
+		{
+			// entries made by set_location alone have nothing to report
+			if (it.second.messages[0] + it.second.messages[1] != 0)
+			{
+				result.entities.push_back(it.second);
+			}
+		}
+	}
+	std::sort(result.entities.begin(), result.entities.end(),
+		[](EntityStats const& l, EntityStats const& r) { return l.total_bytes() > r.total_bytes(); });
+	{
+		std::lock_guard<decltype(schedulers_lock)> guard(schedulers_lock);
+		for (auto const& it : schedulers)
+		{
+			result.schedulers.push_back({it.first, it.second->get_queue_depth()});
+		}
+	}
+	return result;
+}
+
+void WireMetrics::reset()
+{
+	for (auto& shard : shards)
+	{
+		std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+		for (auto& it : shard.entities)
+		{
+			auto& stats = it.second;
+			stats.messages = {};
+			stats.bytes = {};
+			stats.dispatch_latency = util::latency_histogram{};
+		}
+	}
+}
+
+std::string WireMetrics::format(Snapshot const& snapshot, size_t top)
+{
+	using std::chrono::microseconds;
+	const auto us = [](util::latency_histogram::duration_t duration) {
+		return static_cast<long long>(std::chrono::duration_cast<microseconds>(duration).count());
+	};
+
+	std::string result;
+	char line[512];
+	std::snprintf(line, sizeof(line), "%zu entities, ack rtt: %lld acks, mean %lld us, p99 %lld us, max %lld us",
+		snapshot.entities.size(), static_cast<long long>(snapshot.ack_rtt.count()), us(snapshot.ack_rtt.mean()),
+		us(snapshot.ack_rtt.percentile(0.99)), us(snapshot.ack_rtt.max()));
+	result += line;
+	for (auto const& scheduler : snapshot.schedulers)
+	{
+		std::snprintf(line, sizeof(line), "\n  scheduler %s: %lld queued", scheduler.name.c_str(),
+			static_cast<long long>(scheduler.queue_depth));
+		result += line;
+	}
+	for (size_t i = 0; i < snapshot.entities.size() && i < top; ++i)
+	{
+		auto const& stats = snapshot.entities[i];
+		const std::string name = stats.location.empty() ? to_string(stats.id) : stats.location;
+		std::snprintf(line, sizeof(line),
+			"\n  %s: in %lld msgs / %lld B, out %lld msgs / %lld B, dispatch mean %lld us, p99 %lld us, max %lld us",
+			name.c_str(), static_cast<long long>(stats.messages[0]), static_cast<long long>(stats.bytes[0]),
+			static_cast<long long>(stats.messages[1]), static_cast<long long>(stats.bytes[1]), us(stats.dispatch_latency.mean()),
+			us(stats.dispatch_latency.percentile(0.99)), us(stats.dispatch_latency.max()));
+		result += line;
+	}
+	return result;
+}
+
+void WireMetrics::dump(std::string const& wire_id, Snapshot const& snapshot)
+{
+	// dumps are asked for explicitly, so they are logged at a level which passes, unless the log is switched off
+	const auto level = std::max(logger->level(), spdlog::level::info);
+	if (level == spdlog::level::off)
+	{
+		return;
+	}
+	logger->log(level, "{}: {}", wire_id, format(snapshot));
+}
+}	 // namespace rd
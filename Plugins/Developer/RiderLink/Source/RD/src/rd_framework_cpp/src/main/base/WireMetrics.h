@@ -0,0 +1,172 @@
+#ifndef RD_CPP_WIREMETRICS_H
+#define RD_CPP_WIREMETRICS_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#pragma warning(disable:4324)
+#endif
+
+#include "lifetime/Lifetime.h"
+#include "protocol/RdId.h"
+#include "util/latency_histogram.h"
+
+#include "std/unordered_map.h"
+
+#include "spdlog/spdlog.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+// region predeclared
+
+class IRdReactive;
+class IScheduler;
+// endregion
+
+/**
+ * \brief Traffic counters of a wire: messages and bytes per entity and direction, time from receiving a message till
+ * its handler returns, and queue depths of the schedulers involved.
+ *
+ * Disabled by default, a disabled instance costs one relaxed load per message.
+ */
+class RD_FRAMEWORK_API WireMetrics
+{
+public:
+	enum class Direction : uint8_t
+	{
+		Incoming,
+		Outgoing
+	};
+
+	struct EntityStats
+	{
+		RdId id;
+		/**
+		 * \brief Location of the entity the messages were dispatched to, empty if the wire never saw it.
+		 */
+		std::string location;
+		std::array<int64_t, 2> messages{};
+		/**
+		 * \brief Payload bytes: context and the entity's data, without the length and the id.
+		 */
+		std::array<int64_t, 2> bytes{};
+		util::latency_histogram dispatch_latency;
+
+		int64_t total_bytes() const
+		{
+			return bytes[0] + bytes[1];
+		}
+	};
+
+	struct SchedulerStats
+	{
+		std::string name;
+		int64_t queue_depth = 0;
+	};
+
+	struct Snapshot
+	{
+		/**
+		 * \brief Busiest entities first.
+		 */
+		std::vector<EntityStats> entities;
+		std::vector<SchedulerStats> schedulers;
+		/**
+		 * \brief Time from sending a package till the counterpart's acknowledge of it, if the wire tracks that.
+		 */
+		util::latency_histogram ack_rtt;
+	};
+
+private:
+	static constexpr size_t SHARDS = 16;
+
+	struct alignas(64) Shard
+	{
+		std::mutex lock;
+		rd::unordered_map<RdId, EntityStats> entities;
+	};
+
+	static std::shared_ptr<spdlog::logger> logger;
+
+	std::atomic<bool> enabled{false};
+	mutable std::array<Shard, SHARDS> shards;
+
+	mutable std::mutex schedulers_lock;
+	std::vector<std::pair<std::string, IScheduler const*>> schedulers;
+
+	Shard& shard_of(RdId const& id) const;
+
+public:
+	// region ctor/dtor
+
+	WireMetrics() = default;
+
+	WireMetrics(WireMetrics const&) = delete;
+
+	WireMetrics& operator=(WireMetrics const&) = delete;
+	// endregion
+
+	void set_enabled(bool value);
+
+	bool is_enabled() const
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Counts a message of [bytes] bytes, [entity] names the entry if it's the first message of [id].
+	 */
+	void record_message(RdId const& id, Direction direction, size_t bytes, IRdReactive const* entity = nullptr);
+
+	/**
+	 * \brief Adds [latency] of a message counted by [record_message] to the counters of [id], unless [remove] dropped
+	 * them meanwhile.
+	 */
+	void record_dispatch(RdId const& id, util::latency_histogram::duration_t latency);
+
+	void set_location(RdId const& id, std::string location);
+
+	/**
+	 * \brief Drops the counters of [id], called when its entity is unbound so that entities which come and go don't
+	 * pile up entries.
+	 */
+	void remove(RdId const& id);
+
+	/**
+	 * \brief Reports queue depth of [scheduler] in snapshots until [lifetime] terminates.
+	 */
+	void add_scheduler(Lifetime lifetime, std::string name, IScheduler const* scheduler);
+
+	Snapshot snapshot() const;
+
+	/**
+	 * \brief Zeroes the counters, entity locations are kept.
+	 */
+	void reset();
+
+	/**
+	 * \brief Human readable summary of [snapshot] with [top] busiest entities, one line per entity.
+	 */
+	static std::string format(Snapshot const& snapshot, size_t top = 10);
+
+	/**
+	 * \brief Writes [format] of [snapshot] to the metrics log at info level, or at the level the log is set to if it's
+	 * higher, so that the dump isn't filtered out.
+	 */
+	static void dump(std::string const& wire_id, Snapshot const& snapshot);
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_WIREMETRICS_H
@@ -21,7 +21,13 @@ ExtWire::ExtWire()
 					auto it = std::move(sendQ.front());
 					sendQ.pop();
 					realWire->send(
-						it.first, [payload = std::move(it.second)](Buffer& buffer) { buffer.write_byte_array_raw(payload); });
+						std::get<0>(it),
+						[payload = std::move(std::get<1>(it))](Buffer& buffer) {
+							// queued before the real wire negotiated anything
+							buffer.set_compact(false);
+							buffer.write_byte_array_raw(payload);
+						},
+						std::get<2>(it));
 				}
 			}
 		}
@@ -34,6 +40,11 @@ void ExtWire::advise(Lifetime lifetime, IRdReactive const* entity) const
 }
 
 void ExtWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer) const
+{
+	send(id, std::move(writer), MessagePriority::Normal);
+}
+
+void ExtWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer, MessagePriority priority) const
 {
 	{
 		std::lock_guard<decltype(lock)> guard(lock);
@@ -41,10 +52,16 @@ void ExtWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer) c
 		{
 			Buffer buffer;
 			writer(buffer);
-			sendQ.emplace(id, buffer.getRealArray());
+			sendQ.emplace(id, buffer.getRealArray(), priority);
 			return;
 		}
 	}
-	realWire->send(id, std::move(writer));
+	realWire->send(id, std::move(writer), priority);
+}
+
+bool ExtWire::counterpart_reads_batches() const
+{
+	// messages queued meanwhile go to the same counterpart once it's connected
+	return realWire != nullptr && realWire->counterpart_reads_batches();
 }
 }	 // namespace rd
@@ -11,6 +11,7 @@
 #include "protocol/Buffer.h"
 
 #include <queue>
+#include <tuple>
 #include <mutex>
 #include <functional>
 
@@ -22,7 +23,7 @@ class RD_FRAMEWORK_API ExtWire final : public IWire
 {
 	mutable std::mutex lock;
 
-	mutable std::queue<std::pair<RdId, Buffer::ByteArray> > sendQ;
+	mutable std::queue<std::tuple<RdId, Buffer::ByteArray, MessagePriority> > sendQ;
 
 public:
 	ExtWire();
@@ -32,6 +33,10 @@ public:
 	void advise(Lifetime lifetime, IRdReactive const* entity) const override;
 
 	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override;
+
+	void send(RdId const& id, std::function<void(Buffer& buffer)> writer, MessagePriority priority) const override;
+
+	bool counterpart_reads_batches() const override;
 };
 }	 // namespace rd
 #if defined(_MSC_VER)
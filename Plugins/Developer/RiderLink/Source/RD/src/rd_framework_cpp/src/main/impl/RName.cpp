@@ -8,7 +8,7 @@ class RNameImpl
 {
 public:
 	// region ctor/dtor
-	RNameImpl(RName parent, string_view localName, string_view separator);
+	RNameImpl(RName const& parent, string_view localName, string_view separator);
 
 	RNameImpl(const RName& other) = delete;
 	RNameImpl(RName&& other) noexcept = delete;
@@ -16,20 +16,28 @@ public:
 	RNameImpl& operator=(RNameImpl&& other) noexcept = delete;
 	// endregion
 
-	friend std::string to_string(RNameImpl const& value);
-
-private:
-	RName parent;
-	std::string local_name, separator;
+	/**
+	 * \brief The whole path, rendered from the parent's when the node is created. Nodes don't keep their parents.
+	 */
+	std::string rendered;
+	size_t hash;
 };
 
-RNameImpl::RNameImpl(RName parent, string_view localName, string_view separator)
-	: parent(parent), local_name(localName), separator(separator)
+RNameImpl::RNameImpl(RName const& parent, string_view localName, string_view separator)
 {
+	auto const& prefix = to_string(parent);
+	rendered.reserve(prefix.size() + separator.size() + localName.size());
+	if (parent)
+	{
+		rendered += prefix;
+		rendered.append(separator.data(), separator.size());
+	}
+	rendered.append(localName.data(), localName.size());
+	hash = std::hash<std::string>()(rendered);
 }
 
 RName::RName(RName parent, string_view localName, string_view separator)
-	: impl(std::make_shared<RNameImpl>(std::move(parent), localName, separator))
+	: impl(std::make_shared<RNameImpl>(parent, localName, separator))
 {
 }
 
@@ -38,27 +46,28 @@ RName RName::sub(string_view localName, string_view separator) const
 	return RName(*this, localName, separator);
 }
 
-std::string to_string(RName const& value)
+size_t RName::get_hash() const
 {
-	std::string res;
-	if (value.impl)
-	{
-		res = to_string(*value.impl);
-	}
-	return res;
+	return impl ? impl->hash : 0;
 }
 
-std::string to_string(RNameImpl const& value)
+std::string const& to_string(RName const& value)
 {
-	if (value.parent)
+	static const std::string empty;
+	return value.impl ? value.impl->rendered : empty;
+}
+
+bool operator==(RName const& left, RName const& right)
+{
+	if (left.impl == right.impl)
+	{
+		return true;
+	}
+	if (!left.impl || !right.impl)
 	{
-		std::string res;
-		res = to_string(value.parent);
-		res += value.separator;
-		res += value.local_name;
-		return res;
+		return false;
 	}
-	return value.local_name;
+	return left.impl->hash == right.impl->hash && left.impl->rendered == right.impl->rendered;
 }
 
 RName::RName(string_view local_name) : RName(RName(), local_name, "")
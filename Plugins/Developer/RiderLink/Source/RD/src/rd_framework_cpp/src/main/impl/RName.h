@@ -8,6 +8,9 @@
 
 #include "thirdparty.hpp"
 
+#include <std/hash.h>
+
+#include <memory>
 #include <string>
 #include <rd_framework_export.h>
 
@@ -17,6 +20,8 @@ class RNameImpl;
 
 /**
  * \brief Recursive name. For constructs like Aaaa.Bbb::CCC
+ *
+ * Each node is rendered and hashed once when created, so [to_string], comparison and hashing don't walk the chain.
  */
 class RD_FRAMEWORK_API RName
 {
@@ -45,11 +50,32 @@ public:
 		return impl != nullptr;
 	}
 
-	friend std::string RD_FRAMEWORK_API to_string(RName const& value);
+	size_t get_hash() const;
+
+	/**
+	 * \return the rendered name, valid as long as [value] is alive and not reassigned.
+	 */
+	friend std::string const& RD_FRAMEWORK_API to_string(RName const& value);
+
+	friend bool RD_FRAMEWORK_API operator==(RName const& left, RName const& right);
+
+	friend bool operator!=(RName const& left, RName const& right)
+	{
+		return !(left == right);
+	}
 
 private:
 	std::shared_ptr<RNameImpl> impl;
 };
+
+template <>
+struct hash<RName>
+{
+	size_t operator()(RName const& value) const noexcept
+	{
+		return value.get_hash();
+	}
+};
 }	 // namespace rd
 #if defined(_MSC_VER)
 #pragma warning(pop)
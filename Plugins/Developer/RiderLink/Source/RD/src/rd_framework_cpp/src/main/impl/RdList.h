@@ -3,9 +3,12 @@
 
 #include "reactive/ViewableList.h"
 #include "base/RdReactiveBase.h"
+#include "base/MessageBatch.h"
 #include "serialization/Polymorphic.h"
 #include "std/allocator.h"
 
+#include <functional>
+
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 4250)
@@ -29,6 +32,7 @@ private:
 	//		mutable ViewableList<T> list;
 	using list = ViewableList<T>;
 	mutable int64_t next_version = 1;
+	mutable MessageBatch message_batch;
 
 	std::string logmsg(Op op, int64_t version, int32_t key, T const* value = nullptr) const
 	{
@@ -55,7 +59,7 @@ public:
 	static RdList<T, S> read(SerializationCtx& /*ctx*/, Buffer& buffer)
 	{
 		RdList<T, S> result;
-		int64_t next_version = buffer.read_integral<int64_t>();
+		int64_t next_version = buffer.read_compact_integral<int64_t>();
 		RdId id = RdId::read(buffer);
 
 		result.next_version = next_version;
@@ -65,7 +69,7 @@ public:
 
 	void write(SerializationCtx& /*ctx*/, Buffer& buffer) const override
 	{
-		buffer.write_integral<int64_t>(next_version);
+		buffer.write_compact_integral<int64_t>(next_version);
 		rdid.write(buffer);
 	}
 
@@ -93,25 +97,33 @@ public:
 					}
 				}
 
-				get_wire()->send(rdid, [this, e](Buffer& buffer) {
+				auto writer = [this, &e](Buffer& buffer) {
 					Op op = static_cast<Op>(e.v.index());
 
-					buffer.write_integral<int64_t>(static_cast<int64_t>(op) | (next_version++ << versionedFlagShift));
-					buffer.write_integral<int32_t>(static_cast<const int32_t>(e.get_index()));
+					buffer.write_compact_integral<int64_t>(static_cast<int64_t>(op) | (next_version++ << versionedFlagShift));
+					buffer.write_compact_integral<int32_t>(static_cast<const int32_t>(e.get_index()));
 
 					T const* new_value = e.get_new_value();
 					if (new_value)
 					{
 						S::write(this->get_serialization_context(), buffer, *new_value);
 					}
-					spdlog::get("logSend")->trace(logmsg(op, next_version - 1, e.get_index(), new_value));
-				});
+					RD_LOG_TRACE(logSend, logmsg(op, next_version - 1, e.get_index(), new_value));
+				};
+				if (message_batch.is_open())
+				{
+					message_batch.add(writer);
+				}
+				else
+				{
+					get_wire()->send(rdid, std::ref(writer), priority);
+				}
 			});
 		});
 
 		get_wire()->advise(lifetime, this);
 
-		if (!optimize_nested)
+		if (!optimize_nested && is_bindable_v<T>)
 		{
 			this->view(lifetime, [this](Lifetime lf, size_t index, T const& value) {
 				bindPolymorphic(value, lf, this, "[" + std::to_string(index) + "]");
@@ -121,10 +133,28 @@ public:
 
 	void on_wire_received(Buffer buffer) const override
 	{
-		int64_t header = (buffer.read_integral<int64_t>());
+		int64_t header = (buffer.read_compact_integral<int64_t>());
+		if (header == static_cast<int64_t>(Op::ACK))
+		{
+			// lists aren't acknowledged, so this header introduces a batch: the number of changes followed by them
+			int32_t count = buffer.read_compact_integral<int32_t>();
+			RD_LOG_TRACE(logReceived, "list {} {}:: batch of {}", to_string(location), to_string(rdid), count);
+			// one event per change, indices in a list event are valid only before the next change
+			for (int32_t i = 0; i < count; ++i)
+			{
+				receive(buffer.read_compact_integral<int64_t>(), buffer);
+			}
+			return;
+		}
+		receive(header, buffer);
+	}
+
+private:
+	void receive(int64_t header, Buffer& buffer) const
+	{
 		int64_t version = header >> versionedFlagShift;
 		Op op = static_cast<Op>((header & ((1 << versionedFlagShift) - 1L)));
-		int32_t index = (buffer.read_integral<int32_t>());
+		int32_t index = (buffer.read_compact_integral<int32_t>());
 
 		RD_ASSERT_MSG(version == next_version,
 			("Version conflict for " + to_string(location) + "}. Expected version " + std::to_string(next_version) + ", received " +
@@ -138,7 +168,7 @@ public:
 			{
 				auto value = S::read(this->get_serialization_context(), buffer);
 
-				spdlog::get("logReceived")->trace(logmsg(op, version, index, &(wrapper::get<T>(value))));
+				RD_LOG_TRACE(logReceived, logmsg(op, version, index, &(wrapper::get<T>(value))));
 
 				(index < 0) ? list::add(std::move(value)) : list::add(static_cast<size_t>(index), std::move(value));
 				break;
@@ -147,14 +177,14 @@ public:
 			{
 				auto value = S::read(this->get_serialization_context(), buffer);
 
-				spdlog::get("logReceived")->trace(logmsg(op, version, index, &(wrapper::get<T>(value))));
+				RD_LOG_TRACE(logReceived, logmsg(op, version, index, &(wrapper::get<T>(value))));
 
 				list::set(static_cast<size_t>(index), std::move(value));
 				break;
 			}
 			case Op::REMOVE:
 			{
-				spdlog::get("logReceived")->trace(logmsg(op, version, index));
+				RD_LOG_TRACE(logReceived, logmsg(op, version, index));
 
 				list::removeAt(static_cast<size_t>(index));
 				break;
@@ -164,6 +194,28 @@ public:
 		}
 	}
 
+	static void write_batch_header(Buffer& buffer, int32_t count)
+	{
+		buffer.write_compact_integral<int64_t>(static_cast<int64_t>(Op::ACK));
+		buffer.write_compact_integral<int32_t>(count);
+	}
+
+public:
+	/**
+	 * \brief Runs [action], whose changes of this list are sent as one message if the counterpart reads batches. Change
+	 * events fire as the changes are made.
+	 */
+	template <typename F>
+	void batch(F&& action) const
+	{
+		if (!is_bound())
+		{
+			action();
+			return;
+		}
+		message_batch.run(get_wire(), rdid, priority, &write_batch_header, std::forward<F>(action));
+	}
+
 	void advise(Lifetime lifetime, std::function<void(Event const&)> handler) const override
 	{
 		if (is_bound())
@@ -205,7 +257,7 @@ public:
 
 	void clear() const override
 	{
-		return local_change([&] { list::clear(); });
+		batch([&] { local_change([&] { list::clear(); }); });
 	}
 
 	size_t size() const override
@@ -218,24 +270,30 @@ public:
 		return list::empty();
 	}
 
-	std::vector<Wrapper<T>> const& getList() const override
+	std::vector<typename viewable_storage<T>::element_t> const& getList() const override
 	{
 		return list::getList();
 	}
 
 	bool addAll(size_t index, std::vector<WT> elements) const override
 	{
-		return local_change([&] { return list::addAll(index, std::move(elements)); });
+		bool result = false;
+		batch([&] { result = local_change([&] { return list::addAll(index, std::move(elements)); }); });
+		return result;
 	}
 
 	bool addAll(std::vector<WT> elements) const override
 	{
-		return local_change([&] { return list::addAll(std::move(elements)); });
+		bool result = false;
+		batch([&] { result = local_change([&] { return list::addAll(std::move(elements)); }); });
+		return result;
 	}
 
 	bool removeAll(std::vector<WT> elements) const override
 	{
-		return local_change([&] { return list::removeAll(std::move(elements)); });
+		bool result = false;
+		batch([&] { result = local_change([&] { return list::removeAll(std::move(elements)); }); });
+		return result;
 	}
 
 	friend std::string to_string(RdList const& value)
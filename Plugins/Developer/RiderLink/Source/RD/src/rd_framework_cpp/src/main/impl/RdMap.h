@@ -3,10 +3,11 @@
 
 #include "reactive/ViewableMap.h"
 #include "base/RdReactiveBase.h"
+#include "base/MessageBatch.h"
 #include "serialization/Polymorphic.h"
-#include "util/shared_function.h"
 
 #include <cstdint>
+#include <functional>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -36,7 +37,10 @@ private:
 
 	using map = ViewableMap<K, V>;
 	mutable int64_t next_version = 0;
-	mutable ordered_map<K const*, int64_t, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>> pendingForAck;
+	mutable ordered_map<typename viewable_storage<K>::handle_t, int64_t, wrapper::TransparentHash<K>,
+		wrapper::TransparentKeyEqual<K>>
+		pendingForAck;
+	mutable MessageBatch message_batch;
 
 	std::string logmsg(Op op, int64_t version, K const* key, V const* value = nullptr) const
 	{
@@ -103,18 +107,18 @@ public:
 					identifyPolymorphic(*new_value, *identity, identity->next(rdid));
 				}
 
-				get_wire()->send(rdid, [this, e](Buffer& buffer) {
+				auto writer = [this, &e](Buffer& buffer) {
 					int32_t versionedFlag = ((is_master ? 1 : 0)) << versionedFlagShift;
 					Op op = static_cast<Op>(e.v.index());
 
-					buffer.write_integral<int32_t>(static_cast<int32_t>(op) | versionedFlag);
+					buffer.write_compact_integral<int32_t>(static_cast<int32_t>(op) | versionedFlag);
 
 					int64_t version = is_master ? ++next_version : 0L;
 
 					if (is_master)
 					{
-						pendingForAck.emplace(e.get_key(), version);
-						buffer.write_integral(version);
+						pendingForAck.emplace(viewable_storage<K>::handle(*e.get_key()), version);
+						buffer.write_compact_integral(version);
 					}
 
 					KS::write(this->get_serialization_context(), buffer, *e.get_key());
@@ -125,28 +129,94 @@ public:
 						VS::write(this->get_serialization_context(), buffer, *new_value);
 					}
 
-					spdlog::get("logSend")->trace("SEND{}", logmsg(op, next_version - 1, e.get_key(), new_value));
-				});
+					RD_LOG_TRACE(logSend, "SEND{}", logmsg(op, next_version - 1, e.get_key(), new_value));
+				};
+				if (message_batch.is_open())
+				{
+					message_batch.add(writer);
+				}
+				else
+				{
+					get_wire()->send(rdid, std::ref(writer), priority);
+				}
 			});
 		});
 
 		get_wire()->advise(lifetime, this);
 
-		if (!optimize_nested)
+		if (!optimize_nested && is_bindable_v<V>)
 			this->view(lifetime, [this](Lifetime lf, std::pair<K const*, V const*> entry) {
 				bindPolymorphic(entry.second, lf, this, "[" + to_string(*entry.first) + "]");
 			});
 	}
 
+	/**
+	 * \brief Set in the header of a batch: the number of changes followed by them as they'd be sent one by one, or, with
+	 * [Op::ACK], the first and the last version of a batch acknowledged at once.
+	 */
+	static const int32_t batchedFlagShift = 9;
+
 	void on_wire_received(Buffer buffer) const override
 	{
-		int32_t header = buffer.read_integral<int32_t>();
-		bool msg_versioned = (header >> versionedFlagShift) != 0;
+		int32_t header = buffer.read_compact_integral<int32_t>();
+		if (((header >> batchedFlagShift) & 1) == 0)
+		{
+			receive(header, buffer, true);
+			return;
+		}
+
+		Op op = static_cast<Op>(header & ((1 << versionedFlagShift) - 1));
+		if (op == Op::ACK)
+		{
+			int64_t first_version = buffer.read_compact_integral<int64_t>();
+			int64_t last_version = buffer.read_compact_integral<int64_t>();
+			receive_batch_ack(first_version, last_version);
+			return;
+		}
+
+		int32_t count = buffer.read_compact_integral<int32_t>();
+		RD_LOG_TRACE(logReceived, "RECV map {} {}:: batch of {}", to_string(location), to_string(rdid), count);
+		int64_t first_version = 0;
+		int64_t last_version = 0;
+		// each change fires its own event as it's applied, like on the sending side: events describe one change and
+		// point into the map, so a handler sees the map as of its change rather than the whole batch applied
+		for (int32_t i = 0; i < count; ++i)
+		{
+			int64_t version = receive(buffer.read_compact_integral<int32_t>(), buffer, false);
+			if (version > 0)
+			{
+				first_version = first_version > 0 ? first_version : version;
+				last_version = version;
+			}
+		}
+
+		if (first_version > 0)
+		{
+			get_wire()->send(rdid, [first_version, last_version](Buffer& innerBuffer) {
+				innerBuffer.write_compact_integral<int32_t>(
+					(1 << batchedFlagShift) | (1 << versionedFlagShift) | static_cast<int32_t>(Op::ACK));
+				innerBuffer.write_compact_integral<int64_t>(first_version);
+				innerBuffer.write_compact_integral<int64_t>(last_version);
+			}, priority);
+		}
+	}
+
+private:
+	/**
+	 * \brief Applies the change after [header] in [buffer], acknowledges it unless [acknowledge] is false.
+	 * \return version of the change if it's versioned, 0 otherwise.
+	 */
+	int64_t receive(int32_t header, Buffer& buffer, bool acknowledge) const
+	{
+		bool msg_versioned = ((header >> versionedFlagShift) & 1) != 0;
 		Op op = static_cast<Op>(header & ((1 << versionedFlagShift) - 1));
 
-		int64_t version = msg_versioned ? buffer.read_integral<int64_t>() : 0;
+		int64_t version = msg_versioned ? buffer.read_compact_integral<int64_t>() : 0;
 
+		// echoed in the ACK as they came, so it's written the way the counterpart wrote it
+		const size_t key_begin = buffer.get_position();
 		WK key = KS::read(this->get_serialization_context(), buffer);
+		const size_t key_end = buffer.get_position();
 
 		if (op == Op::ACK)
 		{
@@ -186,59 +256,119 @@ public:
 			}
 			if (errmsg.empty())
 			{
-				spdlog::get("logReceived")->trace(logmsg(Op::ACK, version, &(wrapper::get<K>(key))));
+				RD_LOG_TRACE(logReceived, logmsg(Op::ACK, version, &(wrapper::get<K>(key))));
 			}
 			else
 			{
-				spdlog::get("logReceived")->error(logmsg(Op::ACK, version, &(wrapper::get<K>(key))) + " >> " + errmsg);
+				logReceived->error(logmsg(Op::ACK, version, &(wrapper::get<K>(key))) + " >> " + errmsg);
+			}
+			return 0;
+		}
+
+		bool is_put = (op == Op::ADD || op == Op::UPDATE);
+		optional<WV> value;
+		if (is_put)
+		{
+			value = VS::read(this->get_serialization_context(), buffer);
+		}
+
+		if (msg_versioned || !is_master || pendingForAck.count(key) == 0)
+		{
+			RD_LOG_TRACE(logReceived, "RECV{}", logmsg(op, version, &(wrapper::get<K>(key)), value));
+			if (value.has_value())
+			{
+				map::set(std::move(key), *std::move(value));
+			}
+			else
+			{
+				map::remove(wrapper::get<K>(key));
 			}
 		}
 		else
 		{
-			Buffer serialized_key;
-			KS::write(this->get_serialization_context(), serialized_key, wrapper::get<K>(key));
+			RD_LOG_TRACE(logReceived, "{} >> REJECTED", logmsg(op, version, &(wrapper::get<K>(key)), value));
+		}
 
-			bool is_put = (op == Op::ADD || op == Op::UPDATE);
-			optional<WV> value;
-			if (is_put)
+		if (msg_versioned)
+		{
+			if (acknowledge)
 			{
-				value = VS::read(this->get_serialization_context(), buffer);
+				auto writer = [&buffer, version, key_begin, key_end](Buffer& innerBuffer) {
+					innerBuffer.set_compact(buffer.is_compact());
+					innerBuffer.write_compact_integral<int32_t>((1u << versionedFlagShift) | static_cast<int32_t>(Op::ACK));
+					innerBuffer.write_compact_integral<int64_t>(version);
+					innerBuffer.write_byte_array_raw(buffer.data() + key_begin, key_end - key_begin);
+				};
+				get_wire()->send(rdid, std::ref(writer), priority);
 			}
+			if (is_master)
+			{
+				logReceived->error("Both ends are masters: {}", to_string(location));
+			}
+		}
+		return version;
+	}
 
-			if (msg_versioned || !is_master || pendingForAck.count(key) == 0)
+	/**
+	 * \brief Drops pending changes with versions from [first_version] to [last_version], the versions of a batch.
+	 */
+	void receive_batch_ack(int64_t first_version, int64_t last_version) const
+	{
+		if (!is_master)
+		{
+			logReceived->error("map {} {}:: batched {}:: versions = {}..{} >> Received {} when not a Master",
+				to_string(location), to_string(rdid), to_string(Op::ACK), first_version, last_version, to_string(Op::ACK));
+			return;
+		}
+		for (auto it = pendingForAck.begin(); it != pendingForAck.end();)
+		{
+			if (it->second >= first_version && it->second <= last_version)
 			{
-				spdlog::get("logReceived")->trace("RECV{}", logmsg(op, version, &(wrapper::get<K>(key)), value));
-				if (value.has_value())
-				{
-					map::set(std::move(key), *std::move(value));
-				}
-				else
-				{
-					map::remove(wrapper::get<K>(key));
-				}
+				// the last entry takes its place
+				it = pendingForAck.unordered_erase(it);
 			}
 			else
 			{
-				spdlog::get("logReceived")->trace("{} >> REJECTED", logmsg(op, version, &(wrapper::get<K>(key)), value));
+				++it;
 			}
+		}
+		RD_LOG_TRACE(logReceived, "map {} {}:: batched {}:: versions = {}..{}", to_string(location), to_string(rdid),
+			to_string(Op::ACK), first_version, last_version);
+	}
+
+	static void write_batch_header(Buffer& buffer, int32_t count)
+	{
+		buffer.write_compact_integral<int32_t>(1 << batchedFlagShift);
+		buffer.write_compact_integral<int32_t>(count);
+	}
+
+public:
+	/**
+	 * \brief Runs [action], whose changes of this map are sent as one message if the counterpart reads batches and
+	 * acknowledged at once if the map is master. Change events fire as the changes are made.
+	 */
+	template <typename F>
+	void batch(F&& action) const
+	{
+		if (!is_bound())
+		{
+			action();
+			return;
+		}
+		message_batch.run(get_wire(), rdid, priority, &write_batch_header, std::forward<F>(action));
+	}
 
-			if (msg_versioned)
+	/**
+	 * \brief Puts [entries] in one [batch].
+	 */
+	void putAll(std::vector<std::pair<WK, WV>> entries) const
+	{
+		batch([&] {
+			for (auto& entry : entries)
 			{
-				auto writer =
-					util::make_shared_function([version, serialized_key = std::move(serialized_key)](Buffer& innerBuffer) mutable {
-						innerBuffer.write_integral<int32_t>((1u << versionedFlagShift) | static_cast<int32_t>(Op::ACK));
-						innerBuffer.write_integral<int64_t>(version);
-						// KS::write(this->get_serialization_context(), innerBuffer, wrapper::get<K>(key));
-						innerBuffer.write_byte_array_raw(serialized_key.getArray());
-						// logSend.trace(logmsg(Op::ACK, version, serialized_key));
-					});
-				get_wire()->send(rdid, std::move(writer));
-				if (is_master)
-				{
-					spdlog::get("logReceived")->error("Both ends are masters: {}", to_string(location));
-				}
+				set(std::move(entry.first), std::move(entry.second));
 			}
-		}
+		});
 	}
 
 	void advise(Lifetime lifetime, std::function<void(Event const&)> handler) const override
@@ -267,7 +397,7 @@ public:
 
 	void clear() const override
 	{
-		return local_change([&] { return map::clear(); });
+		batch([&] { local_change([&] { map::clear(); }); });
 	}
 
 	size_t size() const override
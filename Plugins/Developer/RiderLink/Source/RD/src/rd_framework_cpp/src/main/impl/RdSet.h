@@ -3,9 +3,12 @@
 
 #include "reactive/ViewableSet.h"
 #include "base/RdReactiveBase.h"
+#include "base/MessageBatch.h"
 #include "serialization/Polymorphic.h"
 #include "std/allocator.h"
 
+#include <functional>
+
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 4250)
@@ -25,6 +28,38 @@ class RdSet final : public RdReactiveBase, public ViewableSet<T, A>, public ISer
 private:
 	using WT = typename IViewableSet<T>::WT;
 
+	mutable MessageBatch message_batch;
+
+	/**
+	 * \brief Kind following [AddRemove] values which introduces a batch: the number of changes followed by them.
+	 */
+	static const int32_t batchKind = 2;
+
+	static void write_batch_header(Buffer& buffer, int32_t count)
+	{
+		buffer.write_compact_integral<int32_t>(batchKind);
+		buffer.write_compact_integral<int32_t>(count);
+	}
+
+	void receive(AddRemove kind, Buffer& buffer) const
+	{
+		auto value = S::read(this->get_serialization_context(), buffer);
+
+		switch (kind)
+		{
+			case AddRemove::ADD:
+			{
+				set::add(std::move(value));
+				break;
+			}
+			case AddRemove::REMOVE:
+			{
+				set::remove(wrapper::get<T>(value));
+				break;
+			}
+		}
+	}
+
 protected:
 	using set = ViewableSet<T>;
 
@@ -69,12 +104,20 @@ public:
 				if (!is_local_change)
 					return;
 
-				get_wire()->send(rdid, [this, kind, &v](Buffer& buffer) {
+				auto writer = [this, kind, &v](Buffer& buffer) {
 					buffer.write_enum<AddRemove>(kind);
 					S::write(this->get_serialization_context(), buffer, v);
 
-					spdlog::get("logSend")->trace("SENDset {} {}:: {}:: {}", to_string(location), to_string(rdid), to_string(kind), to_string(v));
-				});
+					RD_LOG_TRACE(logSend, "SENDset {} {}:: {}:: {}", to_string(location), to_string(rdid), to_string(kind), to_string(v));
+				};
+				if (message_batch.is_open())
+				{
+					message_batch.add(writer);
+				}
+				else
+				{
+					get_wire()->send(rdid, std::ref(writer), priority);
+				}
 			});
 		});
 
@@ -83,22 +126,34 @@ public:
 
 	void on_wire_received(Buffer buffer) const override
 	{
-		AddRemove kind = buffer.read_enum<AddRemove>();
-		auto value = S::read(this->get_serialization_context(), buffer);
-
-		switch (kind)
+		int32_t kind = buffer.read_compact_integral<int32_t>();
+		if (kind == batchKind)
 		{
-			case AddRemove::ADD:
-			{
-				set::add(std::move(value));
-				break;
-			}
-			case AddRemove::REMOVE:
+			int32_t count = buffer.read_compact_integral<int32_t>();
+			RD_LOG_TRACE(logReceived, "set {} {}:: batch of {}", to_string(location), to_string(rdid), count);
+			// one event per change, as RdMap does
+			for (int32_t i = 0; i < count; ++i)
 			{
-				set::remove(wrapper::get<T>(value));
-				break;
+				receive(buffer.read_enum<AddRemove>(), buffer);
 			}
+			return;
+		}
+		receive(static_cast<AddRemove>(kind), buffer);
+	}
+
+	/**
+	 * \brief Runs [action], whose changes of this set are sent as one message if the counterpart reads batches. Change
+	 * events fire as the changes are made.
+	 */
+	template <typename F>
+	void batch(F&& action) const
+	{
+		if (!is_bound())
+		{
+			action();
+			return;
 		}
+		message_batch.run(get_wire(), rdid, priority, &write_batch_header, std::forward<F>(action));
 	}
 
 	bool add(WT value) const override
@@ -108,7 +163,7 @@ public:
 
 	void clear() const override
 	{
-		return local_change([&] { return set::clear(); });
+		batch([&] { local_change([&] { set::clear(); }); });
 	}
 
 	bool remove(T const& value) const override
@@ -142,7 +197,9 @@ public:
 
 	bool addAll(std::vector<WT> elements) const override
 	{
-		return local_change([this, elements = std::move(elements)]() mutable { return set::addAll(elements); });
+		bool result = false;
+		batch([&] { result = local_change([&] { return set::addAll(std::move(elements)); }); });
+		return result;
 	}
 
 	friend std::string to_string(RdSet const& value)
@@ -82,7 +82,7 @@ public:
 	void on_wire_received(Buffer buffer) const override
 	{
 		auto value = S::read(this->get_serialization_context(), buffer);
-		spdlog::get("logReceived")->trace("RECV{}", logmsg(wrapper::get<T>(value)));
+		RD_LOG_TRACE(logReceived, "RECV{}", logmsg(wrapper::get<T>(value)));
 
 		signal.fire(wrapper::get<T>(value));
 	}
@@ -103,9 +103,9 @@ public:
 		if (async && !is_bound()) return;
 
 		get_wire()->send(rdid, [this, &value](Buffer& buffer) {
-			spdlog::get("logSend")->trace("SEND{}", logmsg(value));
+			RD_LOG_TRACE(logSend, "SEND{}", logmsg(value));
 			S::write(get_serialization_context(), buffer, value);
-		});
+		}, priority);
 		signal.fire(value);
 	}
 
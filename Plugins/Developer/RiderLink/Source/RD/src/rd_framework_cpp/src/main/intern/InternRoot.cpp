@@ -8,6 +8,8 @@ namespace rd
 InternRoot::InternRoot()
 {
 	async = true;
+	// messages of any lane may refer to interned indices, so definitions must get to the counterpart first
+	priority = MessagePriority::Interactive;
 }
 
 IScheduler* InternRoot::get_wire_scheduler() const
@@ -17,14 +19,18 @@ IScheduler* InternRoot::get_wire_scheduler() const
 
 void InternRoot::on_wire_received(Buffer buffer) const
 {
-	optional<InternedAny> value = InternedAnySerializer::read(get_serialization_context(), buffer);
-	if (!value)
+	// several definitions if we read batches, see [flush]
+	while (buffer.get_position() < buffer.get_data().size())
 	{
-		return;
+		optional<InternedAny> value = InternedAnySerializer::read(get_serialization_context(), buffer);
+		if (!value)
+		{
+			return;
+		}
+		const int32_t remote_id = buffer.read_compact_integral<int32_t>();
+		set_interned_correspondence(remote_id ^ 1, *std::move(value));
+		RD_ASSERT_MSG(((remote_id & 1) == 0), "Remote sent ID marked as our own, bug?");
 	}
-	const int32_t remote_id = buffer.read_integral<int32_t>();
-	set_interned_correspondence(remote_id ^ 1, *std::move(value));
-	RD_ASSERT_MSG(((remote_id & 1) == 0), "Remote sent ID marked as our own, bug?");
 }
 
 void InternRoot::bind(Lifetime lf, IRdDynamic const* parent, string_view name) const
@@ -42,12 +48,20 @@ void InternRoot::bind(Lifetime lf, IRdDynamic const* parent, string_view name) c
 			rdid = RdId::Null();
 		});
 
+	// if something's interned before bind
+	for (auto& shard : inverse_map)
+	{
+		std::lock_guard<std::mutex> guard(shard.lock);
+		shard.map.clear();
+	}
 	{
-		// if something's interned before bind
-		std::lock_guard<decltype(lock)> guard(lock);
-		my_items_lis.clear();
-		other_items_list.clear();
-		inverse_map.clear();
+		std::lock_guard<std::mutex> flush_guard(flush_lock);
+		std::lock_guard<std::mutex> pending_guard(pending_lock);
+		my_items.clear();
+		other_items.clear();
+		pending = MessageBatch();
+		sending = MessageBatch();
+		sent_count.store(0, std::memory_order_release);
 	}
 	get_protocol()->get_wire()->advise(lf, this);
 }
@@ -64,8 +78,56 @@ void InternRoot::set_interned_correspondence(int32_t id, InternedAny&& value) co
 {
 	RD_ASSERT_MSG(!is_index_owned(id), "Setting interned correspondence for object that we should have written, bug?")
 
-	std::lock_guard<decltype(lock)> guard(lock);
-	other_items_list[id / 2] = value;
-	inverse_map[value] = id;
+	other_items.set(id / 2, value);
+	const size_t hash = any::TransparentHash()(value);
+	InverseShard& shard = shard_of(hash);
+	std::lock_guard<std::mutex> guard(shard.lock);
+	shard.map.insert_or_assign(std::move(value), id);
+}
+
+InternRoot::InverseShard& InternRoot::shard_of(size_t hash) const
+{
+	static_assert(INVERSE_SHARDS == 16, "four bits of the hash pick the shard");
+	// top bits of a Fibonacci hash, the low ones pick buckets inside the shard
+	return inverse_map[(static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> 60];
+}
+
+void InternRoot::flush() const
+{
+	std::lock_guard<std::mutex> guard(flush_lock);
+	int32_t count = 0;
+	{
+		std::lock_guard<std::mutex> pending_guard(pending_lock);
+		if (pending.size() == 0)
+		{
+			// whoever took the definitions sent them before releasing flush_lock
+			return;
+		}
+		std::swap(pending, sending);
+		count = static_cast<int32_t>(my_items.size());
+	}
+	try
+	{
+		sending.flush(get_protocol()->get_wire(), rdid, priority, [](Buffer&, int32_t) {});
+	}
+	catch (...)
+	{
+		sending = MessageBatch();
+		sent_count.store(count, std::memory_order_release);
+		throw;
+	}
+	sent_count.store(count, std::memory_order_release);
+}
+
+void InternRoot::ensure_sent(int32_t index) const
+{
+	if (!is_index_owned(index))
+	{
+		return;
+	}
+	while (sent_count.load(std::memory_order_acquire) <= index / 2)
+	{
+		flush();
+	}
 }
 }	 // namespace rd
@@ -1,16 +1,19 @@
 #ifndef RD_CPP_INTERNROOT_H
 #define RD_CPP_INTERNROOT_H
 
+#include "base/MessageBatch.h"
 #include "base/RdReactiveBase.h"
 #include "InternScheduler.h"
 #include "lifetime/Lifetime.h"
 #include "types/wrapper.h"
 #include "serialization/RdAny.h"
 #include "util/core_traits.h"
+#include "util/segmented_array.h"
 
 #include "tsl/ordered_map.h"
 
-#include <vector>
+#include <array>
+#include <atomic>
 #include <string>
 #include <mutex>
 
@@ -36,20 +39,49 @@ class Identities;
 class RD_FRAMEWORK_API InternRoot final : public RdReactiveBase
 {
 private:
-	// template<typename T>
-	mutable std::vector<InternedAny> my_items_lis;
+	struct InverseShard
+	{
+		std::mutex lock;
+		ordered_map<InternedAny, int32_t, any::TransparentHash, any::TransparentKeyEqual> map;
+	};
+
+	static constexpr size_t INVERSE_SHARDS = 16;
+
+	// a definition of an asset path or a name fits without the buffer growing
+	static constexpr size_t DEFINITION_CAPACITY = 256;
+
+	// values we interned, at index / 2 of even indices, and values the counterpart did, of odd ones
+	mutable util::segmented_array<InternedAny> my_items;
+	mutable util::segmented_array<InternedAny> other_items;
+
+	// striped by hash, interning of different values doesn't contend
+	mutable std::array<InverseShard, INVERSE_SHARDS> inverse_map;
 
-	// template<typename T>
-	mutable ordered_map<int32_t, InternedAny> other_items_list;
-	// template<typename T>
-	mutable ordered_map<InternedAny, int32_t, any::TransparentHash, any::TransparentKeyEqual> inverse_map;
+	// definitions of [my_items] not sent yet, in index order, and the ones being sent
+	mutable MessageBatch pending;
+	mutable MessageBatch sending;
+	mutable std::mutex pending_lock;
+	mutable std::mutex flush_lock;
+	// count of [my_items] the definition of which is on the wire
+	mutable std::atomic<int32_t> sent_count{0};
 
 	mutable InternScheduler intern_scheduler;
 
-	mutable std::recursive_mutex lock;
+	InverseShard& shard_of(size_t hash) const;
 
 	void set_interned_correspondence(int32_t id, InternedAny&& value) const;
 
+	/**
+	 * \brief Sends [pending] definitions as one message if the counterpart reads batches. Definitions added while
+	 * another thread sends are left to the next flush, so concurrent interning shares messages.
+	 */
+	void flush() const;
+
+	/**
+	 * \brief Returns once the definition of [index] is on the wire, ahead of any message that refers to it.
+	 */
+	void ensure_sent(int32_t index) const;
+
 	static constexpr bool is_index_owned(int32_t id);
 
 public:
@@ -78,15 +110,6 @@ public:
 
 namespace rd
 {
-/*template<typename T>
-std::vector<value_or_wrapper<T>> InternRoot::myItemsList = {};
-
-template<typename T>
-ordered_map<int32_t, value_or_wrapper<T>> InternRoot::otherItemsList = {};
-
-template<typename T>
-ordered_map<value_or_wrapper<T>, int32_t> InternRoot::inverseMap = {};*/
-
 constexpr bool InternRoot::is_index_owned(int32_t id)
 {
 	return !static_cast<bool>(id & 1);
@@ -95,39 +118,55 @@ constexpr bool InternRoot::is_index_owned(int32_t id)
 template <typename T>
 Wrapper<T> InternRoot::un_intern_value(int32_t id) const
 {
-	// don't need lock because value's already exists and never removes
-	return any::get<T>(is_index_owned(id) ? my_items_lis[id / 2] : other_items_list[id / 2]);
+	// values are never removed and the index was published with the value, so no lock is needed
+	return any::get<T>(is_index_owned(id) ? my_items[id / 2] : other_items[id / 2]);
 }
 
 template <typename T>
 int32_t InternRoot::intern_value(Wrapper<T> value) const
 {
 	InternedAny any = any::make_interned_any<T>(value);
+	const size_t hash = any::TransparentHash()(any);
+	InverseShard& shard = shard_of(hash);
 
-	std::lock_guard<decltype(lock)> guard(lock);
-
-	auto it = inverse_map.find(any);
 	int32_t index = 0;
-	if (it == inverse_map.end())
-	{
-		get_protocol()->get_wire()->send(this->rdid, [this, &index, value, any](Buffer& buffer) {
-			InternedAnySerializer::write<T>(get_serialization_context(), buffer, wrapper::get<T>(value));
-			{
-				std::lock_guard<decltype(lock)> guard(lock);
-				index = static_cast<int32_t>(my_items_lis.size()) * 2;
-				my_items_lis.emplace_back(any);
-			}
-			buffer.write_integral<int32_t>(index);
-		});
-	}
-	else
+	bool found = false;
 	{
-		index = it->second;
+		std::lock_guard<std::mutex> guard(shard.lock);
+		auto it = shard.map.find(any, hash);
+		if (it != shard.map.end())
+		{
+			index = it->second;
+			found = true;
+		}
 	}
-	if (inverse_map.count(any) == 0)
+	if (!found)
 	{
-		inverse_map[any] = index;
+		// serialized without a lock held, the value may intern the values it refers to
+		Buffer definition(DEFINITION_CAPACITY);
+		InternedAnySerializer::write<T>(get_serialization_context(), definition, wrapper::get<T>(value));
+		definition.get_data().resize(definition.get_position());
+
+		std::lock_guard<std::mutex> guard(shard.lock);
+		auto it = shard.map.find(any, hash);
+		if (it != shard.map.end())
+		{
+			index = it->second;
+		}
+		else
+		{
+			{
+				std::lock_guard<std::mutex> pending_guard(pending_lock);
+				index = static_cast<int32_t>(my_items.push_back(any)) * 2;
+				pending.add([&definition, index](Buffer& buffer) {
+					buffer.write_byte_array_raw(definition.get_data());
+					buffer.write_compact_integral<int32_t>(index);
+				});
+			}
+			shard.map.emplace(std::move(any), index);
+		}
 	}
+	ensure_sent(index);
 	return index;
 }
 }	 // namespace rd
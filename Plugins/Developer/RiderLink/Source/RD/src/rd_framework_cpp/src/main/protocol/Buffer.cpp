@@ -2,11 +2,18 @@
 
 #include "protocol/Buffer.h"
 
+#include "util/utf16.h"
+
 #include <string>
 #include <algorithm>
 
 namespace rd
 {
+/**
+ * \brief 64 bits in 7-bit groups.
+ */
+static constexpr size_t MAX_VARINT_LENGTH = 10;
+
 Buffer::Buffer() : Buffer(16)
 {
 }
@@ -70,6 +77,65 @@ void Buffer::rewind()
 	set_position(0);
 }
 
+bool Buffer::is_compact() const
+{
+	return compact;
+}
+
+void Buffer::set_compact(bool value)
+{
+	compact = value;
+}
+
+void Buffer::write_varint(uint64_t value)
+{
+	require_available(MAX_VARINT_LENGTH);
+	word_t* out = &data_[offset];
+	word_t* const begin = out;
+	while (value >= 0x80)
+	{
+		*out++ = static_cast<word_t>(value | 0x80);
+		value >>= 7;
+	}
+	*out++ = static_cast<word_t>(value);
+	offset += static_cast<size_t>(out - begin);
+}
+
+uint64_t Buffer::read_varint()
+{
+	// bounds are checked once for the longest varint unless the buffer ends sooner
+	const size_t available = size() > offset ? size() - offset : 0;
+	const size_t limit = (std::min)(available, static_cast<size_t>(MAX_VARINT_LENGTH));
+	word_t const* in = data_.data() + offset;
+	uint64_t result = 0;
+	for (size_t i = 0; i < limit; ++i)
+	{
+		const word_t byte = in[i];
+		result |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+		if ((byte & 0x80) == 0)
+		{
+			offset += i + 1;
+			return result;
+		}
+	}
+	if (limit < MAX_VARINT_LENGTH)
+	{
+		check_available(limit + 1);
+	}
+	throw std::out_of_range("Malformed varint at " + std::to_string(offset));
+}
+
+void Buffer::write_zigzag(int64_t value)
+{
+	write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+int64_t Buffer::read_zigzag()
+{
+	const uint64_t value = read_varint();
+	return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
 Buffer::ByteArray Buffer::getArray() const&
 {
 	return data_;
@@ -134,18 +200,26 @@ writeArray<uint8_t>(v);
 template <int>
 std::wstring read_wstring_spec(Buffer& buffer)
 {
-	auto v = buffer.read_array<std::vector, uint16_t>();
-	return std::wstring(v.begin(), v.end());
+	const int32_t len = buffer.read_string_length();
+	buffer.check_available(sizeof(uint16_t) * len);
+	std::wstring result;
+	result.resize(len);
+	if (len > 0)
+	{
+		const size_t chars = util::utf16::widen(buffer.current_pointer(), len, reinterpret_cast<char32_t*>(&result[0]));
+		result.resize(chars);
+		buffer.offset += sizeof(uint16_t) * len;
+	}
+	return result;
 }
 
 template <>
 std::wstring read_wstring_spec<2>(Buffer& buffer)
 {
-	const int32_t len = buffer.read_integral<int32_t>();
-	RD_ASSERT_MSG(len >= 0, "read null string(length =" + std::to_string(len) + ")");
+	const int32_t len = buffer.read_string_length();
 	std::wstring result;
 	result.resize(len);
-	buffer.read(reinterpret_cast<Buffer::word_t*>(&result[0]), sizeof(wchar_t) * len);
+	buffer.read_char16_data(reinterpret_cast<uint16_t*>(&result[0]), len);
 	return result;
 }
 
@@ -157,14 +231,26 @@ std::wstring Buffer::read_wstring()
 template <int>
 void write_wstring_spec(Buffer& buffer, wstring_view value)
 {
-	const std::vector<uint16_t> v(value.begin(), value.end());
-	buffer.write_array<std::vector, uint16_t>(v);
+	// written for the usual case of no characters above U+FFFF, rewritten with the right length otherwise
+	const size_t start = buffer.get_position();
+	buffer.write_compact_integral<int32_t>(static_cast<int32_t>(value.size()));
+	buffer.require_available(2 * sizeof(uint16_t) * value.size());
+	auto const* src = reinterpret_cast<char32_t const*>(value.data());
+	auto units = util::utf16::narrow(src, value.size(), buffer.current_pointer());
+	if (units != value.size())
+	{
+		buffer.set_position(start);
+		buffer.write_compact_integral<int32_t>(static_cast<int32_t>(units));
+		buffer.require_available(sizeof(uint16_t) * units);
+		units = util::utf16::narrow(src, value.size(), buffer.current_pointer());
+	}
+	buffer.offset += sizeof(uint16_t) * units;
 }
 
 template <>
 void write_wstring_spec<2>(Buffer& buffer, wstring_view value)
 {
-	buffer.write_integral<int32_t>(static_cast<int32_t>(value.size()));
+	buffer.write_compact_integral<int32_t>(static_cast<int32_t>(value.size()));
 	buffer.write(reinterpret_cast<Buffer::word_t const*>(value.data()), sizeof(wchar_t) * value.size());
 }
 
@@ -175,20 +261,31 @@ void Buffer::write_wstring(std::wstring const& value)
 
 void Buffer::write_char16_string(const uint16_t* data, size_t len)
 {
-	write_integral<int32_t>(static_cast<int32_t>(len));
+	write_compact_integral<int32_t>(static_cast<int32_t>(len));
 	write(reinterpret_cast<word_t const*>(data), sizeof(uint16_t) * len);
 }
 
 uint16_t* Buffer::read_char16_string()
-{	
-	const int32_t len = read_integral<int32_t>();
-	RD_ASSERT_MSG(len >= 0, "read null string(length =" + std::to_string(len) + ")");
-	uint16_t * result = new uint16_t[len+1];
-	read(reinterpret_cast<Buffer::word_t*>(&result[0]), sizeof(uint16_t) * len);
+{
+	const int32_t len = read_string_length();
+	uint16_t* result = new uint16_t[len + 1];
+	read_char16_data(result, len);
 	result[len] = 0;
 	return result;
 }
 
+int32_t Buffer::read_string_length()
+{
+	const int32_t len = read_compact_integral<int32_t>();
+	RD_ASSERT_MSG(len >= 0, "read null string(length =" + std::to_string(len) + ")");
+	return len;
+}
+
+void Buffer::read_char16_data(uint16_t* dst, size_t len)
+{
+	read(reinterpret_cast<word_t*>(dst), sizeof(uint16_t) * len);
+}
+
 void Buffer::write_wstring(wstring_view value)
 {
 	write_wstring_spec<sizeof(wchar_t)>(*this, value);
@@ -254,6 +351,11 @@ void Buffer::write_byte_array_raw(const ByteArray& array)
 	write(array.data(), array.size());
 }
 
+void Buffer::write_byte_array_raw(word_t const* bytes, size_t size)
+{
+	write(bytes, size);
+}
+
 Buffer::ByteArray& Buffer::get_data()
 {
 	return data_;
@@ -9,6 +9,7 @@
 #include "types/DateTime.h"
 #include "util/core_util.h"
 #include "types/wrapper.h"
+#include "serialization/FixedLayout.h"
 #include "std/allocator.h"
 #include "std/list.h"
 
@@ -46,6 +47,8 @@ private:
 
 	size_t offset = 0;
 
+	bool compact = false;
+
 	// read
 	void read(word_t* dst, size_t size);
 
@@ -97,6 +100,67 @@ public:
 		write(reinterpret_cast<word_t const*>(&value), sizeof(T));
 	}
 
+	/**
+	 * \brief Compact mode is negotiated by the wire and set per message, see [write_compact_integral].
+	 */
+	bool is_compact() const;
+
+	/**
+	 * \brief The wire sets it before calling a writer and flags the message with the mode the buffer ends up in. A writer
+	 * copying bytes serialized beforehand sets their mode before writing anything: fixed-width is always understood,
+	 * compact only by the counterpart which sent them that way.
+	 */
+	void set_compact(bool value);
+
+	/**
+	 * \brief Unsigned LEB128: 7 bits per byte, least significant first, the high bit set on all bytes but the last.
+	 */
+	void write_varint(uint64_t value);
+
+	uint64_t read_varint();
+
+	/**
+	 * \brief LEB128 of the zig-zag mapping 0, -1, 1, -2... -> 0, 1, 2, 3..., so small negative values stay short.
+	 */
+	void write_zigzag(int64_t value);
+
+	int64_t read_zigzag();
+
+	/**
+	 * \brief [write_integral] in fixed-width mode. In compact mode integrals wider than a byte are written as [write_zigzag]
+	 * if signed and [write_varint] otherwise, used for lengths, enums, versions and other fields which are mostly small.
+	 */
+	template <typename T, typename = typename std::enable_if_t<std::is_integral<T>::value>>
+	void write_compact_integral(T value)
+	{
+		if (!compact || sizeof(T) == 1)
+		{
+			write_integral(value);
+		}
+		else if (std::is_signed<T>::value)
+		{
+			write_zigzag(static_cast<int64_t>(value));
+		}
+		else
+		{
+			write_varint(static_cast<uint64_t>(value));
+		}
+	}
+
+	template <typename T, typename = typename std::enable_if_t<std::is_integral<T>::value, T>>
+	T read_compact_integral()
+	{
+		if (!compact || sizeof(T) == 1)
+		{
+			return read_integral<T>();
+		}
+		if (std::is_signed<T>::value)
+		{
+			return static_cast<T>(read_zigzag());
+		}
+		return static_cast<T>(read_varint());
+	}
+
 	template <typename T, typename = typename std::enable_if_t<std::is_floating_point<T>::value, T>>
 	T read_floating_point()
 	{
@@ -115,7 +179,7 @@ public:
 		typename = typename std::enable_if_t<util::is_pod_v<T>>>
 	C<T, A> read_array()
 	{
-		int32_t len = read_integral<int32_t>();
+		int32_t len = read_compact_integral<int32_t>();
 		RD_ASSERT_MSG(len >= 0, "read null array(length = " + std::to_string(len) + ")");
 		C<T, A> result;
 		using rd::resize;
@@ -130,7 +194,7 @@ public:
 	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>>
 	C<value_or_wrapper<T>, A> read_array(std::function<value_or_wrapper<T>()> reader)
 	{
-		int32_t len = read_integral<int32_t>();
+		int32_t len = read_compact_integral<int32_t>();
 		C<value_or_wrapper<T>, A> result;
 		using rd::resize;
 		resize(result, len);
@@ -147,7 +211,7 @@ public:
 	{
 		using rd::size;
 		const int32_t& len = rd::size(container);
-		write_integral<int32_t>(static_cast<int32_t>(len));
+		write_compact_integral<int32_t>(static_cast<int32_t>(len));
 		if (len > 0)
 		{
 			write(reinterpret_cast<word_t const*>(&container[0]), sizeof(T) * len);
@@ -159,7 +223,7 @@ public:
 	void write_array(C<T, A> const& container, std::function<void(T const&)> writer)
 	{
 		using rd::size;
-		write_integral<int32_t>(size(container));
+		write_compact_integral<int32_t>(size(container));
 		for (auto const& e : container)
 		{
 			writer(e);
@@ -170,19 +234,70 @@ public:
 	void write_array(C<Wrapper<T>, A> const& container, std::function<void(T const&)> writer)
 	{
 		using rd::size;
-		write_integral<int32_t>(size(container));
+		write_compact_integral<int32_t>(size(container));
 		for (auto const& e : container)
 		{
 			writer(*e);
 		}
 	}
 
+	/**
+	 * \brief Reads an array of [fixed_layout] elements as [write_array] wrote it, checking the bounds once for all of them.
+	 */
+	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>,
+		typename std::enable_if_t<is_fixed_layout_v<T>, int> = 0>
+	C<value_or_wrapper<T>, A> read_array()
+	{
+		int32_t len = read_compact_integral<int32_t>();
+		RD_ASSERT_MSG(len >= 0, "read null array(length = " + std::to_string(len) + ")");
+		const size_t bytes = fixed_layout<T>::size * static_cast<size_t>(len);
+		check_available(bytes);
+		C<value_or_wrapper<T>, A> result;
+		using rd::resize;
+		resize(result, len);
+		word_t const* in = data_.data() + offset;
+		for (int32_t i = 0; i < len; ++i)
+		{
+			result[i] = value_or_wrapper<T>(fixed_layout<T>::load(in));
+			in += fixed_layout<T>::size;
+		}
+		offset += bytes;
+		return result;
+	}
+
+	/**
+	 * \brief Writes an array of [fixed_layout] elements the way writing them one by one would: the buffer grows once and
+	 * their fields are stored straight into it.
+	 */
+	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>,
+		typename std::enable_if_t<is_fixed_layout_v<T>, int> = 0>
+	void write_array(C<value_or_wrapper<T>, A> const& container)
+	{
+		using rd::size;
+		const auto len = static_cast<int32_t>(size(container));
+		write_compact_integral<int32_t>(len);
+		const size_t bytes = fixed_layout<T>::size * static_cast<size_t>(len);
+		require_available(bytes);
+		word_t* out = data_.data() + offset;
+		for (auto const& e : container)
+		{
+			fixed_layout<T>::store(wrapper::get<T>(e), out);
+			out += fixed_layout<T>::size;
+		}
+		offset += bytes;
+	}
+
 	void read_byte_array(ByteArray& array);
 
 	void read_byte_array_raw(ByteArray& array);
 
 	void write_byte_array_raw(ByteArray const& array);
 
+	/**
+	 * \brief Writes [size] bytes from [bytes] as they are, e.g. a part of a received buffer echoed back.
+	 */
+	void write_byte_array_raw(word_t const* bytes, size_t size);
+
 	//    std::string readString() const;
 
 	//    void writeString(std::string const &value) const;
@@ -197,7 +312,18 @@ public:
 
 	void write_char16_string(const uint16_t* data, size_t len);
 
-	uint16_t * read_char16_string();
+	/**
+	 * \brief Result is allocated with new[], prefer [read_string_length] and [read_char16_data] into the destination.
+	 */
+	uint16_t* read_char16_string();
+
+	/**
+	 * \brief Length in UTF-16 units of a string written by [write_char16_string] or [write_wstring], to size the
+	 * destination of [read_char16_data] once.
+	 */
+	int32_t read_string_length();
+
+	void read_char16_data(uint16_t* dst, size_t len);
 
 	std::wstring read_wstring();
 
@@ -214,27 +340,27 @@ public:
 	template <typename T, typename = typename std::enable_if_t<util::is_enum_v<T>>>
 	T read_enum()
 	{
-		int32_t x = read_integral<int32_t>();
+		int32_t x = read_compact_integral<int32_t>();
 		return static_cast<T>(x);
 	}
 
 	template <typename T, typename = typename std::enable_if_t<util::is_enum_v<T>>>
 	void write_enum(T const& x)
 	{
-		write_integral<int32_t>(static_cast<int32_t>(x));
+		write_compact_integral<int32_t>(static_cast<int32_t>(x));
 	}
 
 	template <typename T, typename = typename std::enable_if_t<util::is_enum_v<T>>>
 	T read_enum_set()
 	{
-		int32_t x = read_integral<int32_t>();
+		int32_t x = read_compact_integral<int32_t>();
 		return static_cast<T>(x);
 	}
 
 	template <typename T, typename = typename std::enable_if_t<util::is_enum_v<T>>>
 	void write_enum_set(T const& x)
 	{
-		write_integral<int32_t>(static_cast<int32_t>(x));
+		write_compact_integral<int32_t>(static_cast<int32_t>(x));
 	}
 
 	template <typename T, typename F, typename = typename std::enable_if_t<util::is_same_v<typename util::result_of_t<F()>, T>>>
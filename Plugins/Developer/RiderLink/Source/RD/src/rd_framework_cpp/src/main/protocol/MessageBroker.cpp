@@ -7,124 +7,196 @@ namespace rd
 std::shared_ptr<spdlog::logger> MessageBroker::logger =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("logger", spdlog::color_mode::automatic);
 
+constexpr size_t MessageBroker::SUBSCRIPTION_SHARDS;
+
 static void execute(const IRdReactive* that, Buffer msg)
 {
 	msg.read_integral<int16_t>();	   // skip context
 	that->on_wire_received(std::move(msg));
 }
 
-void MessageBroker::invoke(const IRdReactive* that, Buffer msg, bool sync) const
+void MessageBroker::DispatchTask::operator()()
 {
-	if (sync)
+	if (owner->find_subscription(id) == that)
 	{
-		execute(that, std::move(msg));
+		execute(that, std::move(message));
+		if (timed)
+		{
+			owner->metrics->record_dispatch(id, std::chrono::steady_clock::now() - queued_at);
+		}
 	}
 	else
 	{
-		auto action = [this, that, message = std::move(msg)]() mutable {
-			bool exists_id = false;
-			{
-				std::lock_guard<decltype(lock)> guard(lock);
-				exists_id = subscriptions.count(that->get_id()) > 0;
-			}
-			if (exists_id)
-			{
-				execute(that, std::move(message));
-			}
-			else
-			{
-				logger->trace("Disappeared Handler for Reactive entities with id: {}", to_string(that->get_id()));
-			}
-		};
-		std::function<void()> function = util::make_shared_function(std::move(action));
-		that->get_wire_scheduler()->queue(std::move(function));
+		logger->trace("Disappeared Handler for Reactive entities with id: {}", to_string(id));
 	}
+	owner->release_task(this);
 }
 
-MessageBroker::MessageBroker(IScheduler* defaultScheduler) : default_scheduler(defaultScheduler)
+MessageBroker::SubscriptionShard& MessageBroker::shard_of(RdId const& id) const
 {
+	// ids are mixed with a small factor, so scramble them before taking low bits
+	auto h = static_cast<uint64_t>(id.get_hash());
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return shards[h & (SUBSCRIPTION_SHARDS - 1)];
 }
 
-void MessageBroker::dispatch(RdId id, Buffer message) const
+IRdReactive const* MessageBroker::find_subscription(RdId const& id) const
 {
-	RD_ASSERT_MSG(!id.isNull(), "id mustn't be null")
+	auto& shard = shard_of(id);
+	std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+	auto it = shard.subscriptions.find(id);
+	return it == shard.subscriptions.end() ? nullptr : it->second;
+}
+
+MessageBroker::DispatchTask* MessageBroker::acquire_task() const
+{
+	std::lock_guard<decltype(pool_lock)> guard(pool_lock);
+	if (free_tasks.empty())
+	{
+		task_storage.emplace_back();
+		return &task_storage.back();
+	}
+	DispatchTask* task = free_tasks.back();
+	free_tasks.pop_back();
+	return task;
+}
+
+void MessageBroker::release_task(DispatchTask* task) const
+{
+	task->that = nullptr;
+	task->message = Buffer{Buffer::ByteArray{}};
+	task->timed = false;
+
+	// storage is bounded by the peak number of messages in flight, tasks are never freed one by one
+	std::lock_guard<decltype(pool_lock)> guard(pool_lock);
+	free_tasks.push_back(task);
+}
 
-	{	 // synchronized recursively
-		std::lock_guard<decltype(lock)> guard(lock);
-		IRdReactive const* s = subscriptions[id];
-		if (s == nullptr)
+void MessageBroker::invoke(const IRdReactive* that, Buffer msg, bool sync, bool timed) const
+{
+	if (sync)
+	{
+		if (timed)
 		{
-			auto it = broker.find(id);
-			if (it == broker.end())
-			{
-				it = broker.emplace(id, Mq{}).first;
-			}
-
-			broker[id].default_scheduler_messages.emplace(std::move(message));
-
-			auto action = [this, it, id]() mutable {
-				auto& current = it->second;
-				IRdReactive const* subscription = subscriptions[id];
-
-				optional<Buffer> message;
-				{
-					std::lock_guard<decltype(lock)> guard(lock);
-					if (!current.default_scheduler_messages.empty())
-					{
-						message = make_optional<Buffer>(std::move(current.default_scheduler_messages.front()));
-						current.default_scheduler_messages.pop();
-					}
-				}
-				if (subscription != nullptr)
-				{
-					if (message)
-					{
-						invoke(subscription, *std::move(message), subscription->get_wire_scheduler() == default_scheduler);
-					}
-				}
-				else
-				{
-					logger->trace("No handler for id: {}", to_string(id));
-				}
-
-				if (current.default_scheduler_messages.empty())
-				{
-					auto t = std::move(broker[id]);
-					broker.erase(id);
-					for (auto& it : t.custom_scheduler_messages)
-					{
-						RD_ASSERT_MSG(subscription->get_wire_scheduler() != default_scheduler,
-							"require equals of wire and default schedulers")
-						invoke(subscription, std::move(it));
-					}
-				}
-			};
-			std::function<void()> function = util::make_shared_function(std::move(action));
-			default_scheduler->queue(std::move(function));
+			const auto start = std::chrono::steady_clock::now();
+			const auto id = that->get_id();
+			execute(that, std::move(msg));
+			metrics->record_dispatch(id, std::chrono::steady_clock::now() - start);
 		}
 		else
 		{
-			if (s->get_wire_scheduler() == default_scheduler || s->get_wire_scheduler()->out_of_order_execution)
-			{
-				invoke(s, std::move(message));
-			}
-			else
-			{
-				auto it = broker.find(id);
-				if (it == broker.end())
-				{
-					invoke(s, std::move(message));
-				}
-				else
-				{
-					Mq& mq = it->second;
-					mq.custom_scheduler_messages.push_back(std::move(message));
-				}
-			}
+			execute(that, std::move(msg));
 		}
 	}
+	else
+	{
+		DispatchTask* task = acquire_task();
+		task->owner = this;
+		task->that = that;
+		task->id = that->get_id();
+		task->message = std::move(msg);
+		task->timed = timed;
+		if (timed)
+		{
+			task->queued_at = std::chrono::steady_clock::now();
+		}
+		that->get_wire_scheduler()->queue([task]() { (*task)(); });
+	}
+}
+
+void MessageBroker::process_deferred(RdId id, Mq* mq) const
+{
+	IRdReactive const* subscription = find_subscription(id);
+
+	optional<Buffer> message;
+	{
+		std::lock_guard<decltype(broker_lock)> guard(broker_lock);
+		if (!mq->default_scheduler_messages.empty())
+		{
+			message = make_optional<Buffer>(std::move(mq->default_scheduler_messages.front()));
+			mq->default_scheduler_messages.pop();
+		}
+	}
+	if (subscription != nullptr)
+	{
+		if (message)
+		{
+			invoke(subscription, *std::move(message), subscription->get_wire_scheduler() == default_scheduler);
+		}
+	}
+	else
+	{
+		logger->trace("No handler for id: {}", to_string(id));
+	}
 
-	//        }
+	std::vector<Buffer> custom_scheduler_messages;
+	{
+		std::lock_guard<decltype(broker_lock)> guard(broker_lock);
+		if (!mq->default_scheduler_messages.empty())
+		{
+			return;
+		}
+		custom_scheduler_messages = std::move(mq->custom_scheduler_messages);
+		broker.erase(id);	 // mq is dangling from here
+	}
+	for (auto& it : custom_scheduler_messages)
+	{
+		RD_ASSERT_MSG(subscription != nullptr && subscription->get_wire_scheduler() != default_scheduler,
+			"require equals of wire and default schedulers")
+		invoke(subscription, std::move(it));
+	}
+}
+
+MessageBroker::MessageBroker(IScheduler* defaultScheduler, WireMetrics* metrics, TraceRing* trace_ring)
+	: default_scheduler(defaultScheduler), metrics(metrics), trace_ring(trace_ring)
+{
+}
+
+void MessageBroker::dispatch(RdId id, Buffer message) const
+{
+	RD_ASSERT_MSG(!id.isNull(), "id mustn't be null")
+
+	IRdReactive const* s = find_subscription(id);
+	// messages waiting for their entity in the deferred queue are counted, but not timed
+	bool timed = false;
+	if (metrics != nullptr && metrics->is_enabled())
+	{
+		timed = true;
+		metrics->record_message(id, WireMetrics::Direction::Incoming, message.get_data().size(), s);
+	}
+	if (trace_ring != nullptr)
+	{
+		trace_ring->record(id, TraceRing::Op::Receive, message.get_data().size());
+	}
+	if (s == nullptr)
+	{
+		// queued under the lock, so every pending action has its message in mq and the entry outlives them all;
+		// node-based map, so the pointer survives rehashing until process_deferred erases the entry
+		std::lock_guard<decltype(broker_lock)> guard(broker_lock);
+		Mq* mq = &broker[id];
+		mq->default_scheduler_messages.emplace(std::move(message));
+		default_scheduler->queue([this, id, mq]() { process_deferred(id, mq); });
+		return;
+	}
+
+	if (s->get_wire_scheduler() == default_scheduler || s->get_wire_scheduler()->out_of_order_execution)
+	{
+		invoke(s, std::move(message), false, timed);
+		return;
+	}
+
+	{
+		std::lock_guard<decltype(broker_lock)> guard(broker_lock);
+		auto it = broker.find(id);
+		if (it != broker.end())
+		{
+			it->second.custom_scheduler_messages.push_back(std::move(message));
+			return;
+		}
+	}
+	invoke(s, std::move(message), false, timed);
 }
 
 void MessageBroker::advise_on(Lifetime lifetime, IRdReactive const* entity) const
@@ -134,13 +206,30 @@ void MessageBroker::advise_on(Lifetime lifetime, IRdReactive const* entity) cons
 	// advise MUST happen under default scheduler, not custom
 	default_scheduler->assert_thread();
 
-	std::lock_guard<decltype(lock)> guard(lock);
-	if (!lifetime->is_terminated())
+	if (lifetime->is_terminated())
 	{
-		auto key = entity->get_id();
-		IRdReactive const* value = entity;
-		subscriptions[key] = value;
-		lifetime->add_action([this, key]() { subscriptions.erase(key); });
+		return;
 	}
+
+	auto key = entity->get_id();
+	if (metrics != nullptr && metrics->is_enabled())
+	{
+		metrics->set_location(key, to_string(entity->get_location()));
+	}
+	auto& shard = shard_of(key);
+	{
+		std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+		shard.subscriptions[key] = entity;
+	}
+	lifetime->add_action([this, &shard, key]() {
+		{
+			std::lock_guard<decltype(shard.lock)> guard(shard.lock);
+			shard.subscriptions.erase(key);
+		}
+		if (metrics != nullptr)
+		{
+			metrics->remove(key);
+		}
+	});
 }
 }	 // namespace rd
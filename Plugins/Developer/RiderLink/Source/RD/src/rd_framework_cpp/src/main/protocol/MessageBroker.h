@@ -4,15 +4,23 @@
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable:4251)
+#pragma warning(disable:4324)
 #endif
 
 #include "base/IRdReactive.h"
+#include "base/TraceRing.h"
+#include "base/WireMetrics.h"
 
 #include "std/unordered_map.h"
 
 #include "spdlog/spdlog.h"
 
+#include <array>
+#include <chrono>
+#include <deque>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 #include <rd_framework_export.h>
 
@@ -41,20 +49,72 @@ public:
 class RD_FRAMEWORK_API MessageBroker final
 {
 private:
+	static constexpr size_t SUBSCRIPTION_SHARDS = 16;
+
+	/**
+	 * \brief Part of the subscription table. Dispatch only contends with advise/unadvise of entities that fall
+	 * into the same shard.
+	 */
+	struct alignas(64) SubscriptionShard
+	{
+		std::mutex lock;
+		rd::unordered_map<RdId, IRdReactive const*> subscriptions;
+	};
+
+	/**
+	 * \brief Pooled closure state for delivering one message on the wire scheduler. Queued action captures only
+	 * the pointer to it, so it fits into std::function's small buffer and no allocation happens per message.
+	 */
+	struct DispatchTask
+	{
+		MessageBroker const* owner = nullptr;
+		IRdReactive const* that = nullptr;
+		RdId id;
+		Buffer message{Buffer::ByteArray{}};
+		/**
+		 * \brief Whether metrics were enabled when the message came, then [queued_at] is when it was handed to the wire
+		 * scheduler.
+		 */
+		bool timed = false;
+		std::chrono::steady_clock::time_point queued_at{};
+
+		void operator()();
+	};
+
 	IScheduler* default_scheduler = nullptr;
-	mutable rd::unordered_map<RdId, IRdReactive const*> subscriptions;
+	WireMetrics* metrics = nullptr;
+	TraceRing* trace_ring = nullptr;
+	mutable std::array<SubscriptionShard, SUBSCRIPTION_SHARDS> shards;
+
+	mutable std::recursive_mutex broker_lock;
 	mutable rd::unordered_map<RdId, Mq> broker;
 
-	mutable std::recursive_mutex lock;
+	mutable std::mutex pool_lock;
+	mutable std::deque<DispatchTask> task_storage;
+	mutable std::vector<DispatchTask*> free_tasks;
 
 	static std::shared_ptr<spdlog::logger> logger;
 
-	void invoke(const IRdReactive* that, Buffer msg, bool sync = false) const;
+	SubscriptionShard& shard_of(RdId const& id) const;
+
+	IRdReactive const* find_subscription(RdId const& id) const;
+
+	DispatchTask* acquire_task() const;
+
+	void release_task(DispatchTask* task) const;
+
+	void invoke(const IRdReactive* that, Buffer msg, bool sync = false, bool timed = false) const;
+
+	void process_deferred(RdId id, Mq* mq) const;
 
 public:
 	// region ctor/dtor
 
-	explicit MessageBroker(IScheduler* defaultScheduler);
+	explicit MessageBroker(IScheduler* defaultScheduler, WireMetrics* metrics = nullptr, TraceRing* trace_ring = nullptr);
+
+	MessageBroker(MessageBroker const&) = delete;
+
+	MessageBroker& operator=(MessageBroker const&) = delete;
 	// endregion
 
 	void dispatch(RdId id, Buffer message) const;
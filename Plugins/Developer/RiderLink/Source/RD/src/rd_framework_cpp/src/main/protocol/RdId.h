@@ -13,6 +13,19 @@
 #include <memory>
 #include <rd_framework_export.h>
 
+/**
+ * \brief A string literal as a [util::hash_suffix] computed at compile time, for generated code to mix the names of
+ * child entities into ids without hashing them at run time: id.mix(RD_ID_SUFFIX(".name")) == id.mix(".name").
+ *
+ * The models under RiderLink/Public/Model were edited by hand to use it, rd-gen isn't in this tree. Regenerating them
+ * with a template that still emits id.mix(".name") reverts the edits, which keeps the ids and only loses the speed-up.
+ */
+#define RD_ID_SUFFIX(literal)                                       \
+	[] {                                                            \
+		constexpr ::rd::util::hash_suffix rd_id_suffix(literal);    \
+		return rd_id_suffix;                                        \
+	}()
+
 namespace rd
 {
 class RdId;
@@ -70,6 +83,9 @@ public:
 
 	static RdId read(Buffer& buffer);
 
+	/**
+	 * \brief Fixed-width in compact mode too: ids are mixed hashes, so a varint would take 9-10 bytes instead of 8.
+	 */
 	void write(Buffer& buffer) const;
 
 	constexpr hash_t get_hash() const
@@ -98,6 +114,14 @@ public:
 		return RdId(util::getPlatformIndependentHash(tail, static_cast<util::constexpr_hash_t>(hash)));
 	}
 
+	/**
+	 * \brief Same as mixing the string [tail] was made of, see [RD_ID_SUFFIX].
+	 */
+	constexpr RdId mix(util::hash_suffix const& tail) const
+	{
+		return RdId(tail.apply(static_cast<util::constexpr_hash_t>(hash)));
+	}
+
 	/*constexpr RdId mix(int32_t tail) const {
 		return RdId(util::getPlatformIndependentHash(tail, static_cast<util::constexpr_hash_t>(hash)));
 	}
@@ -0,0 +1,11 @@
+#include "MpscScheduler.h"
+
+#include <utility>
+
+namespace rd
+{
+MpscScheduler::MpscScheduler(Lifetime lifetime, std::string name) : MpscSchedulerBase(std::move(name)), lifetime(lifetime)
+{
+	lifetime->add_action([this]() { stop(); });
+}
+}	 // namespace rd
@@ -0,0 +1,25 @@
+#ifndef RD_CPP_MPSCSCHEDULER_H
+#define RD_CPP_MPSCSCHEDULER_H
+
+#include "base/MpscSchedulerBase.h"
+
+#include "lifetime/Lifetime.h"
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Drop-in replacement for [SingleThreadScheduler]: the worker finishes already queued tasks and stops
+ * when [lifetime] terminates.
+ */
+class RD_FRAMEWORK_API MpscScheduler : public MpscSchedulerBase
+{
+public:
+	Lifetime lifetime;
+
+	MpscScheduler(Lifetime lifetime, std::string name);
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_MPSCSCHEDULER_H
@@ -0,0 +1,432 @@
+#include "TimerWheel.h"
+
+#include <util/thread_util.h>
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace rd
+{
+std::shared_ptr<spdlog::logger> TimerWheel::logger =
+	spdlog::stderr_color_mt<spdlog::synchronous_factory>("timerWheelLog", spdlog::color_mode::automatic);
+
+constexpr TimerWheel::timer_id TimerWheel::INVALID_TIMER;
+constexpr int32_t TimerWheel::LEVELS;
+constexpr int32_t TimerWheel::SLOT_BITS;
+constexpr int32_t TimerWheel::SLOTS;
+constexpr uint64_t TimerWheel::SLOT_MASK;
+constexpr uint64_t TimerWheel::MAX_DELAY_TICKS;
+
+namespace
+{
+int32_t lowest_bit(uint64_t x)
+{
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward64(&index, x);
+	return static_cast<int32_t>(index);
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+uint64_t rotate_right(uint64_t x, uint64_t n)
+{
+	return n == 0 ? x : (x >> n) | (x << (64 - n));
+}
+}	 // namespace
+
+TimerWheel::TimerWheel() = default;
+
+TimerWheel::~TimerWheel()
+{
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		stopping = true;
+	}
+	wakeup_cv.notify_all();
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+TimerWheel& TimerWheel::Instance()
+{
+	static TimerWheel globalTimerWheel;
+	return globalTimerWheel;
+}
+
+void TimerWheel::splice(Link* from, Link* to)
+{
+	if (from->next == from)
+	{
+		return;
+	}
+	from->next->prev = to->prev;
+	to->prev->next = from->next;
+	from->prev->next = to;
+	to->prev = from->prev;
+	from->next = from->prev = from;
+}
+
+void TimerWheel::unlink(Node* node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->next = node->prev = node;
+	if (node->level >= 0)
+	{
+		Link const& head = wheel[node->level][node->slot];
+		if (head.next == &head)
+		{
+			occupied[node->level] &= ~(uint64_t(1) << node->slot);
+		}
+		node->level = -1;
+	}
+}
+
+uint64_t TimerWheel::current_tick() const
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<duration_t>(std::chrono::steady_clock::now() - origin).count());
+}
+
+TimerWheel::Node* TimerWheel::lookup(timer_id id)
+{
+	const auto index = static_cast<size_t>(id >> 32);
+	const auto generation = static_cast<uint32_t>(id);
+	if (index >= nodes.size())
+	{
+		return nullptr;
+	}
+	Node* node = &nodes[index];
+	return node->armed && node->generation == generation ? node : nullptr;
+}
+
+void TimerWheel::place(Node* node, uint64_t earliest)
+{
+	const uint64_t delta = (std::min)((std::max)(node->expiry, earliest) - now_tick, MAX_DELAY_TICKS);
+	const uint64_t target = now_tick + delta;
+
+	int32_t level = 0;
+	while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1))))
+	{
+		++level;
+	}
+	const uint64_t slot = (target >> (SLOT_BITS * level)) & SLOT_MASK;
+
+	Link* head = &wheel[level][slot];
+	node->next = head;
+	node->prev = head->prev;
+	head->prev->next = node;
+	head->prev = node;
+	node->level = level;
+	node->slot = slot;
+	occupied[level] |= uint64_t(1) << slot;
+}
+
+void TimerWheel::cascade(int32_t level, uint64_t slot)
+{
+	Link pending;
+	splice(&wheel[level][slot], &pending);
+	occupied[level] &= ~(uint64_t(1) << slot);
+
+	while (pending.next != &pending)
+	{
+		Node* node = static_cast<Node*>(pending.next);
+		node->level = -1;
+		unlink(node);
+		// timers due right now land in the current slot, which is expired after cascading
+		place(node, now_tick);
+	}
+}
+
+void TimerWheel::expire(std::unique_lock<std::mutex>& guard, uint64_t slot)
+{
+	Link pending;
+	splice(&wheel[0][slot], &pending);
+	occupied[0] &= ~(uint64_t(1) << slot);
+	for (Link* it = pending.next; it != &pending; it = it->next)
+	{
+		static_cast<Node*>(it)->level = -1;
+	}
+
+	// nodes stay linked into [pending] until their turn, so cancel can still take them out meanwhile
+	while (pending.next != &pending)
+	{
+		Node* node = static_cast<Node*>(pending.next);
+		unlink(node);
+		if (node->expiry > now_tick)
+		{
+			place(node, now_tick + 1);
+			continue;
+		}
+
+		node->running = true;
+		guard.unlock();
+		try
+		{
+			node->action();
+		}
+		catch (std::exception const& e)
+		{
+			logger->error("Timer action failed | {}", e.what());
+		}
+		guard.lock();
+		node->running = false;
+
+		const bool cancelled = node->cancelled;
+		action_t dead;
+		if (node->period > 0 && !cancelled)
+		{
+			node->expiry = now_tick + node->period;
+			place(node, now_tick + 1);
+		}
+		else
+		{
+			dead = release(node);
+		}
+		if (cancelled)
+		{
+			cancel_cv.notify_all();
+		}
+		if (dead)
+		{
+			// captured state may do anything on destruction, don't hold the lock for it
+			guard.unlock();
+			dead = nullptr;
+			guard.lock();
+		}
+	}
+}
+
+void TimerWheel::advance(std::unique_lock<std::mutex>& guard, uint64_t target)
+{
+	while (now_tick < target)
+	{
+		if (armed_count == 0)
+		{
+			now_tick = target;
+			return;
+		}
+		if (occupied[0] == 0)
+		{
+			// nothing to expire before the next cascade
+			const uint64_t boundary = (now_tick | SLOT_MASK) + 1;
+			if (boundary > target)
+			{
+				now_tick = target;
+				return;
+			}
+			now_tick = boundary;
+		}
+		else
+		{
+			++now_tick;
+		}
+
+		const uint64_t slot = now_tick & SLOT_MASK;
+		if (slot == 0)
+		{
+			int32_t top = 1;
+			while (top < LEVELS - 1 && ((now_tick >> (SLOT_BITS * top)) & SLOT_MASK) == 0)
+			{
+				++top;
+			}
+			for (int32_t level = top; level >= 1; --level)
+			{
+				cascade(level, (now_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+			}
+		}
+		if (occupied[0] & (uint64_t(1) << slot))
+		{
+			expire(guard, slot);
+		}
+	}
+}
+
+uint64_t TimerWheel::next_expiry() const
+{
+	uint64_t result = UINT64_MAX;
+	if (occupied[0] != 0)
+	{
+		const uint64_t from = (now_tick + 1) & SLOT_MASK;
+		result = now_tick + 1 + lowest_bit(rotate_right(occupied[0], from));
+	}
+	for (int32_t level = 1; level < LEVELS; ++level)
+	{
+		if (occupied[level] == 0)
+		{
+			continue;
+		}
+		// slot of this level is cascaded when the lower levels wrap around to it
+		const int32_t shift = SLOT_BITS * level;
+		const uint64_t boundary = ((now_tick >> shift) + 1) << shift;
+		const uint64_t from = (boundary >> shift) & SLOT_MASK;
+		const uint64_t cascade_tick = boundary + (uint64_t(lowest_bit(rotate_right(occupied[level], from))) << shift);
+		result = (std::min)(result, cascade_tick);
+	}
+	return result;
+}
+
+TimerWheel::action_t TimerWheel::release(Node* node)
+{
+	action_t action = std::move(node->action);
+	node->armed = false;
+	node->cancelled = false;
+	if (++node->generation == 0)
+	{
+		node->generation = 1;
+	}
+	--armed_count;
+	free_nodes.push_back(node);
+	return action;
+}
+
+TimerWheel::timer_id TimerWheel::arm(duration_t delay, duration_t period, action_t action)
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+
+	if (!worker.joinable())
+	{
+		worker = std::thread([this] { run(); });
+		worker_id = worker.get_id();
+	}
+	if (armed_count == 0)
+	{
+		// the wheel is empty, so skip the idle time instead of walking through it
+		now_tick = (std::max)(now_tick, current_tick());
+	}
+
+	Node* node = nullptr;
+	if (free_nodes.empty())
+	{
+		nodes.emplace_back();
+		node = &nodes.back();
+		node->index = static_cast<uint32_t>(nodes.size() - 1);
+	}
+	else
+	{
+		node = free_nodes.back();
+		free_nodes.pop_back();
+	}
+
+	// the current tick is partially elapsed already, count from the next one so timers never fire early
+	node->expiry = current_tick() + 1 + static_cast<uint64_t>((std::max)(delay.count(), duration_t::rep(0)));
+	node->period = static_cast<uint64_t>((std::max)(period.count(), duration_t::rep(0)));
+	node->armed = true;
+	node->action = std::move(action);
+	place(node, now_tick + 1);
+	++armed_count;
+
+	if (node->expiry < wakeup_tick)
+	{
+		wakeup_cv.notify_one();
+	}
+	return (static_cast<timer_id>(node->index) << 32) | node->generation;
+}
+
+void TimerWheel::run()
+{
+	rd::util::set_thread_name("TimerWheel Thread");
+
+	std::unique_lock<decltype(lock)> guard(lock);
+	while (!stopping)
+	{
+		advance(guard, current_tick());
+		if (stopping)
+		{
+			break;
+		}
+		if (armed_count == 0)
+		{
+			wakeup_tick = UINT64_MAX;
+			wakeup_cv.wait(guard);
+		}
+		else
+		{
+			wakeup_tick = next_expiry();
+			wakeup_cv.wait_until(guard, origin + duration_t(wakeup_tick));
+		}
+		// arming doesn't need to wake the thread while it's awake anyway
+		wakeup_tick = 0;
+	}
+}
+
+TimerWheel::timer_id TimerWheel::schedule(duration_t delay, action_t action)
+{
+	return arm(delay, duration_t(0), std::move(action));
+}
+
+TimerWheel::timer_id TimerWheel::schedule_periodic(duration_t period, action_t action)
+{
+	return arm(period, (std::max)(period, duration_t(1)), std::move(action));
+}
+
+void TimerWheel::schedule(Lifetime lifetime, duration_t delay, action_t action)
+{
+	if (lifetime->is_terminated())
+	{
+		return;
+	}
+	const timer_id id = schedule(delay, std::move(action));
+	try
+	{
+		lifetime->add_action([this, id] { cancel(id); });
+	}
+	catch (std::invalid_argument const&)
+	{
+		// terminated concurrently
+		cancel(id);
+	}
+}
+
+void TimerWheel::schedule_periodic(Lifetime lifetime, duration_t period, action_t action)
+{
+	if (lifetime->is_terminated())
+	{
+		return;
+	}
+	const timer_id id = schedule_periodic(period, std::move(action));
+	try
+	{
+		lifetime->add_action([this, id] { cancel(id); });
+	}
+	catch (std::invalid_argument const&)
+	{
+		cancel(id);
+	}
+}
+
+bool TimerWheel::cancel(timer_id id)
+{
+	action_t dead;
+	{
+		std::unique_lock<decltype(lock)> guard(lock);
+		Node* node = lookup(id);
+		if (node == nullptr)
+		{
+			return false;
+		}
+		if (node->running)
+		{
+			// released by the timer thread as soon as the action returns
+			node->cancelled = true;
+			if (std::this_thread::get_id() != worker_id)
+			{
+				const uint32_t generation = node->generation;
+				cancel_cv.wait(guard, [node, generation] { return node->generation != generation; });
+			}
+			return true;
+		}
+		unlink(node);
+		dead = release(node);
+	}
+	return true;
+}
+}	 // namespace rd
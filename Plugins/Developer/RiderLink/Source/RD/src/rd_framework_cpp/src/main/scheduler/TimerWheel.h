@@ -0,0 +1,176 @@
+#ifndef RD_CPP_TIMERWHEEL_H
+#define RD_CPP_TIMERWHEEL_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "lifetime/Lifetime.h"
+#include "util/small_function.h"
+#include "spdlog/spdlog.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Process-wide hierarchical timer wheel (Varghese & Lauck). All timers of the process share one thread,
+ * which sleeps until the nearest expiry. Arming and cancelling are O(1): timers live in intrusive lists hanging
+ * off 4 levels of 64 slots with a tick of 1ms, so anything up to ~4.6 hours is placed without sorting;
+ * longer delays are re-placed when their slot cascades.
+ *
+ * Actions run on the timer thread one by one and must stay short: blocking there delays every other timer.
+ */
+class RD_FRAMEWORK_API TimerWheel
+{
+public:
+	using action_t = util::small_function<void(), 64>;
+	using duration_t = std::chrono::milliseconds;
+
+	/**
+	 * \brief Handle of an armed timer. Stale handles (timer fired or cancelled) are recognised by generation.
+	 */
+	using timer_id = uint64_t;
+
+	static constexpr timer_id INVALID_TIMER = 0;
+
+private:
+	static constexpr int32_t LEVELS = 4;
+	static constexpr int32_t SLOT_BITS = 6;
+	static constexpr int32_t SLOTS = 1 << SLOT_BITS;
+	static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+	static constexpr uint64_t MAX_DELAY_TICKS = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+
+	struct Link
+	{
+		Link* prev = this;
+		Link* next = this;
+	};
+
+	struct Node : Link
+	{
+		uint32_t index = 0;
+		uint32_t generation = 1;
+
+		/**
+		 * \brief Level and slot of the list the node is linked into, [level] is -1 outside the wheel.
+		 */
+		int32_t level = -1;
+		uint64_t slot = 0;
+
+		uint64_t expiry = 0;
+		uint64_t period = 0;
+		bool armed = false;
+		bool running = false;
+		bool cancelled = false;
+
+		action_t action;
+	};
+
+	static std::shared_ptr<spdlog::logger> logger;
+
+	std::mutex lock;
+	std::condition_variable wakeup_cv;
+	std::condition_variable cancel_cv;
+
+	std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+	uint64_t now_tick = 0;
+	uint64_t wakeup_tick = UINT64_MAX;
+	int32_t armed_count = 0;
+
+	std::array<std::array<Link, SLOTS>, LEVELS> wheel;
+	std::array<uint64_t, LEVELS> occupied{};
+
+	std::deque<Node> nodes;
+	std::vector<Node*> free_nodes;
+
+	bool stopping = false;
+	std::thread worker;
+	std::thread::id worker_id;
+
+	static void splice(Link* from, Link* to);
+
+	void unlink(Node* node);
+
+	uint64_t current_tick() const;
+
+	Node* lookup(timer_id id);
+
+	void place(Node* node, uint64_t earliest);
+
+	void cascade(int32_t level, uint64_t slot);
+
+	void expire(std::unique_lock<std::mutex>& guard, uint64_t slot);
+
+	void advance(std::unique_lock<std::mutex>& guard, uint64_t target);
+
+	uint64_t next_expiry() const;
+
+	action_t release(Node* node);
+
+	timer_id arm(duration_t delay, duration_t period, action_t action);
+
+	void run();
+
+	// region ctor/dtor
+
+	TimerWheel();
+
+	~TimerWheel();
+	// endregion
+
+public:
+	TimerWheel(TimerWheel const&) = delete;
+
+	TimerWheel& operator=(TimerWheel const&) = delete;
+
+	/**
+	 * \brief Runs [action] once after [delay].
+	 */
+	timer_id schedule(duration_t delay, action_t action);
+
+	/**
+	 * \brief Runs [action] every [period] until cancelled, first time after one [period].
+	 */
+	timer_id schedule_periodic(duration_t period, action_t action);
+
+	/**
+	 * \brief Same as [schedule], timer is cancelled on termination of [lifetime].
+	 */
+	void schedule(Lifetime lifetime, duration_t delay, action_t action);
+
+	/**
+	 * \brief Same as [schedule_periodic], timer is cancelled on termination of [lifetime].
+	 */
+	void schedule_periodic(Lifetime lifetime, duration_t period, action_t action);
+
+	/**
+	 * \brief Disarms the timer. If its action is running right now, waits for it to finish, unless called from
+	 * the action itself. No action of this timer runs after return.
+	 *
+	 * \return false if the timer has already fired or been cancelled.
+	 */
+	bool cancel(timer_id id);
+
+	/**
+	 * \brief The timer wheel for whole application.
+	 */
+	static TimerWheel& Instance();
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_TIMERWHEEL_H
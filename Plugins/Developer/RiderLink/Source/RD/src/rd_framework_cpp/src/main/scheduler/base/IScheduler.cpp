@@ -28,4 +28,9 @@ void IScheduler::invoke_or_queue(std::function<void()> action)
 		queue(action);
 	}
 }
+
+int64_t IScheduler::get_queue_depth() const
+{
+	return 0;
+}
 }	 // namespace rd
@@ -6,6 +6,7 @@
 #pragma warning(disable:4251)
 #endif
 
+#include <cstdint>
 #include <functional>
 #include <thread>
 
@@ -51,6 +52,11 @@ public:
 
 	virtual bool is_active() const = 0;
 
+	/**
+	 * \brief Number of queued actions which haven't finished yet, 0 for schedulers running actions in place.
+	 */
+	virtual int64_t get_queue_depth() const;
+
 	std::thread::id get_thread_id() const
 	{
 		return thread_id;
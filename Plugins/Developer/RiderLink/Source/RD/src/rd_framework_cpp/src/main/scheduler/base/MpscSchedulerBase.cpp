@@ -0,0 +1,208 @@
+#include "MpscSchedulerBase.h"
+
+#include "util/core_util.h"
+#include <util/thread_util.h>
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+namespace rd
+{
+constexpr int32_t MpscSchedulerBase::BATCH_SIZE;
+constexpr uint32_t MpscSchedulerBase::SLAB_SIZE;
+constexpr uint32_t MpscSchedulerBase::NO_TASK;
+
+MpscSchedulerBase::MpscSchedulerBase(std::string name)
+	: log(spdlog::stderr_color_mt<spdlog::synchronous_factory>(name, spdlog::color_mode::automatic)), name(std::move(name)),
+	  slab(new Task[SLAB_SIZE])
+{
+	for (uint32_t i = 0; i < SLAB_SIZE; ++i)
+	{
+		slab[i].next_free.store(i + 1 < SLAB_SIZE ? i + 1 : NO_TASK, std::memory_order_relaxed);
+	}
+	free_top.store(0);
+
+	worker = std::thread([this] { run(); });
+	thread_id = worker.get_id();
+}
+
+MpscSchedulerBase::~MpscSchedulerBase()
+{
+	stop();
+
+	// tasks queued after stop are dropped, same as the thread pool did
+	while (Task* task = tasks.pop())
+	{
+		release(task);
+	}
+}
+
+MpscSchedulerBase::Task* MpscSchedulerBase::acquire()
+{
+	uint64_t top = free_top.load(std::memory_order_acquire);
+	while (static_cast<uint32_t>(top) != NO_TASK)
+	{
+		Task* task = &slab[static_cast<uint32_t>(top)];
+		const uint64_t next = ((top >> 32) + 1) << 32 | task->next_free.load(std::memory_order_relaxed);
+		if (free_top.compare_exchange_weak(top, next, std::memory_order_acquire, std::memory_order_acquire))
+		{
+			return task;
+		}
+	}
+	return new Task;
+}
+
+void MpscSchedulerBase::release(Task* task)
+{
+	task->action = nullptr;
+	if (task < slab.get() || task >= slab.get() + SLAB_SIZE)
+	{
+		delete task;
+		return;
+	}
+
+	const auto index = static_cast<uint32_t>(task - slab.get());
+	uint64_t top = free_top.load(std::memory_order_relaxed);
+	do
+	{
+		task->next_free.store(static_cast<uint32_t>(top), std::memory_order_relaxed);
+	} while (!free_top.compare_exchange_weak(top, (top >> 32) << 32 | index, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void MpscSchedulerBase::push(action_t action)
+{
+	Task* task = acquire();
+	task->action = std::move(action);
+
+	tasks_queued.fetch_add(1);
+	tasks.push(task);
+
+	if (sleeping.load())
+	{
+		std::lock_guard<decltype(wakeup_lock)> guard(wakeup_lock);
+		wakeup_cv.notify_one();
+	}
+}
+
+int32_t MpscSchedulerBase::drain()
+{
+	int32_t executed = 0;
+	while (executed < BATCH_SIZE)
+	{
+		Task* task = tasks.pop();
+		if (task == nullptr)
+		{
+			break;
+		}
+		try
+		{
+			task->action();
+		}
+		catch (std::exception const& e)
+		{
+			log->error("Background task failed, scheduler={} | {}", name, e.what());
+		}
+		release(task);
+		++executed;
+	}
+	return executed;
+}
+
+void MpscSchedulerBase::run()
+{
+	rd::util::set_thread_name(name.empty() ? "MpscScheduler Thread" : name.c_str());
+
+	uint64_t popped = 0;
+	while (true)
+	{
+		const int32_t executed = drain();
+		if (executed > 0)
+		{
+			popped += executed;
+			tasks_completed.fetch_add(executed);
+			if (flush_waiters.load() > 0)
+			{
+				std::lock_guard<decltype(flush_lock)> guard(flush_lock);
+				flush_cv.notify_all();
+			}
+			continue;
+		}
+
+		if (popped != tasks_queued.load())
+		{
+			// producer has counted its task but hasn't linked it yet
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<decltype(wakeup_lock)> guard(wakeup_lock);
+		sleeping.store(true);
+		while (popped == tasks_queued.load() && !stopping.load())
+		{
+			wakeup_cv.wait(guard);
+		}
+		sleeping.store(false);
+		if (popped == tasks_queued.load() && stopping.load())
+		{
+			break;
+		}
+	}
+
+	// release flushes which would otherwise wait for tasks nobody is going to run
+	std::lock_guard<decltype(flush_lock)> flush_guard(flush_lock);
+	finished.store(true);
+	flush_cv.notify_all();
+}
+
+void MpscSchedulerBase::stop()
+{
+	{
+		std::lock_guard<decltype(wakeup_lock)> guard(wakeup_lock);
+		stopping.store(true);
+		wakeup_cv.notify_one();
+	}
+
+	if (!worker.joinable())
+	{
+		return;
+	}
+	if (is_active())
+	{
+		log->error("Failed to terminate {}: can't join from its own thread", name);
+		return;
+	}
+	worker.join();
+}
+
+void MpscSchedulerBase::flush()
+{
+	RD_ASSERT_MSG(!is_active(), "Can't flush this scheduler in a reentrant way: we are inside queued item's execution");
+
+	const uint64_t target = tasks_queued.load();
+	if (tasks_completed.load() >= target)
+	{
+		return;
+	}
+
+	std::unique_lock<decltype(flush_lock)> guard(flush_lock);
+	++flush_waiters;
+	flush_cv.wait(guard, [this, target] { return tasks_completed.load() >= target || finished.load(); });
+	--flush_waiters;
+}
+
+void MpscSchedulerBase::queue(std::function<void()> action)
+{
+	push(action_t(std::move(action)));
+}
+
+bool MpscSchedulerBase::is_active() const
+{
+	return thread_id == std::this_thread::get_id();
+}
+
+int64_t MpscSchedulerBase::get_queue_depth() const
+{
+	// completed first, tasks are counted as queued before they can complete
+	const uint64_t completed = tasks_completed.load();
+	return static_cast<int64_t>(tasks_queued.load() - completed);
+}
+}	 // namespace rd
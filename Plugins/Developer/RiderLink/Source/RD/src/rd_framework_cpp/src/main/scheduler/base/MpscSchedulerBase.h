@@ -0,0 +1,130 @@
+#ifndef RD_CPP_MPSCSCHEDULERBASE_H
+#define RD_CPP_MPSCSCHEDULERBASE_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "scheduler/base/IScheduler.h"
+#include "util/mpsc_queue.h"
+#include "util/small_function.h"
+#include "spdlog/spdlog.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Single thread scheduler on top of an intrusive lock-free MPSC queue. Queueing never takes a lock unless
+ * the worker sleeps, the worker drains tasks in batches and flush() blocks instead of spinning.
+ */
+class RD_FRAMEWORK_API MpscSchedulerBase : public IScheduler
+{
+public:
+	using action_t = util::small_function<void(), 64>;
+
+protected:
+	std::shared_ptr<spdlog::logger> log;
+	std::string name;
+
+	static constexpr int32_t BATCH_SIZE = 256;
+
+	static constexpr uint32_t SLAB_SIZE = 1024;
+	static constexpr uint32_t NO_TASK = UINT32_MAX;
+
+	struct Task
+	{
+		std::atomic<Task*> next{nullptr};
+		action_t action;
+		/**
+		 * \brief Index of the next free slab task while this one is free.
+		 */
+		std::atomic<uint32_t> next_free{NO_TASK};
+	};
+
+	util::intrusive_mpsc_queue<Task> tasks;
+
+	/**
+	 * \brief Tasks are taken from here and given back once run, so that queueing doesn't allocate while fewer than
+	 * [SLAB_SIZE] tasks are pending, beyond that they are allocated one by one.
+	 */
+	std::unique_ptr<Task[]> slab;
+	/**
+	 * \brief Top of the stack of free slab tasks: a pop count in the high half, which makes a pop fail if others
+	 * popped and pushed meanwhile, and the slab index in the low one.
+	 */
+	std::atomic<uint64_t> free_top{NO_TASK};
+
+	Task* acquire();
+
+	void release(Task* task);
+
+	std::atomic<uint64_t> tasks_queued{0};
+	std::atomic<uint64_t> tasks_completed{0};
+
+	std::atomic<bool> stopping{false};
+	std::atomic<bool> finished{false};
+	std::atomic<bool> sleeping{false};
+	std::mutex wakeup_lock;
+	std::condition_variable wakeup_cv;
+
+	std::atomic<int32_t> flush_waiters{0};
+	std::mutex flush_lock;
+	std::condition_variable flush_cv;
+
+	std::thread worker;
+
+	void push(action_t action);
+
+	void run();
+
+	int32_t drain();
+
+	void stop();
+
+public:
+	// region ctor/dtor
+
+	explicit MpscSchedulerBase(std::string name);
+
+	MpscSchedulerBase(MpscSchedulerBase const&) = delete;
+
+	MpscSchedulerBase& operator=(MpscSchedulerBase const&) = delete;
+
+	virtual ~MpscSchedulerBase();
+	// endregion
+
+	void flush() override;
+
+	void queue(std::function<void()> action) override;
+
+	/**
+	 * \brief Queues a callable without wrapping it into std::function first, small closures don't allocate at all.
+	 */
+	template <typename F, typename = typename std::enable_if_t<!std::is_same<std::decay_t<F>, std::function<void()>>::value>>
+	void queue(F&& action)
+	{
+		push(action_t(std::forward<F>(action)));
+	}
+
+	bool is_active() const override;
+
+	int64_t get_queue_depth() const override;
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_MPSCSCHEDULERBASE_H
@@ -57,5 +57,10 @@ bool SingleThreadSchedulerBase::is_active() const
 	return thread_id == std::this_thread::get_id();
 }
 
+int64_t SingleThreadSchedulerBase::get_queue_depth() const
+{
+	return tasks_executing.load();
+}
+
 SingleThreadSchedulerBase::~SingleThreadSchedulerBase() = default;
 }	 // namespace rd
\ No newline at end of file
@@ -54,6 +54,8 @@ public:
 	void queue(std::function<void()> action) override;
 
 	bool is_active() const override;
+
+	int64_t get_queue_depth() const override;
 };
 }	 // namespace rd
 #if defined(_MSC_VER)
@@ -2,8 +2,11 @@
 #define RD_CPP_ARRAYSERIALIZER_H
 
 #include "serialization/SerializationCtx.h"
+#include "serialization/FixedLayout.h"
+#include "serialization/Polymorphic.h"
 #include "framework_traits.h"
 
+#include <type_traits>
 #include <vector>
 
 namespace rd
@@ -12,15 +15,38 @@ template <typename S, template <class, class> class C, typename T = typename uti
 	typename A = allocator<value_or_wrapper<T>>>
 class ArraySerializer
 {
+	// elements [S] writes as their own [write] does, which is what [fixed_layout] describes
+	using bulk = util::bool_constant<is_fixed_layout_v<T> && util::is_same_v<S, Polymorphic<T>>>;
+
+	static C<value_or_wrapper<T>, A> read(SerializationCtx&, Buffer& buffer, std::true_type)
+	{
+		return buffer.read_array<C, T, A>();
+	}
+
+	static C<value_or_wrapper<T>, A> read(SerializationCtx& ctx, Buffer& buffer, std::false_type)
+	{
+		return buffer.read_array<C, T, A>([&] { return S::read(ctx, buffer); });
+	}
+
+	static void write(SerializationCtx&, Buffer& buffer, C<value_or_wrapper<T>, A> const& value, std::true_type)
+	{
+		buffer.write_array<C, T, A>(value);
+	}
+
+	static void write(SerializationCtx& ctx, Buffer& buffer, C<value_or_wrapper<T>, A> const& value, std::false_type)
+	{
+		buffer.write_array<C, T, A>(value, [&](T const& inner_value) { S::write(ctx, buffer, inner_value); });
+	}
+
 public:
 	static C<value_or_wrapper<T>, A> read(SerializationCtx& ctx, Buffer& buffer)
 	{
-		return buffer.read_array<C, T, A>([&] { return S::read(ctx, buffer); });
+		return read(ctx, buffer, bulk{});
 	}
 
 	static void write(SerializationCtx& ctx, Buffer& buffer, C<value_or_wrapper<T>, A> const& value)
 	{
-		buffer.write_array<C, T, A>(value, [&](T const& inner_value) { S::write(ctx, buffer, inner_value); });
+		write(ctx, buffer, value, bulk{});
 	}
 };
 }	 // namespace rd
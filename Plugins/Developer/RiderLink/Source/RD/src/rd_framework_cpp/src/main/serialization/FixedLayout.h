@@ -0,0 +1,67 @@
+#ifndef RD_CPP_FIXEDLAYOUT_H
+#define RD_CPP_FIXEDLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace rd
+{
+/**
+ * \brief Wire layout of a data class all of whose fields are fixed-width scalars written back to back, as its
+ * generated [write] does with [Buffer::write_integral], e.g. StringRange. The generator specializes it for such classes
+ * that aren't open, whose subclasses could write more, so that arrays of them are read and written with one bounds
+ * check for the whole array rather than one per field, see [Buffer::write_array]. A specialization defines:
+ *
+ *     static constexpr size_t size;                       // bytes of one element
+ *     static void store(T const& value, uint8_t* out);    // writes [size] bytes in the order [write] does
+ *     static T load(uint8_t const* in);                   // reads them back
+ */
+template <typename T, typename = void>
+struct fixed_layout
+{
+};
+
+template <typename T, typename = void>
+struct is_fixed_layout : std::false_type
+{
+};
+
+template <typename T>
+struct is_fixed_layout<T, decltype(static_cast<void>(fixed_layout<T>::size))> : std::true_type
+{
+};
+
+template <typename T>
+constexpr bool is_fixed_layout_v = is_fixed_layout<T>::value;
+
+namespace fixed_layout_util
+{
+/**
+ * \brief Writes [value] at [out] as [Buffer::write_integral] does and returns the position after it.
+ */
+template <typename F>
+uint8_t* store(uint8_t* out, F value)
+{
+	static_assert(std::is_arithmetic<F>::value, "fixed layout fields are scalars");
+	std::memcpy(out, &value, sizeof(F));
+	return out + sizeof(F);
+}
+
+/**
+ * \brief Reads a field written by [store] at [in] and advances [in] past it.
+ */
+template <typename F>
+F load(uint8_t const*& in)
+{
+	static_assert(std::is_arithmetic<F>::value, "fixed layout fields are scalars");
+	F value;
+	std::memcpy(&value, in, sizeof(F));
+	in += sizeof(F);
+	return value;
+}
+}	 // namespace fixed_layout_util
+}	 // namespace rd
+
+#endif	  // RD_CPP_FIXEDLAYOUT_H
@@ -81,7 +81,7 @@ Wrapper<T> SerializationCtx::readInterned(Buffer& buffer, std::function<T(Serial
 	auto it = intern_roots.find(InternKey);
 	if (it != intern_roots.end())
 	{
-		int32_t index = buffer.read_integral<int32_t>() ^ 1;
+		int32_t index = buffer.read_compact_integral<int32_t>() ^ 1;
 		return it->second->un_intern_value<T>(index);
 	}
 	else
@@ -97,7 +97,7 @@ void SerializationCtx::writeInterned(Buffer& buffer, const Wrapper<T>& value, F&
 	if (it != intern_roots.end())
 	{
 		int32_t index = it->second->intern_value<T>(value);
-		buffer.write_integral<int32_t>(index);
+		buffer.write_compact_integral<int32_t>(index);
 	}
 	else
 	{
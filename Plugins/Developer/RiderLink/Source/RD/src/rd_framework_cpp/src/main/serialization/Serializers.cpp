@@ -46,5 +46,18 @@ void Serializers::register_in()
 Serializers::Serializers()
 {
 	register_in();
+	build_dispatch();
+}
+
+void Serializers::build_dispatch() const
+{
+	std::vector<std::pair<int64_t, reader_t>> entries;
+	entries.reserve(readers.size());
+	for (auto const& it : readers)
+	{
+		entries.emplace_back(it.first.get_hash(), it.second);
+	}
+	dispatch_tables.push_back(std::make_unique<dispatch_table_t>(entries));
+	dispatch.store(dispatch_tables.back().get(), std::memory_order_release);
 }
 }	 // namespace rd
@@ -15,10 +15,14 @@
 #include "DefaultAbstractDeclaration.h"
 
 #include "std/unordered_map.h"
+#include "util/perfect_hash_table.h"
 
+#include <atomic>
+#include <memory>
 #include <utility>
 #include <iostream>
 #include <unordered_set>
+#include <vector>
 
 #include <rd_framework_export.h>
 
@@ -46,11 +50,31 @@ private:
 
 	void register_in();
 
-	mutable rd::unordered_map<RdId, std::function<InternedAny(SerializationCtx&, Buffer&)>> readers;
+	using reader_t = InternedAny (*)(SerializationCtx&, Buffer&);
+
+	using dispatch_table_t = util::perfect_hash_table<reader_t>;
+
+	/**
+	 * \brief All registered readers, [readAny] looks here for the types registered after [build_dispatch].
+	 */
+	mutable rd::unordered_map<RdId, reader_t> readers;
+
+	/**
+	 * \brief Readers as of the last [build_dispatch]. Replaced tables are kept, a concurrent [readAny] may still use one.
+	 */
+	mutable std::atomic<dispatch_table_t const*> dispatch{nullptr};
+
+	mutable std::vector<std::unique_ptr<dispatch_table_t>> dispatch_tables;
 
 public:
 	Serializers();
 
+	/**
+	 * \brief Builds a perfect hash table of the readers registered so far, so [readAny] finds them with one probe.
+	 * Called once a serializers owner registered its types; like [registry], it mustn't run concurrently with itself.
+	 */
+	void build_dispatch() const;
+
 	template <typename T, typename = typename std::enable_if_t<util::is_base_of_v<IPolymorphicSerializable, T>>>
 	void registry() const;
 
@@ -85,8 +109,8 @@ void Serializers::registry() const
 
 	RD_ASSERT_MSG(readers.count(id) == 0, "Can't register " + type_name + " with id: " + to_string(id));
 
-	readers[id] = [](SerializationCtx& ctx, Buffer& buffer) -> Wrapper<IPolymorphicSerializable> {
-		return wrapper::make_wrapper<T>(T::read(ctx, buffer));
+	readers[id] = [](SerializationCtx& ctx, Buffer& buffer) -> InternedAny {
+		return {Wrapper<IPolymorphicSerializable>(wrapper::make_wrapper<T>(T::read(ctx, buffer)))};
 	};
 }
 
@@ -101,12 +125,16 @@ optional<InternedAny> Serializers::readAny(SerializationCtx& ctx, Buffer& buffer
 	int32_t size = buffer.read_integral<int32_t>();
 	buffer.check_available(static_cast<size_t>(size));
 
-	if (readers.count(id) == 0)
+	if (reader_t const* reader = dispatch.load(std::memory_order_acquire)->find(id.get_hash()))
+	{
+		return (*reader)(ctx, buffer);
+	}
+	auto it = readers.find(id);
+	if (it == readers.end())
 	{
 		return any::make_interned_any<T>(T::readUnknownInstance(ctx, buffer, id, size));
 	}
-	auto const& reader = readers.at(id);
-	return reader(ctx, buffer);
+	return it->second(ctx, buffer);
 }
 
 template <typename T>
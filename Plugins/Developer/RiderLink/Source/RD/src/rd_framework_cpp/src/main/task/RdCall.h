@@ -7,7 +7,8 @@
 #include "scheduler/SynchronousScheduler.h"
 #include "WiredRdTask.h"
 
-#include <thread>
+#include <stdexcept>
+#include <string>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -64,7 +65,8 @@ public:
 	}
 
 	/**
-	 * \brief Invokes the API with the parameters given as [request] and waits for the result.
+	 * \brief Invokes the API with the parameters given as [request] and waits for the result. The calling thread
+	 * sleeps until the response arrives, the call is unbound or [timeout] passes.
 	 *
 	 * \param request value to deliver
 	 * \return result of remote invoking
@@ -73,15 +75,16 @@ public:
 	{
 		auto task = start_internal(request, true, &SynchronousScheduler::Instance());
 		auto time_at_start = std::chrono::system_clock::now();
-		while (!task.has_value() && !(*bind_lifetime)->is_terminated() &&
-			   ((std::chrono::system_clock::now() - time_at_start) < timeout))
+		// woken by the response, see WiredRdTaskImpl::on_wire_received, or by the task being cancelled with the call
+		const bool completed = task.wait(timeout);
+		spdlog::debug("Time elapsed: {}, has_value={}", to_string(std::chrono::system_clock::now() - time_at_start),
+			to_string(completed));
+		sync_task_id = nullopt;
+		if (!completed)
 		{
-			std::this_thread::yield();
+			throw std::runtime_error("Sync call " + to_string(location) + " timed out after " + std::to_string(timeout.count()) + "ms");
 		}
-		spdlog::debug("Time elapsed: {}, has_value={}", to_string(std::chrono::system_clock::now() - time_at_start),
-			to_string(task.has_value()));
 		task.value_or_throw().unwrap();	   // check for existing value
-		sync_task_id = nullopt;
 		return task;
 	}
 
@@ -130,11 +133,11 @@ private:
 		}
 
 		get_wire()->send(rdid, [&](Buffer& buffer) {
-			spdlog::get("logSend")->trace("call {}::{} send {} request {} : {}", to_string(location), to_string(rdid), (sync ? "SYNC" : "ASYNC"),
+			RD_LOG_TRACE(logSend, "call {}::{} send {} request {} : {}", to_string(location), to_string(rdid), (sync ? "SYNC" : "ASYNC"),
 				to_string(task_id), to_string(request));
 			task_id.write(buffer);
 			ReqSer::write(get_serialization_context(), buffer, request);
-		});
+		}, priority);
 
 		return task;
 	}
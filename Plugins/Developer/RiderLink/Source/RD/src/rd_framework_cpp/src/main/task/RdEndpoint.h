@@ -3,6 +3,16 @@
 
 #include "serialization/Polymorphic.h"
 #include "RdTask.h"
+#include "scheduler/base/IScheduler.h"
+#include "util/latency_histogram.h"
+
+#include "std/unordered_map.h"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -28,7 +38,169 @@ class RdEndpoint : public virtual RdReactiveBase, public ISerializable
 	using handler_t = std::function<RdTask<TRes, ResSer>(Lifetime, TReq const&)>;
 	mutable handler_t local_handler;
 
-	mutable tsl::ordered_map<RdId, RdTask<TRes, ResSer>, rd::hash<RdId>> awaiting_tasks;	// TO-DO get rid of it
+	using steady_clock = std::chrono::steady_clock;
+
+public:
+	/**
+	 * \brief Counters of the requests the endpoint handles.
+	 */
+	struct Stats
+	{
+		/**
+		 * \brief Requests whose handler started and whose response isn't sent yet.
+		 */
+		int32_t in_flight = 0;
+		/**
+		 * \brief Requests waiting for a slot under [set_max_in_flight].
+		 */
+		int32_t queued = 0;
+		int64_t completed = 0;
+		/**
+		 * \brief Time from starting the handler till its task has a result.
+		 */
+		util::latency_histogram handler_latency;
+		/**
+		 * \brief Time from receiving a request till its handler starts: waiting for a slot and for the handler scheduler.
+		 */
+		util::latency_histogram queue_latency;
+	};
+
+private:
+	struct Request
+	{
+		RdId task_id;
+		WTReq value;
+		steady_clock::time_point received;
+	};
+
+	/**
+	 * \brief Requests being handled, by the id their response is sent with, and those waiting for a slot. Shared with the
+	 * cleanup added to the bind lifetime, which may run after the endpoint was moved.
+	 */
+	struct Requests
+	{
+		std::mutex lock;
+		// the task of a request is known once its handler returned
+		rd::unordered_map<RdId, optional<RdTask<TRes, ResSer>>> in_flight;
+		std::deque<std::shared_ptr<Request>> queued;
+		int32_t max_in_flight = 0;
+		IScheduler* scheduler = nullptr;
+		int64_t completed = 0;
+		util::latency_histogram handler_latency;
+		util::latency_histogram queue_latency;
+	};
+
+	mutable std::shared_ptr<Requests> requests{std::make_shared<Requests>()};
+
+	/**
+	 * \brief Runs the handler of [request] on [scheduler], or in this thread if it's null.
+	 */
+	void dispatch(std::shared_ptr<Request> request, IScheduler* scheduler) const
+	{
+		if (scheduler == nullptr)
+		{
+			handle(*bind_lifetime, *request);
+			return;
+		}
+		scheduler->queue([this, lifetime = *bind_lifetime, request = std::move(request)] {
+			if (!lifetime->is_terminated())
+			{
+				handle(lifetime, *request);
+			}
+		});
+	}
+
+	void handle(Lifetime lifetime, Request const& request) const
+	{
+		const auto started = steady_clock::now();
+		RdTask<TRes, ResSer> task;
+		try
+		{
+			task = local_handler(lifetime, wrapper::get<TReq>(request.value));
+		}
+		catch (std::exception const& e)
+		{
+			task.fault(e);
+		}
+		{
+			std::lock_guard<std::mutex> guard(requests->lock);
+			auto it = requests->in_flight.find(request.task_id);
+			if (it == requests->in_flight.end())
+			{
+				// unbound meanwhile
+				return;
+			}
+			it->second = task;
+			requests->queue_latency.record(started - request.received);
+		}
+		// the handler may set the result from another thread, e.g. when it runs on a worker; the response is sent from the
+		// protocol scheduler then, which unbinds the endpoint, so the endpoint isn't touched unless it's still bound
+		IScheduler* protocol_scheduler = get_default_scheduler();
+		task.on_completed(
+			[this, lifetime, task_id = request.task_id, started, protocol_scheduler](RdTaskResult<TRes, ResSer> const& task_result)
+			{
+				if (protocol_scheduler->is_active())
+				{
+					if (!lifetime->is_terminated())
+					{
+						respond(task_id, started, task_result);
+					}
+					return;
+				}
+				protocol_scheduler->queue([this, lifetime, task_id, started, result = RdTaskResult<TRes, ResSer>(task_result)] {
+					if (!lifetime->is_terminated())
+					{
+						respond(task_id, started, result);
+					}
+				});
+			});
+	}
+
+	void respond(RdId const& task_id, steady_clock::time_point started, RdTaskResult<TRes, ResSer> const& task_result) const
+	{
+		RD_LOG_TRACE(logSend, "endpoint {}::{} response = {}", to_string(location), to_string(rdid), to_string(task_result));
+		get_wire()->send(
+			task_id, [&](Buffer& inner_buffer) { task_result.write(get_serialization_context(), inner_buffer); }, priority);
+		complete(task_id, started);
+	}
+
+	/**
+	 * \brief Frees the slot of [task_id] and starts the requests waiting for one. The setter of the result holds the
+	 * task, so dropping it here doesn't free the property being set.
+	 */
+	void complete(RdId const& task_id, steady_clock::time_point started) const
+	{
+		std::vector<std::shared_ptr<Request>> next;
+		IScheduler* scheduler = nullptr;
+		{
+			std::lock_guard<std::mutex> guard(requests->lock);
+			if (requests->in_flight.erase(task_id) == 0)
+			{
+				return;
+			}
+			++requests->completed;
+			requests->handler_latency.record(steady_clock::now() - started);
+			while (!requests->queued.empty() && has_slot())
+			{
+				next.push_back(std::move(requests->queued.front()));
+				requests->queued.pop_front();
+				requests->in_flight.emplace(next.back()->task_id, nullopt);
+			}
+			scheduler = requests->scheduler;
+		}
+		// queued rather than run inside this response, so a long line of waiting requests doesn't recurse
+		for (auto& request : next)
+		{
+			dispatch(std::move(request), scheduler ? scheduler : get_default_scheduler());
+		}
+	}
+
+	// requires requests->lock
+	bool has_slot() const
+	{
+		return requests->max_in_flight <= 0 || static_cast<int32_t>(requests->in_flight.size()) < requests->max_in_flight;
+	}
+
 public:
 	// region ctor/dtor
 
@@ -83,10 +255,52 @@ public:
 		{ return RdTask<TRes, ResSer>::from_result(handler(req)); };
 	}
 
+	/**
+	 * \brief Handles at most [limit] requests at a time, the ones above it wait in order of arrival till a response is
+	 * sent. 0, the default, doesn't limit them.
+	 */
+	void set_max_in_flight(int32_t limit) const
+	{
+		std::lock_guard<std::mutex> guard(requests->lock);
+		requests->max_in_flight = limit;
+	}
+
+	/**
+	 * \brief Runs the handler on [scheduler] instead of the thread the wire delivers requests in, so a slow handler
+	 * doesn't hold up other messages. nullptr restores the default.
+	 */
+	void set_handler_scheduler(IScheduler* scheduler) const
+	{
+		std::lock_guard<std::mutex> guard(requests->lock);
+		requests->scheduler = scheduler;
+	}
+
+	Stats get_stats() const
+	{
+		std::lock_guard<std::mutex> guard(requests->lock);
+		Stats stats;
+		stats.in_flight = static_cast<int32_t>(requests->in_flight.size());
+		stats.queued = static_cast<int32_t>(requests->queued.size());
+		stats.completed = requests->completed;
+		stats.handler_latency = requests->handler_latency;
+		stats.queue_latency = requests->queue_latency;
+		return stats;
+	}
+
 	void init(Lifetime lifetime) const override
 	{
 		RdReactiveBase::init(lifetime);
 		bind_lifetime = lifetime;
+		// responses of requests still handled aren't sent after unbinding, so their entries would never be removed
+		lifetime->add_action([requests = requests] {
+			rd::unordered_map<RdId, optional<RdTask<TRes, ResSer>>> in_flight;
+			std::deque<std::shared_ptr<Request>> queued;
+			{
+				std::lock_guard<std::mutex> guard(requests->lock);
+				in_flight.swap(requests->in_flight);
+				queued.swap(requests->queued);
+			}
+		});
 		get_wire()->advise(lifetime, this);
 	}
 
@@ -94,29 +308,24 @@ public:
 	{
 		auto task_id = RdId::read(buffer);
 		auto value = ReqSer::read(get_serialization_context(), buffer);
-		spdlog::get("logReceived")->trace("endpoint {}::{} request = {}", to_string(location), to_string(rdid), to_string(value));
+		RD_LOG_TRACE(logReceived, "endpoint {}::{} request = {}", to_string(location), to_string(rdid), to_string(value));
 		if (!local_handler)
 		{
 			throw std::invalid_argument("handler is empty for RdEndPoint");
 		}
-		auto task = awaiting_tasks[task_id] = {};
-		try
-		{
-			task = local_handler(*bind_lifetime, wrapper::get<TReq>(value));
-		}
-		catch (std::exception const& e)
+		auto request = std::make_shared<Request>(Request{task_id, std::move(value), steady_clock::now()});
+		IScheduler* scheduler = nullptr;
 		{
-			task.fault(e);
-		}
-		task.advise(*bind_lifetime,
-			[this, task_id, &task](RdTaskResult<TRes, ResSer> const& task_result)
+			std::lock_guard<std::mutex> guard(requests->lock);
+			if (!has_slot())
 			{
-				spdlog::get("logSend")->trace(
-					"endpoint {}::{} response = {}", to_string(location), to_string(rdid), to_string(*task.result));
-				get_wire()->send(
-					task_id, [&](Buffer& inner_buffer) { task_result.write(get_serialization_context(), inner_buffer); });
-				// TO-DO remove from awaiting_tasks
-			});
+				requests->queued.push_back(std::move(request));
+				return;
+			}
+			requests->in_flight.emplace(task_id, nullopt);
+			scheduler = requests->scheduler;
+		}
+		dispatch(std::move(request), scheduler);
 	}
 
 	friend bool operator==(const RdEndpoint& lhs, const RdEndpoint& rhs)
@@ -4,10 +4,55 @@
 #include "RdTaskImpl.h"
 #include "serialization/Polymorphic.h"
 
+#include <chrono>
+#include <exception>
 #include <functional>
+#include <stdexcept>
+
+// tasks can be awaited and returned by coroutines where the module is built as C++20
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define RD_TASK_COROUTINES
+#endif
 
 namespace rd
 {
+#if defined(RD_TASK_COROUTINES)
+namespace detail
+{
+/**
+ * \brief Suspends the awaiting coroutine until [task] has a result and resumes it in the thread that sets the result,
+ * for a [WiredRdTask] the scheduler its response is delivered to. Holds a copy of [task], so the wired part stays
+ * subscribed to the response meanwhile.
+ */
+template <typename T, typename S, typename Task = RdTask<T, S>>
+struct RdTaskAwaiter
+{
+	Task task;
+
+	RdTaskImpl<T, S>& state() const
+	{
+		return *static_cast<RdTask<T, S> const&>(task).impl;
+	}
+
+	bool await_ready() const
+	{
+		return state().is_completed();
+	}
+
+	bool await_suspend(std::coroutine_handle<> handle) const
+	{
+		return state().add_continuation([handle] { handle.resume(); });
+	}
+
+	RdTaskResult<T, S> await_resume() const
+	{
+		return task.value_or_throw();
+	}
+};
+}	 // namespace detail
+
+#endif
 /**
  * \brief Represents a task that can be asynchronously executed.
  *
@@ -31,6 +76,61 @@ public:
 
 	template <typename, typename, typename, typename>
 	friend class RdEndpoint;
+
+#if defined(RD_TASK_COROUTINES)
+	template <typename, typename, typename>
+	friend struct detail::RdTaskAwaiter;
+
+	/**
+	 * \brief Lets coroutines return an [RdTask]: co_return sets the value, an exception escaping the body faults it.
+	 * Endpoint handlers may be such coroutines and await calls of their own.
+	 */
+	struct promise_type
+	{
+		RdTask task;
+
+		RdTask get_return_object() const
+		{
+			return task;
+		}
+
+		std::suspend_never initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		std::suspend_never final_suspend() const noexcept
+		{
+			return {};
+		}
+
+		void return_value(WT value) const
+		{
+			task.set(std::move(value));
+		}
+
+		void unhandled_exception() const
+		{
+			try
+			{
+				throw;
+			}
+			catch (std::exception const& e)
+			{
+				task.fault(e);
+			}
+			catch (...)
+			{
+				task.fault(std::runtime_error("unknown exception in coroutine"));
+			}
+		}
+	};
+
+	detail::RdTaskAwaiter<T, S> operator co_await() const
+	{
+		return {*this};
+	}
+#endif
 	// region ctor/dtor
 
 	RdTask() = default;
@@ -84,6 +184,15 @@ public:
 		return impl->result.has_value();
 	}
 
+	/**
+	 * \brief Blocks the calling thread until the task has a result or [timeout] passes, returns whether it has one.
+	 * The thread sleeps meanwhile and is woken by whoever sets the result. After true the result is safe to read.
+	 */
+	bool wait(std::chrono::milliseconds timeout) const
+	{
+		return impl->wait(timeout);
+	}
+
 	const TRes& value_or_throw() const
 	{
 		if (impl->result.has_value())
@@ -120,6 +229,20 @@ public:
 			}
 		});
 	}
+
+	/**
+	 * \brief Calls [handler] with the result in the thread setting it, or right away if the task has one. Unlike
+	 * [advise] it may be called while another thread sets the result, and it doesn't keep the task alive.
+	 */
+	void on_completed(std::function<void(TRes const&)> handler) const
+	{
+		auto* state = impl.get();
+		auto continuation = [state, handler = std::move(handler)] { handler(state->result.get()); };
+		if (!state->add_continuation(continuation))
+		{
+			continuation();
+		}
+	}
 };
 }	 // namespace rd
 
@@ -6,6 +6,13 @@
 
 #include "thirdparty.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 namespace rd
 {
 template <typename, typename>
@@ -17,11 +24,90 @@ template <typename T, typename S = Polymorphic<T>>
 class RdTaskImpl
 {
 private:
-	mutable Property<RdTaskResult<T, S>> result;
+	/**
+	 * \brief Completes the task once a result is set and its subscribers ran: continuations may free the task, so they
+	 * run after the property is done with setting.
+	 */
+	class ResultProperty final : public Property<RdTaskResult<T, S>>
+	{
+		RdTaskImpl* owner;
+
+	public:
+		explicit ResultProperty(RdTaskImpl* owner) : owner(owner)
+		{
+		}
+
+		void set(value_or_wrapper<RdTaskResult<T, S>> new_value) const override
+		{
+			Property<RdTaskResult<T, S>>::set(std::move(new_value));
+			owner->complete();
+		}
+	};
+
+	mutable ResultProperty result{this};
+
+	// [result] isn't safe to read from a thread other than the one setting it, [completed] is set after it under [lock]
+	std::mutex lock;
+	std::condition_variable completed_var;
+	std::atomic<bool> completed{false};
+	std::vector<std::function<void()>> continuations;
+
+	void complete()
+	{
+		std::vector<std::function<void()>> resumed;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			completed.store(true, std::memory_order_release);
+			resumed.swap(continuations);
+			// under the lock: a woken waiter may free the task as soon as it returns
+			completed_var.notify_all();
+		}
+		for (auto const& continuation : resumed)
+		{
+			continuation();
+		}
+	}
 
 public:
 	template <typename, typename>
 	friend class ::rd::RdTask;
+
+	// region ctor/dtor
+
+	RdTaskImpl() = default;
+
+	RdTaskImpl(RdTaskImpl const&) = delete;
+
+	RdTaskImpl& operator=(RdTaskImpl const&) = delete;
+	// endregion
+
+	bool is_completed() const
+	{
+		return completed.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * \brief Blocks until the result is set or [timeout] passes, returns whether it's set.
+	 */
+	bool wait(std::chrono::milliseconds timeout)
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		return completed_var.wait_for(guard, timeout, [this] { return completed.load(std::memory_order_relaxed); });
+	}
+
+	/**
+	 * \brief Runs [continuation] in the thread setting the result, returns false without running it if it's set.
+	 */
+	bool add_continuation(std::function<void()> continuation)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (completed.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+		continuations.push_back(std::move(continuation));
+		return true;
+	}
 };
 }	 // namespace detail
 }	 // namespace rd
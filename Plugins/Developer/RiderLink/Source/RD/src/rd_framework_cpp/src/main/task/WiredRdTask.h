@@ -32,6 +32,13 @@ public:
 
 	virtual ~WiredRdTask() = default;
 	// endregion
+
+#if defined(RD_TASK_COROUTINES)
+	detail::RdTaskAwaiter<T, S, WiredRdTask> operator co_await() const
+	{
+		return {*this};
+	}
+#endif
 };
 }	 // namespace rd
 
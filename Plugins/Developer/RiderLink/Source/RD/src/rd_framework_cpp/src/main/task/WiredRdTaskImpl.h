@@ -20,7 +20,7 @@ private:
 	IScheduler* scheduler{};
 	Property<RdTaskResult<T, S>>* result{};
 
-	LifetimeImpl::counter_t termination_lifetime_id{};
+	LifetimeImpl::action_id_t termination_lifetime_id{};
 
 public:
 	template <typename, typename>
@@ -44,13 +44,12 @@ public:
 	void on_wire_received(Buffer buffer) const override
 	{
 		auto read_result = RdTaskResult<T, S>::read(cutpoint->get_serialization_context(), buffer);
-		spdlog::get("logReceived")
-			->trace("call {} {} received response {} : {}", to_string(cutpoint->get_location()), to_string(rdid), to_string(rdid),
-				to_string(read_result));
+		RD_LOG_TRACE(logReceived, "call {} {} received response {} : {}", to_string(cutpoint->get_location()), to_string(rdid), to_string(rdid),
+			to_string(read_result));
 		scheduler->queue([&, result = std::move(read_result)]() mutable {
 			if (this->result->has_value())
 			{
-				spdlog::get("logReceived")->trace("call {} {} response was dropped, task result is: {}", to_string(location), to_string(rdid),
+				RD_LOG_TRACE(logReceived, "call {} {} response was dropped, task result is: {}", to_string(location), to_string(rdid),
 					to_string(result.unwrap()));
 			}
 			else
@@ -18,9 +18,25 @@ constexpr constexpr_hash_t DEFAULT_HASH = 19;
 constexpr constexpr_hash_t HASH_FACTOR = 31;
 
 // PLEASE DO NOT CHANGE IT!!! IT'S EXACTLY THE SAME ON C# SIDE
+// hash = hash * HASH_FACTOR + c for every character c, four characters a step: their terms don't depend on each other
+// or on [hash], so the step waits for the previous one only once instead of four times
 constexpr hash_t hashImpl(constexpr_hash_t initial, char const* begin, char const* end)
 {
-	return (begin == end) ? initial : hashImpl(initial * HASH_FACTOR + *begin, begin + 1, end);
+	constexpr constexpr_hash_t FACTOR2 = HASH_FACTOR * HASH_FACTOR;
+	constexpr constexpr_hash_t FACTOR3 = FACTOR2 * HASH_FACTOR;
+	constexpr constexpr_hash_t FACTOR4 = FACTOR3 * HASH_FACTOR;
+
+	constexpr_hash_t hash = initial;
+	for (; end - begin >= 4; begin += 4)
+	{
+		hash = hash * FACTOR4 + (static_cast<constexpr_hash_t>(begin[0]) * FACTOR3 + static_cast<constexpr_hash_t>(begin[1]) * FACTOR2 +
+									static_cast<constexpr_hash_t>(begin[2]) * HASH_FACTOR + static_cast<constexpr_hash_t>(begin[3]));
+	}
+	for (; begin != end; ++begin)
+	{
+		hash = hash * HASH_FACTOR + static_cast<constexpr_hash_t>(*begin);
+	}
+	return static_cast<hash_t>(hash);
 }
 
 /*template<size_t N>
@@ -30,9 +46,34 @@ constexpr hash_t getPlatformIndependentHash(char const (&that)[N], constexpr_has
 
 constexpr hash_t getPlatformIndependentHash(string_view that, constexpr_hash_t initial = DEFAULT_HASH)
 {
-	return static_cast<hash_t>(hashImpl(initial, &that[0], &that[that.length() - 1] + 1));
+	return hashImpl(initial, that.data(), that.data() + that.length());
 }
 
+/**
+ * \brief What hashing a string adds to the hash it continues. The hash is linear in its initial value:
+ * hash(initial, s) == initial * [factor] + hash(0, s), so both parts can be computed from s alone, at compile time for
+ * a literal. Appending it then takes one multiply-add whatever the length of s.
+ */
+struct hash_suffix
+{
+	constexpr_hash_t factor = 1;
+	constexpr_hash_t addend = 0;
+
+	explicit constexpr hash_suffix(string_view that)
+		: addend(static_cast<constexpr_hash_t>(hashImpl(0, that.data(), that.data() + that.length())))
+	{
+		for (size_t i = 0; i < that.length(); ++i)
+		{
+			factor *= HASH_FACTOR;
+		}
+	}
+
+	constexpr hash_t apply(constexpr_hash_t initial) const
+	{
+		return static_cast<hash_t>(initial * factor + addend);
+	}
+};
+
 constexpr hash_t getPlatformIndependentHash(int32_t const& that, constexpr_hash_t initial = DEFAULT_HASH)
 {
 	return static_cast<hash_t>(initial * HASH_FACTOR + static_cast<constexpr_hash_t>(that + 1));
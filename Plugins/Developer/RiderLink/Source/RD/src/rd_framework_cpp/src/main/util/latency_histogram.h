@@ -0,0 +1,113 @@
+#ifndef RD_CPP_LATENCY_HISTOGRAM_H
+#define RD_CPP_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Histogram of durations in power of two buckets: bucket i counts durations of [2^(i-1), 2^i) nanoseconds.
+ * Not synchronized, owners guard it with their own locks and hand out copies.
+ */
+class latency_histogram
+{
+public:
+	using duration_t = std::chrono::nanoseconds;
+
+	static constexpr int32_t BUCKETS = 48;
+
+private:
+	std::array<int64_t, BUCKETS> buckets{};
+	int64_t count_ = 0;
+	int64_t total_ns = 0;
+	int64_t max_ns = 0;
+
+	static int32_t bucket_of(uint64_t ns)
+	{
+		int32_t bucket = 0;
+		while (ns != 0 && bucket < BUCKETS - 1)
+		{
+			ns >>= 1;
+			++bucket;
+		}
+		return bucket;
+	}
+
+public:
+	void record(duration_t duration)
+	{
+		const int64_t ns = duration.count() < 0 ? 0 : duration.count();
+		++buckets[bucket_of(static_cast<uint64_t>(ns))];
+		++count_;
+		total_ns += ns;
+		if (ns > max_ns)
+		{
+			max_ns = ns;
+		}
+	}
+
+	void merge(latency_histogram const& other)
+	{
+		for (int32_t i = 0; i < BUCKETS; ++i)
+		{
+			buckets[i] += other.buckets[i];
+		}
+		count_ += other.count_;
+		total_ns += other.total_ns;
+		if (other.max_ns > max_ns)
+		{
+			max_ns = other.max_ns;
+		}
+	}
+
+	int64_t count() const
+	{
+		return count_;
+	}
+
+	duration_t mean() const
+	{
+		return duration_t(count_ == 0 ? 0 : total_ns / count_);
+	}
+
+	duration_t max() const
+	{
+		return duration_t(max_ns);
+	}
+
+	/**
+	 * \return upper bound of the bucket holding the [fraction] quantile, e.g. 0.99 for p99, capped by [max].
+	 */
+	duration_t percentile(double fraction) const
+	{
+		if (count_ == 0)
+		{
+			return duration_t(0);
+		}
+		const auto rank = static_cast<int64_t>(fraction * static_cast<double>(count_ - 1));
+		int64_t seen = 0;
+		for (int32_t i = 0; i < BUCKETS; ++i)
+		{
+			seen += buckets[i];
+			if (seen > rank)
+			{
+				const int64_t bound = i == 0 ? 0 : (int64_t(1) << i) - 1;
+				return duration_t(bound < max_ns ? bound : max_ns);
+			}
+		}
+		return max();
+	}
+
+	std::array<int64_t, BUCKETS> const& get_buckets() const
+	{
+		return buckets;
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_LATENCY_HISTOGRAM_H
@@ -0,0 +1,221 @@
+#include "lz_block.h"
+
+#include <cstring>
+
+namespace rd
+{
+namespace util
+{
+namespace lz_block
+{
+namespace
+{
+constexpr int32_t MIN_MATCH = 4;
+// the format requires the last match to start 12 bytes before the end and the last 5 bytes to be literals
+constexpr int32_t MATCH_FIND_LIMIT = 12;
+constexpr int32_t LAST_LITERALS = 5;
+constexpr int32_t MAX_OFFSET = 65535;
+constexpr int32_t HASH_LOG = 12;
+constexpr uint32_t RUN_MASK = 15;
+
+uint32_t read32(uint8_t const* p)
+{
+	uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+uint32_t hash(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HASH_LOG);
+}
+
+bool write_length(uint8_t*& op, uint8_t const* end, uint32_t length)
+{
+	while (length >= 255)
+	{
+		if (op >= end)
+		{
+			return false;
+		}
+		*op++ = 255;
+		length -= 255;
+	}
+	if (op >= end)
+	{
+		return false;
+	}
+	*op++ = static_cast<uint8_t>(length);
+	return true;
+}
+
+bool read_length(uint8_t const*& ip, uint8_t const* end, uint32_t& length)
+{
+	uint8_t byte;
+	do
+	{
+		if (ip >= end)
+		{
+			return false;
+		}
+		byte = *ip++;
+		length += byte;
+	} while (byte == 255);
+	return true;
+}
+
+bool write_sequence(uint8_t*& op, uint8_t const* end, uint8_t const* literals, uint32_t literal_count, int32_t offset,
+	uint32_t match_length)
+{
+	if (op >= end)
+	{
+		return false;
+	}
+	uint8_t* token = op++;
+	const uint32_t literal_token = literal_count < RUN_MASK ? literal_count : RUN_MASK;
+	*token = static_cast<uint8_t>(literal_token << 4);
+	if (literal_token == RUN_MASK && !write_length(op, end, literal_count - RUN_MASK))
+	{
+		return false;
+	}
+	if (end - op < static_cast<int64_t>(literal_count))
+	{
+		return false;
+	}
+	if (literal_count > 0)
+	{
+		std::memcpy(op, literals, literal_count);
+		op += literal_count;
+	}
+	if (offset == 0)
+	{
+		return true;
+	}
+
+	if (end - op < 2)
+	{
+		return false;
+	}
+	*op++ = static_cast<uint8_t>(offset);
+	*op++ = static_cast<uint8_t>(offset >> 8);
+	const uint32_t match_token = match_length - MIN_MATCH;
+	*token |= static_cast<uint8_t>(match_token < RUN_MASK ? match_token : RUN_MASK);
+	return match_token < RUN_MASK || write_length(op, end, match_token - RUN_MASK);
+}
+}	 // namespace
+
+int32_t compress(uint8_t const* src, int32_t len, uint8_t* dst, int32_t capacity)
+{
+	uint8_t* op = dst;
+	uint8_t const* const op_end = dst + capacity;
+	uint8_t const* anchor = src;
+
+	if (len > MATCH_FIND_LIMIT)
+	{
+		int32_t table[1 << HASH_LOG];
+		std::memset(table, -1, sizeof(table));
+
+		uint8_t const* const match_limit = src + len - LAST_LITERALS;
+		uint8_t const* const find_limit = src + len - MATCH_FIND_LIMIT;
+		uint8_t const* ip = src;
+		while (ip < find_limit)
+		{
+			const uint32_t sequence = read32(ip);
+			const uint32_t h = hash(sequence);
+			const int32_t candidate = table[h];
+			const int32_t position = static_cast<int32_t>(ip - src);
+			table[h] = position;
+			if (candidate < 0 || position - candidate > MAX_OFFSET || read32(src + candidate) != sequence)
+			{
+				++ip;
+				continue;
+			}
+
+			uint8_t const* match = src + candidate;
+			uint8_t const* match_end = ip + MIN_MATCH;
+			match += MIN_MATCH;
+			while (match_end < match_limit && *match_end == *match)
+			{
+				++match_end;
+				++match;
+			}
+			if (!write_sequence(op, op_end, anchor, static_cast<uint32_t>(ip - anchor), position - candidate,
+					static_cast<uint32_t>(match_end - ip)))
+			{
+				return 0;
+			}
+			ip = anchor = match_end;
+		}
+	}
+
+	if (!write_sequence(op, op_end, anchor, static_cast<uint32_t>(src + len - anchor), 0, 0))
+	{
+		return 0;
+	}
+	return static_cast<int32_t>(op - dst);
+}
+
+bool decompress(uint8_t const* src, int32_t len, uint8_t* dst, int32_t raw_len)
+{
+	uint8_t const* ip = src;
+	uint8_t const* const ip_end = src + len;
+	uint8_t* op = dst;
+	uint8_t* const op_end = dst + raw_len;
+
+	while (ip < ip_end)
+	{
+		const uint8_t token = *ip++;
+
+		uint32_t literal_count = token >> 4;
+		if (literal_count == RUN_MASK && !read_length(ip, ip_end, literal_count))
+		{
+			return false;
+		}
+		if (ip_end - ip < static_cast<int64_t>(literal_count) || op_end - op < static_cast<int64_t>(literal_count))
+		{
+			return false;
+		}
+		if (literal_count > 0)
+		{
+			std::memcpy(op, ip, literal_count);
+			ip += literal_count;
+			op += literal_count;
+		}
+		if (ip == ip_end)
+		{
+			break;	  // the last sequence has literals only
+		}
+
+		if (ip_end - ip < 2)
+		{
+			return false;
+		}
+		const int32_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > op - dst)
+		{
+			return false;
+		}
+		uint32_t match_length = token & RUN_MASK;
+		if (match_length == RUN_MASK && !read_length(ip, ip_end, match_length))
+		{
+			return false;
+		}
+		match_length += MIN_MATCH;
+		if (op_end - op < static_cast<int64_t>(match_length))
+		{
+			return false;
+		}
+		// byte by byte, as the match may overlap the bytes it produces
+		uint8_t const* match = op - offset;
+		for (uint32_t i = 0; i < match_length; ++i)
+		{
+			op[i] = match[i];
+		}
+		op += match_length;
+	}
+	return op == op_end;
+}
+}	 // namespace lz_block
+}	 // namespace util
+}	 // namespace rd
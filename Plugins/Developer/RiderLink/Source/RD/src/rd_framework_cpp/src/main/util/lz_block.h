@@ -0,0 +1,38 @@
+#ifndef RD_CPP_LZ_BLOCK_H
+#define RD_CPP_LZ_BLOCK_H
+
+#include <cstdint>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Fast LZ77 compression in LZ4 block format, for wire packages of a few kilobytes.
+ */
+namespace lz_block
+{
+/**
+ * \brief Upper bound of compressed size of [len] bytes, incompressible input included.
+ */
+constexpr int32_t compress_bound(int32_t len)
+{
+	return len + len / 255 + 16;
+}
+
+/**
+ * \brief Compresses [src] into [dst] of [capacity] bytes.
+ * \return compressed size, or 0 if it doesn't fit into [capacity].
+ */
+int32_t compress(uint8_t const* src, int32_t len, uint8_t* dst, int32_t capacity);
+
+/**
+ * \brief Decompresses [src] into exactly [raw_len] bytes of [dst]. Input is validated, so it may come from the network.
+ * \return false if [src] is malformed or doesn't decompress into [raw_len] bytes.
+ */
+bool decompress(uint8_t const* src, int32_t len, uint8_t* dst, int32_t raw_len);
+}	 // namespace lz_block
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_LZ_BLOCK_H
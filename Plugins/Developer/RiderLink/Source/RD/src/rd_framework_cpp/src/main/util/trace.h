@@ -0,0 +1,36 @@
+#ifndef RD_CPP_TRACE_H
+#define RD_CPP_TRACE_H
+
+#include "spdlog/spdlog.h"
+
+/**
+ * \brief Lowest level compiled into RD_LOG calls, e.g. SPDLOG_LEVEL_ERROR removes protocol tracing from a build.
+ */
+#ifndef RD_LOG_ACTIVE_LEVEL
+#define RD_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+/**
+ * \brief logger->log(level, ...) which evaluates its arguments only if [level] is compiled in and enabled for
+ * [logger], so messages are never formatted just to be dropped.
+ */
+#define RD_LOG(logger, level, ...)                                 \
+	do                                                             \
+	{                                                              \
+		if (static_cast<int>(level) >= RD_LOG_ACTIVE_LEVEL)        \
+		{                                                          \
+			auto const& rd_log_logger = (logger);                  \
+			if (rd_log_logger->should_log(level))                  \
+			{                                                      \
+				rd_log_logger->log(level, __VA_ARGS__);            \
+			}                                                      \
+		}                                                          \
+	} while (false)
+
+#define RD_LOG_TRACE(logger, ...) RD_LOG(logger, spdlog::level::trace, __VA_ARGS__)
+
+#define RD_LOG_DEBUG(logger, ...) RD_LOG(logger, spdlog::level::debug, __VA_ARGS__)
+
+#define RD_LOG_INFO(logger, ...) RD_LOG(logger, spdlog::level::info, __VA_ARGS__)
+
+#endif	  // RD_CPP_TRACE_H
@@ -0,0 +1,153 @@
+#include "utf16.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RD_UTF16_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace rd
+{
+namespace util
+{
+namespace utf16
+{
+namespace
+{
+constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+uint16_t load_unit(uint8_t const* src, size_t index)
+{
+	uint16_t unit;
+	std::memcpy(&unit, src + index * sizeof(uint16_t), sizeof(unit));
+	return unit;
+}
+
+void store_unit(uint8_t* dst, size_t index, uint16_t unit)
+{
+	std::memcpy(dst + index * sizeof(uint16_t), &unit, sizeof(unit));
+}
+
+bool is_high_surrogate(uint16_t unit)
+{
+	return (unit & 0xFC00) == 0xD800;
+}
+
+bool is_low_surrogate(uint16_t unit)
+{
+	return (unit & 0xFC00) == 0xDC00;
+}
+
+/**
+ * \brief Decodes the character starting at unit [i], advancing [i] past it.
+ */
+char32_t decode(uint8_t const* src, size_t len, size_t& i)
+{
+	const uint16_t unit = load_unit(src, i++);
+	if (is_high_surrogate(unit) && i < len)
+	{
+		const uint16_t next = load_unit(src, i);
+		if (is_low_surrogate(next))
+		{
+			++i;
+			return 0x10000 + ((static_cast<char32_t>(unit) - 0xD800) << 10) + (next - 0xDC00);
+		}
+	}
+	return unit;
+}
+
+/**
+ * \brief Encodes [c] at unit [o], advancing [o] past it.
+ */
+void encode(char32_t c, uint8_t* dst, size_t& o)
+{
+	if (c < 0x10000)
+	{
+		store_unit(dst, o++, static_cast<uint16_t>(c));
+	}
+	else if (c <= 0x10FFFF)
+	{
+		c -= 0x10000;
+		store_unit(dst, o++, static_cast<uint16_t>(0xD800 + (c >> 10)));
+		store_unit(dst, o++, static_cast<uint16_t>(0xDC00 + (c & 0x3FF)));
+	}
+	else
+	{
+		store_unit(dst, o++, static_cast<uint16_t>(REPLACEMENT_CHARACTER));
+	}
+}
+}	 // namespace
+
+size_t widen(uint8_t const* src, size_t len, char32_t* dst)
+{
+	size_t i = 0;
+	size_t o = 0;
+#ifdef RD_UTF16_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i surrogate_mask = _mm_set1_epi16(static_cast<int16_t>(0xF800));
+	const __m128i surrogate = _mm_set1_epi16(static_cast<int16_t>(0xD800));
+	while (i + 8 <= len)
+	{
+		const __m128i units = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i * sizeof(uint16_t)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask), surrogate)) != 0)
+		{
+			// a pair may straddle the block, so the block is decoded one character at a time
+			const size_t end = i + 8;
+			while (i < end)
+			{
+				dst[o++] = decode(src, len, i);
+			}
+			continue;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o), _mm_unpacklo_epi16(units, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o + 4), _mm_unpackhi_epi16(units, zero));
+		i += 8;
+		o += 8;
+	}
+#endif
+	while (i < len)
+	{
+		dst[o++] = decode(src, len, i);
+	}
+	return o;
+}
+
+size_t narrow(char32_t const* src, size_t len, uint8_t* dst)
+{
+	size_t i = 0;
+	size_t o = 0;
+#ifdef RD_UTF16_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	// packs_epi32 saturates signed values, so characters are biased into the int16 range and back
+	const __m128i bias32 = _mm_set1_epi32(0x8000);
+	const __m128i bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+	while (i + 8 <= len)
+	{
+		const __m128i low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+		const __m128i high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i + 4));
+		const __m128i above_bmp = _mm_srli_epi32(_mm_or_si128(low, high), 16);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(above_bmp, zero)) != 0xFFFF)
+		{
+			const size_t end = i + 8;
+			while (i < end)
+			{
+				encode(src[i++], dst, o);
+			}
+			continue;
+		}
+		const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(low, bias32), _mm_sub_epi32(high, bias32));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o * sizeof(uint16_t)), _mm_add_epi16(packed, bias16));
+		i += 8;
+		o += 8;
+	}
+#endif
+	while (i < len)
+	{
+		encode(src[i++], dst, o);
+	}
+	return o;
+}
+}	 // namespace utf16
+}	 // namespace util
+}	 // namespace rd
@@ -0,0 +1,34 @@
+#ifndef RD_CPP_UTF16_H
+#define RD_CPP_UTF16_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Conversions between UTF-16 as strings go on the wire and UTF-32 as std::wstring holds them where wchar_t is
+ * 4 bytes. Runs without surrogates, i.e. nearly all text, are widened and narrowed 8 characters at a time with SSE2.
+ */
+namespace utf16
+{
+/**
+ * \brief Decodes [len] UTF-16 units at [src], which needn't be aligned, into [dst] with room for [len] characters.
+ * Surrogate pairs become one character, unpaired surrogates are kept as they are.
+ * \return characters written.
+ */
+size_t widen(uint8_t const* src, size_t len, char32_t* dst);
+
+/**
+ * \brief Encodes [len] characters of [src] into [dst], which needn't be aligned, with room for 2 * [len] units.
+ * Characters above U+FFFF become surrogate pairs, ones above U+10FFFF become U+FFFD.
+ * \return UTF-16 units written.
+ */
+size_t narrow(char32_t const* src, size_t len, uint8_t* dst);
+}	 // namespace utf16
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_UTF16_H
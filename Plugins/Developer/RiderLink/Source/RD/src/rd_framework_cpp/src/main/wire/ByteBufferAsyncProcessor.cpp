@@ -1,20 +1,30 @@
 #include "ByteBufferAsyncProcessor.h"
 
+#include "scheduler/TimerWheel.h"
 #include "util/guards.h"
 #include <util/thread_util.h>
 
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <algorithm>
+
 namespace rd
 {
 size_t ByteBufferAsyncProcessor::INITIAL_CAPACITY = 1024 * 1024;
 
+/**
+ * \brief Messages sent from each lane per round, [MessagePriority::Interactive] isn't weighted and always goes first.
+ */
+static constexpr std::array<int32_t, MESSAGE_PRIORITY_COUNT> LANE_WEIGHTS = {0, 4, 1};
+
 std::shared_ptr<spdlog::logger> ByteBufferAsyncProcessor::logger =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("byteBufferLog", spdlog::color_mode::automatic);
 
-ByteBufferAsyncProcessor::ByteBufferAsyncProcessor(
-	std::string id, std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor)
-	: id(std::move(id)), processor(std::move(processor))
+ByteBufferAsyncProcessor::ByteBufferAsyncProcessor(std::string id,
+	std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor, int32_t chunk_size, int64_t window,
+	std::function<void()> control_processor)
+	: id(std::move(id)), processor(std::move(processor)), chunk_size(chunk_size), window(window),
+	  control_processor(std::move(control_processor))
 {
 	data.reserve(INITIAL_CAPACITY);
 }
@@ -52,14 +62,31 @@ bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set
 	}
 	cv.notify_all();
 
-	std::future_status status = async_future.wait_for(timeout);
-
 	bool success = true;
-
-	if (status == std::future_status::timeout)
 	{
-		logger->error("Couldn't wait async thread during time: {}", to_string(timeout));
-		success = false;
+		std::unique_lock<decltype(lock)> guard(lock);
+		if (!async_finished && timeout > time_t(0))
+		{
+			bool timed_out = false;
+			const auto timer = TimerWheel::Instance().schedule(timeout, [this, &timed_out] {
+				{
+					std::lock_guard<decltype(lock)> timer_guard(lock);
+					timed_out = true;
+				}
+				cv.notify_all();
+			});
+			cv.wait(guard, [this, &timed_out] { return async_finished || timed_out; });
+
+			// the timer action takes the lock
+			guard.unlock();
+			TimerWheel::Instance().cancel(timer);
+			guard.lock();
+		}
+		if (!async_finished)
+		{
+			logger->error("Couldn't wait async thread during time: {}", to_string(timeout));
+			success = false;
+		}
 	}
 
 	cleanup0();
@@ -67,13 +94,97 @@ bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set
 	return success;
 }
 
-void ByteBufferAsyncProcessor::add_data(std::vector<Buffer::ByteArray>&& new_data)
+void ByteBufferAsyncProcessor::add_data(std::vector<std::pair<MessagePriority, Buffer::ByteArray>>&& new_data)
 {
 	std::lock_guard<decltype(queue_lock)> guard(queue_lock);
-	std::move(new_data.begin(), new_data.end(), std::back_inserter(queue));
-	//		for (auto &&item : new_data) {
-	//			queue.emplace(std::move(item));
-	//		}
+	enqueue(std::move(new_data));
+}
+
+void ByteBufferAsyncProcessor::enqueue(std::vector<std::pair<MessagePriority, Buffer::ByteArray>>&& new_data)
+{
+	for (auto& item : new_data)
+	{
+		Lane& lane = lanes[static_cast<size_t>(item.first)];
+		Buffer::ByteArray& message = item.second;
+		const size_t size = message.size();
+		if (chunk_size <= 0 || size <= static_cast<size_t>(chunk_size))
+		{
+			lane.chunks.push_back(std::move(message));
+			lane.messages.push_back(1);
+			continue;
+		}
+		// the counterpart reads messages as a stream, so chunks of one message may go in separate packages and
+		// acknowledges and pings get to the socket in between them
+		size_t count = 0;
+		for (size_t offset = 0; offset < size; offset += chunk_size, ++count)
+		{
+			const size_t end = (std::min)(size, offset + chunk_size);
+			lane.chunks.emplace_back(message.begin() + offset, message.begin() + end);
+		}
+		lane.messages.push_back(count);
+	}
+}
+
+void ByteBufferAsyncProcessor::pull_data()
+{
+	// messages put during a long burst join the lanes between its messages instead of waiting for all of it,
+	// [lock] is only tried as it's taken before [queue_lock] elsewhere
+	std::unique_lock<decltype(lock)> guard(lock, std::try_to_lock);
+	if (guard.owns_lock() && !data.empty())
+	{
+		enqueue(std::move(data));
+		data.clear();
+	}
+}
+
+ByteBufferAsyncProcessor::Lane* ByteBufferAsyncProcessor::next_lane()
+{
+	Lane& interactive = lanes[static_cast<size_t>(MessagePriority::Interactive)];
+	if (!interactive.messages.empty())
+	{
+		return &interactive;
+	}
+	// the rest share the wire in proportion to LANE_WEIGHTS, so a flood of bulk messages can't hold normal ones
+	// back and vice versa
+	for (int32_t round = 0; round < 2; ++round)
+	{
+		for (size_t i = static_cast<size_t>(MessagePriority::Normal); i < MESSAGE_PRIORITY_COUNT; ++i)
+		{
+			Lane& lane = lanes[i];
+			if (!lane.messages.empty() && lane.turns > 0)
+			{
+				--lane.turns;
+				return &lane;
+			}
+		}
+		for (size_t i = 0; i < MESSAGE_PRIORITY_COUNT; ++i)
+		{
+			lanes[i].turns = LANE_WEIGHTS[i];
+		}
+	}
+	return nullptr;
+}
+
+void ByteBufferAsyncProcessor::release_acknowledged()
+{
+	while (!pending_queue.empty() && current_seqn <= acknowledged_seqn)
+	{
+		in_flight_bytes -= static_cast<int64_t>(pending_queue.front().size());
+		pending_queue.pop_front();
+		++current_seqn;
+	}
+}
+
+void ByteBufferAsyncProcessor::note_sent(sequence_number_t seqn)
+{
+	std::lock_guard<decltype(rtt_lock)> guard(rtt_lock);
+	send_times.emplace_back(seqn, std::chrono::steady_clock::now());
+}
+
+bool ByteBufferAsyncProcessor::has_credit(size_t size) const
+{
+	// a single item is always let through, so the window can't block an item bigger than itself
+	return window <= 0 || in_flight_bytes == 0 || in_flight_bytes + static_cast<int64_t>(size) <= window;
 }
 
 bool ByteBufferAsyncProcessor::reprocess()
@@ -88,10 +199,10 @@ bool ByteBufferAsyncProcessor::reprocess()
 
 		logger->debug("{}: reprocessing waited for main processing", id);
 
-		while (current_seqn <= acknowledged_seqn)
+		release_acknowledged();
 		{
-			pending_queue.pop_front();
-			++current_seqn;
+			std::lock_guard<decltype(rtt_lock)> rtt_guard(rtt_lock);
+			send_times.clear();
 		}
 		for (int i = 0; i < pending_queue.size(); ++i)
 		{
@@ -100,11 +211,20 @@ bool ByteBufferAsyncProcessor::reprocess()
 			{
 				return false;
 			}
+			note_sent(current_seqn + i);
 		}
 	}
 	return true;
 }
 
+void ByteBufferAsyncProcessor::process_control()
+{
+	if (control_due.exchange(false) && control_processor)
+	{
+		control_processor();
+	}
+}
+
 void ByteBufferAsyncProcessor::process()
 {
 	{
@@ -114,11 +234,45 @@ void ByteBufferAsyncProcessor::process()
 
 		logger->debug("{}: processing started", id);
 
-		while (!queue.empty() && processor(queue.front(), max_sent_seqn + 1))
+		while (true)
 		{
+			if (current_chunks_left == 0)
+			{
+				pull_data();
+				current_lane = next_lane();
+				if (current_lane == nullptr)
+				{
+					break;
+				}
+				current_chunks_left = current_lane->messages.front();
+				current_lane->messages.pop_front();
+			}
+			release_acknowledged();
+			auto& item = current_lane->chunks.front();
+			if (!has_credit(item.size()))
+			{
+				stalled = true;
+				// acknowledge could have come before the flag was raised
+				release_acknowledged();
+				if (!has_credit(item.size()))
+				{
+					logger->trace("{}: window is exhausted, {} bytes in flight", id, in_flight_bytes);
+					break;
+				}
+				stalled = false;
+			}
+			// a control frame doesn't wait for the rest of a long burst
+			process_control();
+			if (!processor(item, max_sent_seqn + 1))
+			{
+				break;
+			}
 			++max_sent_seqn;
-			pending_queue.push_back(std::move(queue.front()));
-			queue.pop_front();
+			note_sent(max_sent_seqn);
+			in_flight_bytes += static_cast<int64_t>(item.size());
+			pending_queue.push_back(std::move(item));
+			current_lane->chunks.pop_front();
+			--current_chunks_left;
 		}
 	}
 	processing_cv.notify_all();
@@ -131,6 +285,20 @@ void ByteBufferAsyncProcessor::ThreadProc()
 	rd::util::set_thread_name(id.empty() ? "ByteBufferAsyncProcessor Thread" : id.c_str());
 	async_thread_id = std::this_thread::get_id();
 
+	struct finish_guard
+	{
+		ByteBufferAsyncProcessor& self;
+
+		~finish_guard()
+		{
+			{
+				std::lock_guard<decltype(self.lock)> guard(self.lock);
+				self.async_finished = true;
+			}
+			self.cv.notify_all();
+		}
+	} finished{*this};
+
 	while (true)
 	{
 		{
@@ -141,7 +309,7 @@ void ByteBufferAsyncProcessor::ThreadProc()
 				return;
 			}
 
-			while (data.empty() || interrupt_balance != 0)
+			while ((data.empty() && !credit_returned && !control_due) || interrupt_balance != 0)
 			{
 				if (state >= StateKind::Stopping)
 				{
@@ -156,12 +324,14 @@ void ByteBufferAsyncProcessor::ThreadProc()
 					return;
 				}
 			}
+			credit_returned = false;
 			add_data(std::move(data));
 			data.clear();
 		}
 
 		try
 		{
+			process_control();
 			process();
 		}
 		catch (std::exception const& e)
@@ -198,7 +368,7 @@ bool ByteBufferAsyncProcessor::terminate(time_t timeout)
 	return terminate0(timeout, StateKind::Terminating, "TERMINATE");
 }
 
-void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data)
+void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data, MessagePriority priority)
 {
 	{
 		std::lock_guard<decltype(lock)> guard(lock);
@@ -207,7 +377,20 @@ void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data)
 		{
 			return;
 		}
-		data.emplace_back(std::move(new_data));
+		data.emplace_back(priority, std::move(new_data));
+	}
+	cv.notify_all();
+}
+
+void ByteBufferAsyncProcessor::request_control()
+{
+	control_due = true;
+	// pause and resume hold [lock] while packages are sent, so it's only tried: if the thread holds it, it either
+	// sees the flag before waiting or waits for the next request
+	std::unique_lock<decltype(lock)> guard(lock, std::try_to_lock);
+	if (guard.owns_lock())
+	{
+		guard.unlock();
 	}
 	cv.notify_all();
 }
@@ -238,6 +421,8 @@ void ByteBufferAsyncProcessor::resume()
 		reprocess();
 
 		--interrupt_balance;
+		// items stalled on the previous connection aren't going to be acknowledged there
+		credit_returned = true;
 
 		logger->debug("{} resumed", id);
 	}
@@ -253,13 +438,37 @@ void ByteBufferAsyncProcessor::acknowledge(sequence_number_t seqn)
 	{
 		logger->trace("{}: new acknowledged seqn: {}", this->id, seqn);
 		acknowledged_seqn = seqn;
+		{
+			// acknowledges are cumulative, the round trip is taken of the package acknowledged explicitly
+			const auto now = std::chrono::steady_clock::now();
+			std::lock_guard<decltype(rtt_lock)> rtt_guard(rtt_lock);
+			while (!send_times.empty() && send_times.front().first <= seqn)
+			{
+				if (send_times.front().first == seqn)
+				{
+					ack_rtt.record(now - send_times.front().second);
+				}
+				send_times.pop_front();
+			}
+		}
+		if (stalled.exchange(false))
+		{
+			credit_returned = true;
+			cv.notify_all();
+		}
 	}
 	else
 	{
-		logger->error("Acknowledge {} called, while next seqn MUST BE greater than {}", seqn, acknowledged_seqn);
+		logger->error("Acknowledge {} called, while next seqn MUST BE greater than {}", seqn, acknowledged_seqn.load());
 	}
 }
 
+util::latency_histogram ByteBufferAsyncProcessor::get_ack_rtt() const
+{
+	std::lock_guard<decltype(rtt_lock)> guard(rtt_lock);
+	return ack_rtt;
+}
+
 std::string to_string(ByteBufferAsyncProcessor::StateKind state)
 {
 	switch (state)
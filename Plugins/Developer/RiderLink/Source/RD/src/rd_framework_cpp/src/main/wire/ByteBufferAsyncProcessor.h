@@ -7,14 +7,19 @@
 #endif
 
 #include "protocol/Buffer.h"
+#include "base/MessagePriority.h"
+#include "util/latency_histogram.h"
 #include "spdlog/spdlog.h"
 
+#include <array>
 #include <chrono>
 #include <string>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <list>
+#include <utility>
 
 #include <rd_framework_export.h>
 
@@ -46,20 +51,77 @@ private:
 
 	std::function<bool(Buffer::ByteArray const&, sequence_number_t seqn)> processor;
 
+	/**
+	 * \brief Items longer than this are split into several packages, 0 disables splitting.
+	 */
+	int32_t chunk_size;
+	/**
+	 * \brief Maximum amount of sent but not acknowledged bytes, 0 means unlimited.
+	 */
+	int64_t window;
+
+	/**
+	 * \brief Writes frames which aren't queued packages, e.g. pings, on the thread when [request_control] asks for it.
+	 */
+	std::function<void()> control_processor;
+	std::atomic<bool> control_due{false};
+
 	StateKind state{StateKind::Initialized};
 	static std::shared_ptr<spdlog::logger> logger;
 
 	std::thread::id async_thread_id;
 	std::future<void> async_future;
+	/**
+	 * \brief Set under [lock] when ThreadProc returns, stop and terminate wait for it on [cv].
+	 */
+	bool async_finished = false;
+
+	/**
+	 * \brief Queue of one [MessagePriority], chunks of a message are always sent back to back.
+	 */
+	struct Lane
+	{
+		std::deque<Buffer::ByteArray> chunks;
+		/**
+		 * \brief Number of chunks of each queued message.
+		 */
+		std::deque<size_t> messages;
+		int32_t turns = 0;
+	};
 
-	std::vector<Buffer::ByteArray> data;
+	std::vector<std::pair<MessagePriority, Buffer::ByteArray>> data;
 	std::mutex queue_lock;
-	std::deque<Buffer::ByteArray> queue{};
+	std::array<Lane, MESSAGE_PRIORITY_COUNT> lanes{};
+	/**
+	 * \brief Lane of the message being sent and the number of its chunks not sent yet, guarded by [queue_lock].
+	 */
+	Lane* current_lane = nullptr;
+	size_t current_chunks_left = 0;
 	std::deque<Buffer::ByteArray> pending_queue{};
 
 	sequence_number_t max_sent_seqn = 0;
 	sequence_number_t current_seqn = 1;
-	sequence_number_t acknowledged_seqn = 0;
+	std::atomic<sequence_number_t> acknowledged_seqn{0};
+
+	/**
+	 * \brief Size of [pending_queue], guarded by [queue_lock].
+	 */
+	int64_t in_flight_bytes = 0;
+	/**
+	 * \brief Raised by [process] when the window is exhausted, the next [acknowledge] wakes the thread up.
+	 */
+	std::atomic<bool> stalled{false};
+	/**
+	 * \brief Set under [lock] when stalled items may be sent again.
+	 */
+	bool credit_returned = false;
+
+	/**
+	 * \brief Send times of packages waiting for acknowledge, oldest first, guarded by [rtt_lock].
+	 */
+	std::deque<std::pair<sequence_number_t, std::chrono::steady_clock::time_point>> send_times;
+	util::latency_histogram ack_rtt;
+	mutable std::mutex rtt_lock;
 
 	int32_t interrupt_balance = 0;
 	bool in_processing = false;
@@ -69,7 +131,8 @@ private:
 public:
 	// region ctor/dtor
 
-	explicit ByteBufferAsyncProcessor(std::string id, std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor);
+	explicit ByteBufferAsyncProcessor(std::string id, std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor,
+		int32_t chunk_size = 0, int64_t window = 0, std::function<void()> control_processor = {});
 
 	// endregion
 private:
@@ -77,10 +140,24 @@ private:
 
 	bool terminate0(time_t timeout, StateKind state_to_set, string_view action);
 
-	void add_data(std::vector<Buffer::ByteArray>&& new_data);
+	void add_data(std::vector<std::pair<MessagePriority, Buffer::ByteArray>>&& new_data);
+
+	void enqueue(std::vector<std::pair<MessagePriority, Buffer::ByteArray>>&& new_data);
+
+	void pull_data();
+
+	Lane* next_lane();
+
+	void release_acknowledged();
+
+	void note_sent(sequence_number_t seqn);
+
+	bool has_credit(size_t size) const;
 
 	bool reprocess();
 
+	void process_control();
+
 	void process();
 
 	void ThreadProc();
@@ -92,13 +169,26 @@ public:
 
 	bool terminate(time_t timeout = time_t(0) /*InfiniteDuration*/);
 
-	void put(Buffer::ByteArray new_data);
+	void put(Buffer::ByteArray new_data, MessagePriority priority = MessagePriority::Normal);
 
 	void pause(const std::string& reason);
 
 	void resume();
 
 	void acknowledge(int64_t seqn);
+
+	/**
+	 * \brief Makes the thread run the control processor once, between packages or as soon as it's idle, requests made
+	 * meanwhile are merged. Never waits, so it may be called from a timer. A request racing with the thread falling
+	 * asleep may wait for the next one, which suits periodic frames. Requests made while paused run after [resume].
+	 */
+	void request_control();
+
+	/**
+	 * \brief Time from sending a package till its acknowledge, packages resent after a reconnection are timed from
+	 * the resending.
+	 */
+	util::latency_histogram get_ack_rtt() const;
 };
 
 std::string to_string(ByteBufferAsyncProcessor::StateKind state);
@@ -0,0 +1,35 @@
+#include "ByteStream.h"
+
+#include <SimpleSocket.h>
+
+namespace rd
+{
+SocketByteStream::SocketByteStream(std::shared_ptr<CSimpleSocket> socket) : socket(std::move(socket))
+{
+}
+
+int32_t SocketByteStream::send(uint8_t const* data, int32_t len)
+{
+	return socket->Send(data, static_cast<size_t>(len));
+}
+
+int32_t SocketByteStream::receive(uint8_t* data, int32_t len)
+{
+	return socket->Receive(len, data);
+}
+
+bool SocketByteStream::is_valid() const
+{
+	return socket->IsSocketValid();
+}
+
+bool SocketByteStream::shutdown()
+{
+	return socket->Shutdown(CSimpleSocket::Both);
+}
+
+std::string SocketByteStream::describe_error() const
+{
+	return socket->DescribeError();
+}
+}	 // namespace rd
@@ -0,0 +1,85 @@
+#ifndef RD_CPP_BYTESTREAM_H
+#define RD_CPP_BYTESTREAM_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <rd_framework_export.h>
+
+class CSimpleSocket;
+
+namespace rd
+{
+/**
+ * \brief Reliable ordered byte stream under SocketWire::Base. The wire does its own framing, acknowledges and
+ * heartbeats on top of it, so the same protocol runs over TCP, unix domain sockets or shared memory.
+ */
+class RD_FRAMEWORK_API ByteStream
+{
+public:
+	// region ctor/dtor
+
+	ByteStream() = default;
+
+	ByteStream(ByteStream const&) = delete;
+
+	ByteStream& operator=(ByteStream const&) = delete;
+
+	virtual ~ByteStream() = default;
+	// endregion
+
+	/**
+	 * \brief Blocks until all [len] bytes are written.
+	 * \return number of bytes written, less than [len] on failure.
+	 */
+	virtual int32_t send(uint8_t const* data, int32_t len) = 0;
+
+	/**
+	 * \brief Blocks until at least one byte is available.
+	 * \return number of bytes read, 0 if the counterpart shut the stream down, -1 on error.
+	 */
+	virtual int32_t receive(uint8_t* data, int32_t len) = 0;
+
+	virtual bool is_valid() const = 0;
+
+	/**
+	 * \brief Disables both directions, blocked send and receive return.
+	 */
+	virtual bool shutdown() = 0;
+
+	virtual std::string describe_error() const = 0;
+};
+
+/**
+ * \brief ByteStream over a connected clsocket socket.
+ */
+class RD_FRAMEWORK_API SocketByteStream final : public ByteStream
+{
+	std::shared_ptr<CSimpleSocket> socket;
+
+public:
+	explicit SocketByteStream(std::shared_ptr<CSimpleSocket> socket);
+
+	int32_t send(uint8_t const* data, int32_t len) override;
+
+	int32_t receive(uint8_t* data, int32_t len) override;
+
+	bool is_valid() const override;
+
+	bool shutdown() override;
+
+	std::string describe_error() const override;
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_BYTESTREAM_H
@@ -0,0 +1,55 @@
+#include "wire/ReplayWire.h"
+
+#include "wire/WireCapture.h"
+
+#include <thread>
+
+namespace rd
+{
+ReplayWire::ReplayWire(IScheduler* scheduler) : WireBase(scheduler)
+{
+	connected.set(true);
+}
+
+void ReplayWire::send(RdId const& /*id*/, std::function<void(Buffer& buffer)> writer) const
+{
+	Buffer buffer;
+	writer(buffer);
+	++sent_messages;
+	sent_bytes += static_cast<int64_t>(buffer.get_position());
+}
+
+int64_t ReplayWire::replay(std::string const& path, bool realtime) const
+{
+	WireCaptureReader reader(path);
+	WireCapture::Record record;
+	const auto start = std::chrono::steady_clock::now();
+	int64_t dispatched = 0;
+	while (reader.next(record))
+	{
+		if (record.direction != WireCapture::Direction::Incoming)
+		{
+			continue;
+		}
+		if (realtime)
+		{
+			std::this_thread::sleep_until(start + record.timestamp);
+		}
+		Buffer message(std::move(record.payload));
+		message.set_compact(record.compact);
+		message_broker.dispatch(record.id, std::move(message));
+		++dispatched;
+	}
+	return dispatched;
+}
+
+int64_t ReplayWire::get_sent_messages() const
+{
+	return sent_messages;
+}
+
+int64_t ReplayWire::get_sent_bytes() const
+{
+	return sent_bytes;
+}
+}	 // namespace rd
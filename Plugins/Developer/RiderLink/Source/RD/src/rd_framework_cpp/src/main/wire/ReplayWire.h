@@ -0,0 +1,56 @@
+#ifndef RD_CPP_REPLAYWIRE_H
+#define RD_CPP_REPLAYWIRE_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "base/WireBase.h"
+
+#include <atomic>
+#include <string>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Wire without a counterpart which feeds the incoming messages of a [WireCapture] to the entities advised on
+ * it. Lets a recorded session be run against a [Protocol] offline, e.g. to measure dispatch and handler costs.
+ *
+ * Messages sent to the wire are serialized as usual and dropped.
+ */
+class RD_FRAMEWORK_API ReplayWire : public WireBase
+{
+	mutable std::atomic<int64_t> sent_messages{0};
+	mutable std::atomic<int64_t> sent_bytes{0};
+
+public:
+	// region ctor/dtor
+
+	explicit ReplayWire(IScheduler* scheduler);
+
+	virtual ~ReplayWire() override = default;
+	// endregion
+
+	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override;
+
+	/**
+	 * \brief Dispatches incoming messages of the capture at [path] on the calling thread, throws if it can't be read.
+	 * \param realtime keeps the recorded intervals between messages, otherwise they're dispatched back to back.
+	 * \return number of dispatched messages.
+	 */
+	int64_t replay(std::string const& path, bool realtime = false) const;
+
+	int64_t get_sent_messages() const;
+
+	int64_t get_sent_bytes() const;
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_REPLAYWIRE_H
@@ -0,0 +1,527 @@
+#include "wire/ShmWire.h"
+
+#include <util/thread_util.h>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace rd
+{
+std::chrono::milliseconds ShmWire::timeout = std::chrono::milliseconds(500);
+
+constexpr uint32_t ShmWire::DEFAULT_CAPACITY;
+
+#if defined(__linux__)
+namespace
+{
+constexpr uint32_t SEGMENT_MAGIC = 0x52445348;	  // "RDSH"
+constexpr uint32_t SEGMENT_VERSION = 1;
+
+enum : uint32_t
+{
+	STATE_LISTENING = 0,
+	STATE_CONNECTED = 1,
+	STATE_DISCONNECTED = 2,
+	STATE_CLOSED = 3
+};
+
+/**
+ * \brief Waits until [word] changes from [expected], a change of session state wakes every waiter as well.
+ * Timeout only bounds the damage of a counterpart which died without saying so.
+ */
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+	timespec timeout{0, 100 * 1000 * 1000};
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void futex_wake(std::atomic<uint32_t>& word)
+{
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+/**
+ * \brief Control block of one direction. Producer owns [head], consumer owns [tail], each on its own cache line.
+ * [data_seq] and [space_seq] are futex words bumped only when the other side announced it's going to sleep.
+ */
+struct RingControl
+{
+	alignas(64) std::atomic<uint64_t> head;
+	alignas(64) std::atomic<uint64_t> tail;
+	alignas(64) std::atomic<uint32_t> data_seq;
+	std::atomic<uint32_t> consumer_waiting;
+	alignas(64) std::atomic<uint32_t> space_seq;
+	std::atomic<uint32_t> producer_waiting;
+
+	void reset()
+	{
+		head.store(0);
+		tail.store(0);
+		consumer_waiting.store(0);
+		producer_waiting.store(0);
+	}
+};
+
+/**
+ * \brief Layout at the start of the segment, data of both rings follows it. Ring 0 goes from server to client.
+ */
+struct SegmentHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t capacity;
+	alignas(64) std::atomic<uint32_t> state;
+	std::atomic<uint32_t> session;
+	RingControl rings[2];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+	"shared memory rings need address-free atomics");
+
+uint32_t round_up_capacity(uint32_t capacity)
+{
+	uint32_t result = 4096;
+	while (result < capacity && result < (1u << 30))
+	{
+		result <<= 1;
+	}
+	return result;
+}
+}	 // namespace
+
+/**
+ * \brief Mapping of the segment, shared by the wire and its streams so it outlives every pointer into it.
+ */
+struct ShmWire::Segment
+{
+	void* address = MAP_FAILED;
+	size_t size = 0;
+	SegmentHeader* header = nullptr;
+	std::string unlink_name;
+
+	uint8_t* data(int32_t ring) const
+	{
+		return reinterpret_cast<uint8_t*>(header + 1) + static_cast<size_t>(ring) * header->capacity;
+	}
+
+	void wake_all()
+	{
+		futex_wake(header->state);
+		for (auto& ring : header->rings)
+		{
+			ring.data_seq.fetch_add(1);
+			futex_wake(ring.data_seq);
+			ring.space_seq.fetch_add(1);
+			futex_wake(ring.space_seq);
+		}
+	}
+
+	~Segment()
+	{
+		if (address != MAP_FAILED)
+		{
+			munmap(address, size);
+		}
+		if (!unlink_name.empty())
+		{
+			shm_unlink(unlink_name.c_str());
+		}
+	}
+};
+
+namespace
+{
+/**
+ * \brief ByteStream over the rings of one session, writes ring [tx_index] and reads the other one.
+ */
+class ShmByteStream final : public ByteStream
+{
+	std::shared_ptr<ShmWire::Segment> segment;
+	SegmentHeader* header;
+	RingControl& tx;
+	RingControl& rx;
+	uint8_t* tx_data;
+	uint8_t* rx_data;
+	uint64_t mask;
+	uint32_t session;
+	std::atomic<bool> shut{false};
+
+	bool alive() const
+	{
+		return !shut.load() && header->state.load() == STATE_CONNECTED && header->session.load() == session;
+	}
+
+public:
+	ShmByteStream(std::shared_ptr<ShmWire::Segment> segment, int32_t tx_index, uint32_t session)
+		: segment(std::move(segment))
+		, header(this->segment->header)
+		, tx(header->rings[tx_index])
+		, rx(header->rings[1 - tx_index])
+		, tx_data(this->segment->data(tx_index))
+		, rx_data(this->segment->data(1 - tx_index))
+		, mask(header->capacity - 1)
+		, session(session)
+	{
+	}
+
+	int32_t send(uint8_t const* data, int32_t len) override
+	{
+		const uint64_t capacity = mask + 1;
+		int32_t sent = 0;
+		while (sent < len)
+		{
+			if (!alive())
+			{
+				break;
+			}
+			const uint64_t head = tx.head.load(std::memory_order_relaxed);
+			const uint64_t free = capacity - (head - tx.tail.load(std::memory_order_acquire));
+			if (free == 0)
+			{
+				const uint32_t seq = tx.space_seq.load();
+				tx.producer_waiting.store(1);
+				if (head - tx.tail.load() == capacity && alive())
+				{
+					futex_wait(tx.space_seq, seq);
+				}
+				tx.producer_waiting.store(0);
+				continue;
+			}
+
+			const uint64_t n = (std::min)(free, static_cast<uint64_t>(len - sent));
+			const uint64_t offset = head & mask;
+			const uint64_t first = (std::min)(n, capacity - offset);
+			std::memcpy(tx_data + offset, data + sent, first);
+			std::memcpy(tx_data, data + sent + first, n - first);
+			tx.head.store(head + n);
+
+			if (tx.consumer_waiting.load())
+			{
+				tx.data_seq.fetch_add(1);
+				futex_wake(tx.data_seq);
+			}
+			sent += static_cast<int32_t>(n);
+		}
+		return sent;
+	}
+
+	int32_t receive(uint8_t* data, int32_t len) override
+	{
+		const uint64_t capacity = mask + 1;
+		while (true)
+		{
+			const uint64_t tail = rx.tail.load(std::memory_order_relaxed);
+			const uint64_t available = rx.head.load(std::memory_order_acquire) - tail;
+			if (available > 0)
+			{
+				const uint64_t n = (std::min)(available, static_cast<uint64_t>(len));
+				const uint64_t offset = tail & mask;
+				const uint64_t first = (std::min)(n, capacity - offset);
+				std::memcpy(data, rx_data + offset, first);
+				std::memcpy(data + first, rx_data, n - first);
+				rx.tail.store(tail + n);
+
+				if (rx.producer_waiting.load())
+				{
+					rx.space_seq.fetch_add(1);
+					futex_wake(rx.space_seq);
+				}
+				return static_cast<int32_t>(n);
+			}
+			if (!alive())
+			{
+				return 0;
+			}
+
+			const uint32_t seq = rx.data_seq.load();
+			rx.consumer_waiting.store(1);
+			if (rx.head.load() == tail && alive())
+			{
+				futex_wait(rx.data_seq, seq);
+			}
+			rx.consumer_waiting.store(0);
+		}
+	}
+
+	bool is_valid() const override
+	{
+		return alive();
+	}
+
+	bool shutdown() override
+	{
+		shut.store(true);
+		uint32_t expected = STATE_CONNECTED;
+		const bool result = header->session.load() == session &&
+							header->state.compare_exchange_strong(expected, STATE_DISCONNECTED);
+		segment->wake_all();
+		return result;
+	}
+
+	std::string describe_error() const override
+	{
+		return alive() ? "" : "shared memory session is closed";
+	}
+};
+
+std::string make_default_name()
+{
+	static std::atomic<int32_t> counter{0};
+	return "/rd-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+}
+}	 // namespace
+
+bool ShmWire::is_supported()
+{
+	return true;
+}
+
+ShmWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, std::string name, const std::string& id)
+	: Base(id, parentLifetime, scheduler), name(std::move(name)), clientLifetimeDefinition(parentLifetime)
+{
+	Lifetime lifetime = clientLifetimeDefinition.lifetime;
+	thread = std::thread([this, lifetime]() mutable {
+		rd::util::set_thread_name(this->id.empty() ? "ShmWire::Client Thread" : this->id.c_str());
+
+		logger->info("{}: started, segment: {}.", this->id, this->name);
+		while (!lifetime->is_terminated())
+		{
+			try
+			{
+				auto attached = std::make_shared<Segment>();
+				const int fd = shm_open(this->name.c_str(), O_RDWR, 0);
+				RD_ASSERT_THROW_MSG(fd >= 0, fmt::format("{}: failed to open {}, reason: {}", this->id, this->name, std::strerror(errno)));
+				struct stat info{};
+				const bool stat_ok = fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SegmentHeader);
+				if (stat_ok)
+				{
+					attached->size = static_cast<size_t>(info.st_size);
+					attached->address = mmap(nullptr, attached->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+				}
+				close(fd);
+				RD_ASSERT_THROW_MSG(stat_ok && attached->address != MAP_FAILED, fmt::format("{}: failed to map {}", this->id, this->name));
+				attached->header = static_cast<SegmentHeader*>(attached->address);
+
+				SegmentHeader* header = attached->header;
+				RD_ASSERT_THROW_MSG(header->magic == SEGMENT_MAGIC && header->version == SEGMENT_VERSION &&
+										sizeof(SegmentHeader) + 2 * static_cast<size_t>(header->capacity) <= attached->size,
+					fmt::format("{}: {} isn't a wire segment", this->id, this->name));
+
+				// session is only changed by the server while nobody is connected
+				const uint32_t session = header->session.load();
+				uint32_t expected = STATE_LISTENING;
+				RD_ASSERT_THROW_MSG(header->state.compare_exchange_strong(expected, STATE_CONNECTED),
+					fmt::format("{}: {} is busy, state: {}", this->id, this->name, expected));
+				futex_wake(header->state);
+
+				auto stream = std::make_shared<ShmByteStream>(attached, 1, session);
+				{
+					std::lock_guard<decltype(lock)> guard(lock);
+					if (lifetime->is_terminated())
+					{
+						stream->shutdown();
+						break;
+					}
+					connection = stream;
+				}
+
+				set_socket_provider(std::static_pointer_cast<ByteStream>(stream));
+			}
+			catch (std::exception const& e)
+			{
+				logger->debug("{}: connection error for {} ({}).", this->id, this->name, e.what());
+			}
+			if (!wait_for_reconnect(lifetime, timeout))
+			{
+				break;
+			}
+		}
+		logger->info("{}: terminated, segment: {}.", this->id, this->name);
+	});
+
+	lifetime->add_action([this]() {
+		logger->info("{}: starts terminating lifetime", this->id);
+
+		const bool send_buffer_stopped = async_send_buffer.stop(timeout);
+		logger->debug("{}: send buffer stopped, success: {}", this->id, send_buffer_stopped);
+
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			if (connection != nullptr)
+			{
+				connection->shutdown();
+			}
+		}
+		reconnect_cv.notify_all();
+
+		thread.join();
+		logger->info("{}: termination finished", this->id);
+	});
+}
+
+ShmWire::Client::~Client()
+{
+	if (!clientLifetimeDefinition.is_terminated())
+	{
+		clientLifetimeDefinition.terminate();
+	}
+}
+
+ShmWire::Server::Server(Lifetime parentLifetime, IScheduler* scheduler, std::string name, uint32_t capacity, const std::string& id)
+	: Base(id, parentLifetime, scheduler)
+	, name(name.empty() ? make_default_name() : std::move(name))
+	, segment(std::make_shared<Segment>())
+	, serverLifetimeDefinition(parentLifetime)
+{
+	capacity = round_up_capacity(capacity);
+
+	const int fd = shm_open(this->name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	RD_ASSERT_THROW_MSG(fd >= 0, fmt::format("{}: failed to create {}, reason: {}", this->id, this->name, std::strerror(errno)));
+	segment->unlink_name = this->name;
+	segment->size = sizeof(SegmentHeader) + 2 * static_cast<size_t>(capacity);
+	if (ftruncate(fd, static_cast<off_t>(segment->size)) == 0)
+	{
+		segment->address = mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	close(fd);
+	RD_ASSERT_THROW_MSG(segment->address != MAP_FAILED, fmt::format("{}: failed to map {}", this->id, this->name));
+
+	SegmentHeader* header = new (segment->address) SegmentHeader{};
+	header->magic = SEGMENT_MAGIC;
+	header->version = SEGMENT_VERSION;
+	header->capacity = capacity;
+	segment->header = header;
+	logger->info("{}: listening {}, capacity: {}", this->id, this->name, capacity);
+
+	Lifetime lifetime = serverLifetimeDefinition.lifetime;
+	thread = std::thread([this, lifetime, header]() mutable {
+		rd::util::set_thread_name(this->id.empty() ? "ShmWire::Server Thread" : this->id.c_str());
+
+		logger->info("{}: started, segment: {}.", this->id, this->name);
+		while (!lifetime->is_terminated())
+		{
+			const uint32_t state = header->state.load();
+			if (state == STATE_LISTENING)
+			{
+				futex_wait(header->state, STATE_LISTENING);
+				continue;
+			}
+			if (state == STATE_CLOSED)
+			{
+				break;
+			}
+
+			if (state == STATE_CONNECTED)
+			{
+				logger->info("{}: client attached", this->id);
+				auto stream = std::make_shared<ShmByteStream>(segment, 0, header->session.load());
+				{
+					std::lock_guard<decltype(lock)> guard(lock);
+					if (lifetime->is_terminated())
+					{
+						break;
+					}
+					connection = stream;
+				}
+				try
+				{
+					set_socket_provider(std::static_pointer_cast<ByteStream>(stream));
+				}
+				catch (std::exception const& e)
+				{
+					logger->info("{}: closed with exception: {}", this->id, e.what());
+				}
+				stream->shutdown();
+			}
+
+			// client detached, prepare rings for the next one
+			std::lock_guard<decltype(lock)> guard(lock);
+			if (lifetime->is_terminated())
+			{
+				break;
+			}
+			for (auto& ring : header->rings)
+			{
+				ring.reset();
+			}
+			header->session.fetch_add(1);
+			uint32_t expected = STATE_DISCONNECTED;
+			header->state.compare_exchange_strong(expected, STATE_LISTENING);
+		}
+		logger->info("{}: terminated, segment: {}.", this->id, this->name);
+	});
+
+	lifetime->add_action([this] {
+		logger->info("{}: start terminating lifetime", this->id);
+
+		const bool send_buffer_stopped = async_send_buffer.stop(timeout);
+		logger->debug("{}: send buffer stopped, success: {}", this->id, send_buffer_stopped);
+
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			segment->header->state.store(STATE_CLOSED);
+			segment->wake_all();
+		}
+
+		thread.join();
+		logger->info("{}: termination finished", this->id);
+	});
+}
+
+ShmWire::Server::~Server()
+{
+	if (!serverLifetimeDefinition.is_terminated())
+	{
+		serverLifetimeDefinition.terminate();
+	}
+}
+#else
+struct ShmWire::Segment
+{
+};
+
+bool ShmWire::is_supported()
+{
+	return false;
+}
+
+ShmWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, std::string name, const std::string& id)
+	: Base(id, parentLifetime, scheduler), name(std::move(name)), clientLifetimeDefinition(parentLifetime)
+{
+	throw std::runtime_error("shared memory wire isn't supported on this platform");
+}
+
+ShmWire::Client::~Client() = default;
+
+ShmWire::Server::Server(Lifetime parentLifetime, IScheduler* scheduler, std::string name, uint32_t capacity, const std::string& id)
+	: Base(id, parentLifetime, scheduler), name(std::move(name)), serverLifetimeDefinition(parentLifetime)
+{
+	throw std::runtime_error("shared memory wire isn't supported on this platform");
+}
+
+ShmWire::Server::~Server() = default;
+#endif
+
+std::string ShmWire::Client::get_address() const
+{
+	return "shm:" + name;
+}
+
+std::string ShmWire::Server::get_address() const
+{
+	return "shm:" + name;
+}
+}	 // namespace rd
@@ -0,0 +1,90 @@
+#ifndef RD_CPP_SHMWIRE_H
+#define RD_CPP_SHMWIRE_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "SocketWire.h"
+
+#include <string>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief SocketWire protocol (same framing, acknowledges and heartbeats) over a pair of single-producer
+ * single-consumer byte rings in a named shared memory segment. Sides wake each other with futexes living in the
+ * segment, so an idle or flowing connection makes no syscalls except when a side has to sleep.
+ *
+ * The segment holds one session at a time: a client attaches while the server is listening, and the server resets
+ * the rings for the next client after the session ends.
+ *
+ * Available on Linux, see [is_supported].
+ */
+class RD_FRAMEWORK_API ShmWire
+{
+	static std::chrono::milliseconds timeout;
+
+public:
+	/**
+	 * \brief Bytes in each direction, rounded up to a power of two.
+	 */
+	static constexpr uint32_t DEFAULT_CAPACITY = 1u << 20;
+
+	static bool is_supported();
+
+	struct Segment;
+
+	class RD_FRAMEWORK_API Client : public SocketWire::Base
+	{
+	public:
+		std::string name;
+
+		// region ctor/dtor
+
+		Client(Lifetime parentLifetime, IScheduler* scheduler, std::string name, const std::string& id = "ShmClient");
+
+		virtual ~Client() override;
+		// endregion
+
+		std::string get_address() const override;
+
+	private:
+		std::shared_ptr<ByteStream> connection;
+		LifetimeDefinition clientLifetimeDefinition;
+	};
+
+	class RD_FRAMEWORK_API Server : public SocketWire::Base
+	{
+	public:
+		/**
+		 * \brief Name of the shared memory object, a fresh one if empty name was given.
+		 */
+		std::string name;
+
+		// region ctor/dtor
+
+		Server(Lifetime parentLifetime, IScheduler* scheduler, std::string name = "", uint32_t capacity = DEFAULT_CAPACITY,
+			const std::string& id = "ShmServer");
+
+		virtual ~Server() override;
+		// endregion
+
+		std::string get_address() const override;
+
+	private:
+		std::shared_ptr<Segment> segment;
+		std::shared_ptr<ByteStream> connection;
+		LifetimeDefinition serverLifetimeDefinition;
+	};
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_SHMWIRE_H
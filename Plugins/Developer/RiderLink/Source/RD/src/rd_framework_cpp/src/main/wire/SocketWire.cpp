@@ -1,6 +1,10 @@
 #include "wire/SocketWire.h"
 
+#include "scheduler/TimerWheel.h"
+
+#include <util/lz_block.h>
 #include <util/thread_util.h>
+#include <util/trace.h>
 
 #include "spdlog/sinks/stdout_color_sinks.h"
 
@@ -19,9 +23,53 @@ std::shared_ptr<spdlog::logger> SocketWire::Base::logger =
 
 std::chrono::milliseconds SocketWire::timeout = std::chrono::milliseconds(500);
 
+namespace
+{
+/**
+ * \brief Holds the socket send lock for a ping or an acknowledge. Message packages don't take the lock while any of
+ * these is waiting, so control frames never queue behind a stream of chunks.
+ */
+class ControlFrameGuard
+{
+	std::atomic<int32_t>& pending;
+	std::condition_variable& var;
+	std::unique_lock<std::mutex> guard;
+
+public:
+	ControlFrameGuard(std::mutex& lock, std::atomic<int32_t>& pending, std::condition_variable& var)
+		: pending(pending), var(var)
+	{
+		++this->pending;
+		guard = std::unique_lock<std::mutex>(lock);
+	}
+
+	~ControlFrameGuard()
+	{
+		// decremented under the lock, so send0 can't miss the notification between its check and wait
+		const bool last = --pending == 0;
+		guard.unlock();
+		if (last)
+		{
+			var.notify_all();
+		}
+	}
+};
+}	 // namespace
+
 constexpr int32_t SocketWire::Base::ACK_MESSAGE_LENGTH;
 constexpr int32_t SocketWire::Base::PING_MESSAGE_LENGTH;
 constexpr int32_t SocketWire::Base::PACKAGE_HEADER_LENGTH;
+constexpr int32_t SocketWire::Base::COMPRESSED_MESSAGE_LENGTH;
+constexpr int32_t SocketWire::Base::COMPRESSED_PACKAGE_HEADER_LENGTH;
+constexpr int32_t SocketWire::Base::COMPACT_MESSAGE_FLAG;
+
+/**
+ * \brief Receiver of [SocketWire::Base::send_capabilities], handled by the wire itself.
+ */
+static constexpr RdId CAPABILITIES_ID = RdId::Null().mix("SocketWire.Capabilities");
+static constexpr int32_t CAPABILITY_LZ_BLOCK = 1;
+static constexpr int32_t CAPABILITY_COMPACT_ENCODING = 2;
+static constexpr int32_t CAPABILITY_COLLECTION_BATCH = 4;
 
 SocketWire::Base::Base(std::string id, Lifetime parentLifetime, IScheduler* scheduler)
 	: WireBase(scheduler), id(std::move(id)), scheduler(scheduler), lifetimeDef(parentLifetime)
@@ -45,7 +93,7 @@ void SocketWire::Base::receiverProc() const
 	{
 		try
 		{
-			if (!socket_provider->IsSocketValid())
+			if (!socket_provider->is_valid())
 			{
 				logger->debug("{}: stop receive messages because socket disconnected", this->id);
 				//					async_send_buffer.terminate();
@@ -72,26 +120,53 @@ bool SocketWire::Base::send0(Buffer::ByteArray const& msg, sequence_number_t seq
 {
 	try
 	{
-		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+		std::unique_lock<decltype(socket_send_lock)> guard(socket_send_lock);
+		socket_send_var.wait(guard, [this] { return control_pending.load() == 0; });
 
 		int32_t msglen = static_cast<int32_t>(msg.size());
 
+		if (msglen >= COMPRESSION_THRESHOLD && compression_enabled && counterpart_decompresses)
+		{
+			compressed_send_buffer.resize(static_cast<size_t>(msglen));
+			// not worth it unless it saves more than the longer header
+			const int32_t packed_len =
+				util::lz_block::compress(msg.data(), msglen, compressed_send_buffer.data(), msglen - 2 * sizeof(int32_t));
+			if (packed_len > 0)
+			{
+				compressed_package_header.rewind();
+				compressed_package_header.write_integral(COMPRESSED_MESSAGE_LENGTH);
+				compressed_package_header.write_integral(seqn);
+				compressed_package_header.write_integral(msglen);
+				compressed_package_header.write_integral(packed_len);
+
+				RD_ASSERT_THROW_MSG(socket_provider->send(compressed_package_header.data(),
+										compressed_package_header.get_position()) == COMPRESSED_PACKAGE_HEADER_LENGTH,
+					this->id + ": failed to send header over the network, reason: " + socket_provider->describe_error())
+				RD_ASSERT_THROW_MSG(socket_provider->send(compressed_send_buffer.data(), packed_len) == packed_len,
+					this->id + ": failed to send package over the network, reason: " + socket_provider->describe_error());
+				raw_bytes_sent += msglen;
+				compressed_bytes_sent += packed_len;
+				RD_LOG_TRACE(logger, "{}: were sent {} bytes compressed to {}", this->id, msglen, packed_len);
+				return true;
+			}
+		}
+
 		send_package_header.rewind();
 		send_package_header.write_integral(msglen);
 		send_package_header.write_integral(seqn);
 
 		RD_ASSERT_THROW_MSG(
-			socket_provider->Send(send_package_header.data(), send_package_header.get_position()) == PACKAGE_HEADER_LENGTH,
+			socket_provider->send(send_package_header.data(), send_package_header.get_position()) == PACKAGE_HEADER_LENGTH,
 			this->id +
 				": failed to send header over the network"
 				", reason: " +
-				socket_provider->DescribeError())
+				socket_provider->describe_error())
 
-		RD_ASSERT_THROW_MSG(socket_provider->Send(msg.data(), msglen) == msglen, this->id +
+		RD_ASSERT_THROW_MSG(socket_provider->send(msg.data(), msglen) == msglen, this->id +
 																					 ": failed to send package over the network"
 																					 ", reason: " +
-																					 socket_provider->DescribeError());
-		logger->info("{}: were sent {} bytes", this->id, msglen);
+																					 socket_provider->describe_error());
+		RD_LOG_TRACE(logger, "{}: were sent {} bytes", this->id, msglen);
 		//        RD_ASSERT_MSG(socketProvider->Flush(), "{}: failed to flush");
 		return true;
 	}
@@ -104,6 +179,11 @@ bool SocketWire::Base::send0(Buffer::ByteArray const& msg, sequence_number_t seq
 }
 
 void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const
+{
+	send(rd_id, std::move(writer), MessagePriority::Normal);
+}
+
+void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer, MessagePriority priority) const
 {
 	RD_ASSERT_MSG(!rd_id.isNull(), "{}: id mustn't be null");
 
@@ -111,21 +191,40 @@ void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer
 	local_send_buffer.write_integral<int32_t>(0);	 // placeholder for length
 	rd_id.write(local_send_buffer);					 // write id
 	local_send_buffer.write_integral<int16_t>(0);	 // placeholder for context
+	local_send_buffer.set_compact(compact_encoding_enabled && counterpart_reads_compact);
 	writer(local_send_buffer);						 // write rest
 
 	int32_t len = static_cast<int32_t>(local_send_buffer.get_position());
+	const bool compact = local_send_buffer.is_compact();
 
 	local_send_buffer.rewind();
-	local_send_buffer.write_integral<int32_t>(len - 4);
+	local_send_buffer.write_integral<int32_t>((len - 4) | (compact ? COMPACT_MESSAGE_FLAG : 0));
 	local_send_buffer.set_position(len);
-	async_send_buffer.put(std::move(local_send_buffer).getRealArray());
+
+	constexpr int32_t prefix = sizeof(int32_t) + sizeof(RdId::hash_t);	  // length and id
+	if (metrics.is_enabled())
+	{
+		metrics.record_message(rd_id, WireMetrics::Direction::Outgoing, static_cast<size_t>(len - prefix));
+	}
+	trace_ring.record(rd_id, TraceRing::Op::Send, static_cast<size_t>(len - prefix));
+	if (const auto current_capture = std::atomic_load(&capture))
+	{
+		current_capture->record(WireCapture::Direction::Outgoing, 0, rd_id, compact, local_send_buffer.data() + prefix,
+			static_cast<size_t>(len - prefix));
+	}
+	async_send_buffer.put(std::move(local_send_buffer).getRealArray(), priority);
 }
 
 void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_socket)
+{
+	set_socket_provider(std::make_shared<SocketByteStream>(std::move(new_socket)));
+}
+
+void SocketWire::Base::set_socket_provider(std::shared_ptr<ByteStream> new_stream)
 {
 	{
 		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
-		socket_provider = std::move(new_socket);
+		socket_provider = std::move(new_stream);
 		socket_send_var.notify_all();
 	}
 	{
@@ -136,8 +235,18 @@ void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_so
 		}
 	}
 
-	auto heartbeat = LifetimeDefinition::use([this](Lifetime heartbeatLifetime) {
-		const auto heartbeat = start_heartbeat(heartbeatLifetime).share();
+	LifetimeDefinition::use([this](Lifetime heartbeatLifetime) {
+		start_heartbeat(heartbeatLifetime);
+
+		// the counterpart may have been replaced by one without compression support
+		counterpart_decompresses = false;
+		counterpart_reads_compact = false;
+		counterpart_reads_batches_ = false;
+		capabilities_sent = false;
+		if (compression_enabled || compact_encoding_enabled || batch_messages_enabled)
+		{
+			send_capabilities();
+		}
 
 		async_send_buffer.resume();
 
@@ -148,38 +257,62 @@ void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_so
 		connected.set(false);
 
 		async_send_buffer.pause("Disconnected");
-
-		return heartbeat;
 	});
-	const auto status = heartbeat.wait_for(timeout);
 
-	logger->debug("{}: waited for heartbeat to stop with status: {}", this->id, static_cast<uint32_t>(status));
+	// a ping requested before the timer was cancelled is sent by [async_send_buffer] after it resumes, pings handle a
+	// closed socket
+	logger->debug("{}: heartbeat stopped", this->id);
+
+	const auto stats = get_compression_stats();
+	if (stats.compressed_bytes_sent != 0 || stats.compressed_bytes_received != 0)
+	{
+		logger->info("{}: compressed packages, sent: {} -> {} bytes, received: {} -> {} bytes", this->id,
+			stats.raw_bytes_sent, stats.compressed_bytes_sent, stats.compressed_bytes_received, stats.raw_bytes_received);
+	}
 
-	if (!socket_provider->IsSocketValid())
+	if (!socket_provider->is_valid())
 	{
 		logger->debug("{}: socket was already shut down", this->id);
 	}
-	else if (!socket_provider->Shutdown(CSimpleSocket::Both))
+	else if (!socket_provider->shutdown())
 	{
 		// double close?
 		logger->warn("{}: possibly double close after disconnect", this->id);
 	}
 }
 
+bool SocketWire::Base::wait_for_reconnect(Lifetime const& lifetime, std::chrono::milliseconds delay)
+{
+	std::unique_lock<decltype(lock)> guard(lock);
+	if (lifetime->is_terminated())
+	{
+		return false;
+	}
+	reconnect_due = false;
+	const auto reconnect_timer = TimerWheel::Instance().schedule(delay, [this] {
+		{
+			std::lock_guard<decltype(lock)> timer_guard(lock);
+			reconnect_due = true;
+		}
+		reconnect_cv.notify_all();
+	});
+	reconnect_cv.wait(guard, [this, &lifetime] { return reconnect_due || lifetime->is_terminated(); });
+	const bool should_reconnect = !lifetime->is_terminated();
+
+	// the timer action takes the lock
+	guard.unlock();
+	TimerWheel::Instance().cancel(reconnect_timer);
+	return should_reconnect;
+}
+
 bool SocketWire::Base::connection_established(int32_t timestamp, int32_t notion_timestamp)
 {
 	return timestamp - notion_timestamp <= MaximumHeartbeatDelay;
 }
 
-std::future<void> SocketWire::Base::start_heartbeat(Lifetime lifetime)
+void SocketWire::Base::start_heartbeat(Lifetime lifetime)
 {
-	return std::async([this, lifetime] {
-		while (!lifetime->is_terminated())
-		{
-			std::this_thread::sleep_for(heartBeatInterval);
-			ping();
-		}
-	});
+	TimerWheel::Instance().schedule_periodic(lifetime, heartBeatInterval, [this] { async_send_buffer.request_control(); });
 }
 
 bool SocketWire::Base::read_from_socket(Buffer::word_t* res, int32_t msglen) const
@@ -205,14 +338,13 @@ bool SocketWire::Base::read_from_socket(Buffer::word_t* res, int32_t msglen) con
 			{
 				hi = lo = receiver_buffer.begin();
 			}
-			logger->info("{}: receive started", this->id);
-			int32_t read = socket_provider->Receive(static_cast<int32_t>(receiver_buffer.end() - hi), &*hi);
+			RD_LOG_TRACE(logger, "{}: receive started", this->id);
+			int32_t read = socket_provider->receive(&*hi, static_cast<int32_t>(receiver_buffer.end() - hi));
 			if (read == -1)
 			{
-				auto err = socket_provider->GetSocketError();
-				if (err == CSimpleSocket::SocketInvalidSocket)
+				if (!socket_provider->is_valid())
 				{
-					logger->info("{}: socket was shut down for receiving", this->id);
+					logger->debug("{}: socket was shut down for receiving", this->id);
 					return false;
 				}
 				logger->error("{}: error has occurred while receiving", this->id);
@@ -220,13 +352,13 @@ bool SocketWire::Base::read_from_socket(Buffer::word_t* res, int32_t msglen) con
 			}
 			if (read == 0)
 			{
-				logger->info("{}: socket was shut down for receiving", this->id);
+				logger->debug("{}: socket was shut down for receiving", this->id);
 				return false;
 			}
 			hi += read;
 			if (read > 0)
 			{
-				logger->info("{}: receive finished: {} bytes read", this->id, read);
+				RD_LOG_TRACE(logger, "{}: receive finished: {} bytes read", this->id, read);
 			}
 		}
 	}
@@ -300,43 +432,63 @@ std::pair<int, sequence_number_t> SocketWire::Base::read_header() const
 
 int32_t SocketWire::Base::read_package() const
 {
-	receive_pkg.rewind();
-
-	const auto pair = read_header();
-	if (pair == INVALID_HEADER)
+	while (true)
 	{
-		logger->debug("{}: failed to read header", this->id);
-		return -1;
-	}
-	const auto len = pair.first;
-	const auto seqn = pair.second;
+		receive_pkg.rewind();
 
-	logger->debug("{}: read len={}, seqn={}, max_received_seqn={}", this->id, len, seqn, max_received_seqn);
+		const auto pair = read_header();
+		if (pair == INVALID_HEADER)
+		{
+			logger->debug("{}: failed to read header", this->id);
+			return -1;
+		}
+		auto len = pair.first;
+		const auto seqn = pair.second;
 
-	receive_pkg.require_available(len);
-	if (!read_data_from_socket(receive_pkg.data(), len))
-	{
-		logger->debug("{}: failed to read package", this->id);
-		return -1;
-	}
-	send_ack(seqn);
-	if (seqn <= max_received_seqn && seqn != 1)
-	{
-		return true;
-	}
-	max_received_seqn = seqn;
+		RD_LOG_DEBUG(logger, "{}: read len={}, seqn={}, max_received_seqn={}", this->id, len, seqn, max_received_seqn);
 
-	logger->info("{}: was received package, bytes={}, seqn={}", this->id, len, seqn);
-	return len;
+		if (len == COMPRESSED_MESSAGE_LENGTH)
+		{
+			if (!read_compressed_package(len))
+			{
+				return -1;
+			}
+		}
+		else
+		{
+			receive_pkg.require_available(len);
+			if (!read_data_from_socket(receive_pkg.data(), len))
+			{
+				logger->debug("{}: failed to read package", this->id);
+				return -1;
+			}
+		}
+		send_ack(seqn);
+		if (seqn <= max_received_seqn && seqn != 1)
+		{
+			// resent after reconnect, the message it belongs to may be half read, so it's skipped as a whole
+			logger->debug("{}: skipped already received package, seqn={}", this->id, seqn);
+			continue;
+		}
+		max_received_seqn = seqn;
+
+		RD_LOG_TRACE(logger, "{}: was received package, bytes={}, seqn={}", this->id, len, seqn);
+		return len;
+	}
 }
 
 bool SocketWire::Base::read_and_dispatch_message() const
 {
-	sz = (sz == -1 ? receive_pkg.read_integral<int32_t>() : sz);
 	if (sz == -1)
 	{
-		logger->debug("{}: sz == -1", this->id);
-		return false;
+		sz = receive_pkg.read_integral<int32_t>();
+		if (sz == -1)
+		{
+			logger->debug("{}: sz == -1", this->id);
+			return false;
+		}
+		message_compact = (sz & COMPACT_MESSAGE_FLAG) != 0;
+		sz &= ~COMPACT_MESSAGE_FLAG;
 	}
 	id_ = (id_ == -1 ? receive_pkg.read_integral<RdId::hash_t>() : id_);
 	if (id_ == -1)
@@ -344,7 +496,7 @@ bool SocketWire::Base::read_and_dispatch_message() const
 		logger->error("id == -1");
 		return false;
 	}
-	logger->trace("{}: message info: sz={}, id={}", this->id, sz, id_);
+	RD_LOG_TRACE(logger, "{}: message info: sz={}, id={}", this->id, sz, id_);
 	const RdId rd_id{id_};
 	sz -= 8;	// RdId
 	message.require_available(sz);
@@ -355,9 +507,33 @@ bool SocketWire::Base::read_and_dispatch_message() const
 		return false;
 	}
 
-	logger->debug("{}: message received", this->id);
-	message_broker.dispatch(rd_id, std::move(message));
-	logger->debug("{}: message dispatched", this->id);
+	RD_LOG_DEBUG(logger, "{}: message received", this->id);
+	if (rd_id == CAPABILITIES_ID)
+	{
+		message.read_integral<int16_t>();	 // skip context
+		const auto capabilities = message.read_integral<int32_t>();
+		counterpart_decompresses = (capabilities & CAPABILITY_LZ_BLOCK) != 0;
+		counterpart_reads_compact = (capabilities & CAPABILITY_COMPACT_ENCODING) != 0;
+		counterpart_reads_batches_ = (capabilities & CAPABILITY_COLLECTION_BATCH) != 0;
+		logger->info("{}: counterpart capabilities: {}", this->id, capabilities);
+		if (!capabilities_sent)
+		{
+			send_capabilities();
+		}
+	}
+	else
+	{
+		if (const auto current_capture = std::atomic_load(&capture))
+		{
+			current_capture->record(WireCapture::Direction::Incoming, max_received_seqn, rd_id, message_compact, message.data(),
+				static_cast<size_t>(sz));
+		}
+		// the buffer grows in steps, so it's trimmed to the message for the broker to count its size
+		message.get_data().resize(static_cast<size_t>(sz));
+		message.set_compact(message_compact);
+		message_broker.dispatch(rd_id, std::move(message));
+		RD_LOG_DEBUG(logger, "{}: message dispatched", this->id);
+	}
 
 	sz = -1;
 	id_ = -1;
@@ -366,7 +542,101 @@ bool SocketWire::Base::read_and_dispatch_message() const
 	//		RD_ASSERT_MSG(summary_size == sz, "Broken message, read:%d bytes, expected:%d bytes", summary_size, sz)
 }
 
-CSimpleSocket* SocketWire::Base::get_socket_provider() const
+bool SocketWire::Base::read_compressed_package(int32_t& len) const
+{
+	int32_t raw_len = 0;
+	int32_t packed_len = 0;
+	if (!read_integral_from_socket(raw_len) || !read_integral_from_socket(packed_len))
+	{
+		logger->debug("{}: failed to read header", this->id);
+		return false;
+	}
+	if (raw_len <= 0 || packed_len <= 0 || packed_len > raw_len)
+	{
+		logger->error("{}: malformed compressed package, raw={}, compressed={}", this->id, raw_len, packed_len);
+		return false;
+	}
+	compressed_receive_buffer.resize(static_cast<size_t>(packed_len));
+	if (!read_data_from_socket(compressed_receive_buffer.data(), packed_len))
+	{
+		logger->debug("{}: failed to read package", this->id);
+		return false;
+	}
+	receive_pkg.require_available(raw_len);
+	if (!util::lz_block::decompress(compressed_receive_buffer.data(), packed_len, receive_pkg.data(), raw_len))
+	{
+		logger->error("{}: malformed compressed package, raw={}, compressed={}", this->id, raw_len, packed_len);
+		return false;
+	}
+	raw_bytes_received += raw_len;
+	compressed_bytes_received += packed_len;
+	len = raw_len;
+	return true;
+}
+
+void SocketWire::Base::send_capabilities() const
+{
+	capabilities_sent = true;
+	send(CAPABILITIES_ID,
+		[](Buffer& buffer) {
+			buffer.write_integral<int32_t>(CAPABILITY_LZ_BLOCK | CAPABILITY_COMPACT_ENCODING | CAPABILITY_COLLECTION_BATCH);
+		},
+		MessagePriority::Interactive);
+}
+
+void SocketWire::Base::set_compression_enabled(bool enabled)
+{
+	compression_enabled = enabled;
+}
+
+void SocketWire::Base::set_compact_encoding_enabled(bool enabled)
+{
+	compact_encoding_enabled = enabled;
+}
+
+void SocketWire::Base::set_batch_messages_enabled(bool enabled)
+{
+	batch_messages_enabled = enabled;
+}
+
+bool SocketWire::Base::counterpart_reads_batches() const
+{
+	return batch_messages_enabled && counterpart_reads_batches_;
+}
+
+WireMetrics::Snapshot SocketWire::Base::get_metrics_snapshot() const
+{
+	auto result = WireBase::get_metrics_snapshot();
+	result.ack_rtt = async_send_buffer.get_ack_rtt();
+	return result;
+}
+
+SocketWire::Base::CompressionStats SocketWire::Base::get_compression_stats() const
+{
+	CompressionStats stats;
+	stats.raw_bytes_sent = raw_bytes_sent;
+	stats.compressed_bytes_sent = compressed_bytes_sent;
+	stats.compressed_bytes_received = compressed_bytes_received;
+	stats.raw_bytes_received = raw_bytes_received;
+	return stats;
+}
+
+void SocketWire::Base::start_capture(std::string const& path)
+{
+	auto new_capture = std::make_shared<WireCapture>(path);
+	logger->info("{}: capture started: {}", this->id, path);
+	std::atomic_store(&capture, std::move(new_capture));
+}
+
+void SocketWire::Base::stop_capture()
+{
+	// the last record may still be written by the thread holding the previous value, the file is flushed when it's
+	// released
+	std::atomic_store(&capture, std::shared_ptr<WireCapture>());
+	logger->info("{}: capture stopped", this->id);
+}
+
+ByteStream* SocketWire::Base::get_socket_provider() const
 {
 	return socket_provider.get();
 }
@@ -392,15 +662,15 @@ void SocketWire::Base::ping() const
 		ping_pkg_header.write_integral(current_timestamp);
 		ping_pkg_header.write_integral(counterpart_timestamp);
 		{
-			std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
-			int32_t sent = socket_provider->Send(ping_pkg_header.data(), ping_pkg_header.get_position());
-			if (sent == 0 && !socket_provider->IsSocketValid())
+			ControlFrameGuard guard(socket_send_lock, control_pending, socket_send_var);
+			int32_t sent = socket_provider->send(ping_pkg_header.data(), ping_pkg_header.get_position());
+			if (sent == 0 && !socket_provider->is_valid())
 			{
 				logger->debug("{}: failed to send ping over the network, reason: socket was shut down for sending", this->id);
 				return;
 			}
 			RD_ASSERT_THROW_MSG(sent == PACKAGE_HEADER_LENGTH,
-				fmt::format("{}: failed to send ping over the network, reason: {}", this->id, socket_provider->DescribeError()))
+				fmt::format("{}: failed to send ping over the network, reason: {}", this->id, socket_provider->describe_error()))
 		}
 
 		++current_timestamp;
@@ -413,19 +683,19 @@ void SocketWire::Base::ping() const
 
 bool SocketWire::Base::send_ack(sequence_number_t seqn) const
 {
-	logger->trace("{} send ack {}", id, seqn);
+	RD_LOG_TRACE(logger, "{} send ack {}", id, seqn);
 	try
 	{
 		ack_buffer.rewind();
 		ack_buffer.write_integral(ACK_MESSAGE_LENGTH);
 		ack_buffer.write_integral(seqn);
 		{
-			std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
-			RD_ASSERT_THROW_MSG(socket_provider->Send(ack_buffer.data(), ack_buffer.get_position()) == PACKAGE_HEADER_LENGTH,
+			ControlFrameGuard guard(socket_send_lock, control_pending, socket_send_var);
+			RD_ASSERT_THROW_MSG(socket_provider->send(ack_buffer.data(), ack_buffer.get_position()) == PACKAGE_HEADER_LENGTH,
 				this->id +
 					": failed to send ack over the network"
 					", reason: " +
-					socket_provider->DescribeError())
+					socket_provider->describe_error())
 		}
 		return true;
 	}
@@ -442,7 +712,7 @@ bool SocketWire::Base::try_shutdown_connection() const
 	if (s == nullptr)
 		return false;
 
-	return s->Shutdown(CSimpleSocket::Both);
+	return s->shutdown();
 }
 
 SocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, uint16_t port, const std::string& id)
@@ -493,14 +763,7 @@ SocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, uint1
 				{
 					logger->debug("{}: connection error for port {} ({}).", this->id, this->port, e.what());
 
-					std::lock_guard<decltype(lock)> guard(lock);
-					bool should_reconnect = false;
-					if (!lifetime->is_terminated())
-					{
-						cv.wait_for(lock, timeout);
-						should_reconnect = !lifetime->is_terminated();
-					}
-					if (should_reconnect)
+					if (wait_for_reconnect(lifetime, timeout))
 					{
 						continue;
 					}
@@ -533,7 +796,7 @@ SocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, uint1
 				}
 			}
 		}
-		cv.notify_all();
+		reconnect_cv.notify_all();
 
 		logger->debug("{}: waiting for receiver thread", this->id);
 		logger->debug("{}: is thread joinable? {}", this->id, thread.joinable());
@@ -550,6 +813,11 @@ SocketWire::Client::~Client()
 	}
 }
 
+std::string SocketWire::Client::get_address() const
+{
+	return std::to_string(port);
+}
+
 SocketWire::Server::Server(Lifetime parentLifetime, IScheduler* scheduler, uint16_t port, const std::string& id)
 	: Base(id, parentLifetime, scheduler), ss(std::make_unique<CPassiveSocket>()), serverLifetimeDefinition(parentLifetime)
 {
@@ -662,4 +930,9 @@ SocketWire::Server::~Server()
 	}
 }
 
+std::string SocketWire::Server::get_address() const
+{
+	return std::to_string(port);
+}
+
 }	 // namespace rd
@@ -9,10 +9,13 @@
 #include "scheduler/base/IScheduler.h"
 #include "base/WireBase.h"
 #include "ByteBufferAsyncProcessor.h"
+#include "ByteStream.h"
 #include "PkgInputStream.h"
+#include "WireCapture.h"
 
 #include <string>
 #include <array>
+#include <atomic>
 #include <condition_variable>
 
 #include <rd_framework_export.h>
@@ -41,13 +44,25 @@ public:
 
 		std::string id;
 		IScheduler* scheduler = nullptr;
-		std::shared_ptr<CSimpleSocket> socket_provider;
+		std::shared_ptr<ByteStream> socket_provider;
 
 		std::shared_ptr<CActiveSocket> socket;
 
 		mutable std::condition_variable socket_send_var;
+		/**
+		 * \brief Pings and acknowledges waiting for [socket_send_lock], packages of messages give way to them on
+		 * [socket_send_var].
+		 */
+		mutable std::atomic<int32_t> control_pending{0};
+
+		std::condition_variable_any reconnect_cv;
+		/**
+		 * \brief Set by the reconnect timer, guarded by [lock].
+		 */
+		bool reconnect_due = false;
 		mutable ByteBufferAsyncProcessor async_send_buffer{id + "-AsyncSendProcessor",
-			[this](Buffer::ByteArray const& it, sequence_number_t seqn) -> bool { return this->send0(it, seqn); }};
+			[this](Buffer::ByteArray const& it, sequence_number_t seqn) -> bool { return this->send0(it, seqn); }, CHUNK_SIZE,
+			SEND_WINDOW, [this] { this->ping(); }};
 
 		static constexpr size_t RECEIVE_BUFFER_SIZE = 1u << 16;
 		mutable std::array<Buffer::word_t, RECEIVE_BUFFER_SIZE> receiver_buffer{};
@@ -78,13 +93,72 @@ public:
 		mutable sequence_number_t max_received_seqn = 0;
 		mutable Buffer send_package_header{PACKAGE_HEADER_LENGTH};
 
+		/**
+		 * \brief Maximum package payload, longer messages are sent as a sequence of packages and reassembled by
+		 * [receive_pkg] on the other side.
+		 */
 		static constexpr int32_t CHUNK_SIZE = 16370;
+		/**
+		 * \brief Bytes sent ahead of the counterpart's acknowledges, each ACK returns the credit of its package.
+		 */
+		static constexpr int64_t SEND_WINDOW = 1 << 20;
 		mutable int32_t sz = -1;
 		mutable RdId::hash_t id_ = -1;
 		mutable PkgInputStream receive_pkg{[this]() -> int32_t { return this->read_package(); }};
 
 		mutable Buffer message{CHUNK_SIZE};
 
+		/**
+		 * \brief Header of a compressed package: the header of a plain one with [COMPRESSED_MESSAGE_LENGTH] instead of
+		 * the length, followed by the raw and the compressed lengths.
+		 */
+		static constexpr int32_t COMPRESSED_MESSAGE_LENGTH = -3;
+		static constexpr int32_t COMPRESSED_PACKAGE_HEADER_LENGTH = PACKAGE_HEADER_LENGTH + 2 * sizeof(int32_t);
+		/**
+		 * \brief Packages shorter than this are sent as is.
+		 */
+		static constexpr int32_t COMPRESSION_THRESHOLD = 256;
+
+		std::atomic<bool> compression_enabled{false};
+		/**
+		 * \brief Set when the counterpart announced it reads compressed packages, reset on every connection.
+		 */
+		mutable std::atomic<bool> counterpart_decompresses{false};
+		/**
+		 * \brief Set in the length of a message written in [Buffer::is_compact] mode, lengths never reach it.
+		 */
+		static constexpr int32_t COMPACT_MESSAGE_FLAG = 1 << 30;
+
+		std::atomic<bool> compact_encoding_enabled{false};
+		/**
+		 * \brief Set when the counterpart announced it reads compact messages, reset on every connection.
+		 */
+		mutable std::atomic<bool> counterpart_reads_compact{false};
+
+		std::atomic<bool> batch_messages_enabled{false};
+		/**
+		 * \brief Set when the counterpart announced it reads [MessageBatch]es, reset on every connection.
+		 */
+		mutable std::atomic<bool> counterpart_reads_batches_{false};
+		/**
+		 * \brief Mode of the message being read, taken from its length.
+		 */
+		mutable bool message_compact = false;
+		mutable bool capabilities_sent = false;
+		mutable Buffer compressed_package_header{COMPRESSED_PACKAGE_HEADER_LENGTH};
+		mutable Buffer::ByteArray compressed_send_buffer;
+		mutable Buffer::ByteArray compressed_receive_buffer;
+
+		/**
+		 * \brief Set while a capture is running, accessed with std::atomic_load and std::atomic_store.
+		 */
+		std::shared_ptr<WireCapture> capture;
+
+		mutable std::atomic<int64_t> raw_bytes_sent{0};
+		mutable std::atomic<int64_t> compressed_bytes_sent{0};
+		mutable std::atomic<int64_t> raw_bytes_received{0};
+		mutable std::atomic<int64_t> compressed_bytes_received{0};
+
 		bool read_from_socket(Buffer::word_t* res, int32_t msglen) const;
 
 		template <typename T>
@@ -98,11 +172,44 @@ public:
 			return read_from_socket(reinterpret_cast<Buffer::word_t*>(data), static_cast<int32_t>(len));
 		}
 
+		/**
+		 * \brief Tells the counterpart this wire reads compressed packages, compact messages and batches. Sent as a regular message to
+		 * a reserved id, so peers without their support just ignore it and keep receiving plain packages.
+		 */
+		void send_capabilities() const;
+
+		bool read_compressed_package(int32_t& len) const;
+
 		void set_socket_provider(std::shared_ptr<CActiveSocket> new_socket);
 
-		CSimpleSocket* get_socket_provider() const;
+		/**
+		 * \brief Runs a connection session over [new_stream] until it's closed or the wire is terminated.
+		 */
+		void set_socket_provider(std::shared_ptr<ByteStream> new_stream);
+
+		ByteStream* get_socket_provider() const;
+
+		/**
+		 * \brief Waits [delay] before the next connection attempt, the delay is armed on the shared timer.
+		 * \return false if [lifetime] was terminated meanwhile.
+		 */
+		bool wait_for_reconnect(Lifetime const& lifetime, std::chrono::milliseconds delay);
 
 	public:
+		struct CompressionStats
+		{
+			/**
+			 * \brief Payload bytes of packages sent compressed, before and after compression.
+			 */
+			int64_t raw_bytes_sent = 0;
+			int64_t compressed_bytes_sent = 0;
+			/**
+			 * \brief Payload bytes of packages received compressed, before and after decompression.
+			 */
+			int64_t compressed_bytes_received = 0;
+			int64_t raw_bytes_received = 0;
+		};
+
 		static constexpr int32_t MaximumHeartbeatDelay = 3;
 		std::chrono::milliseconds heartBeatInterval = std::chrono::milliseconds(500);
 
@@ -126,15 +233,60 @@ public:
 
 		void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const override;
 
+		void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer, MessagePriority priority) const override;
+
 		static bool connection_established(int32_t timestamp, int32_t acknowledged_timestamp);
 
-		std::future<void> start_heartbeat(Lifetime lifetime);
+		/**
+		 * \brief Pings the counterpart every [heartBeatInterval] until [lifetime] terminates: the shared timer only asks
+		 * [async_send_buffer] for a ping, its thread writes it, so a slow socket never holds up the timer.
+		 */
+		void start_heartbeat(Lifetime lifetime);
 
 		void ping() const;
 
 		bool send_ack(sequence_number_t seqn) const;
 
 		bool try_shutdown_connection() const;
+
+		/**
+		 * \brief Compresses packages over [COMPRESSION_THRESHOLD] bytes once the counterpart announces it can read them.
+		 * Takes effect from the next connection.
+		 */
+		void set_compression_enabled(bool enabled);
+
+		/**
+		 * \brief Writes messages in [Buffer::is_compact] mode once the counterpart announces it can read them. Both sides
+		 * must run the same model: unknown polymorphic values are forwarded as the bytes they were received as. Set it
+		 * before connecting, capabilities are exchanged when a connection starts.
+		 */
+		void set_compact_encoding_enabled(bool enabled);
+
+		/**
+		 * \brief Sends the changes collections make in a batch, e.g. [RdMap::batch], as one message once the counterpart
+		 * announces it can read them. Takes effect from the next connection.
+		 */
+		void set_batch_messages_enabled(bool enabled);
+
+		bool counterpart_reads_batches() const override;
+
+		CompressionStats get_compression_stats() const;
+
+		WireMetrics::Snapshot get_metrics_snapshot() const override;
+
+		/**
+		 * \brief Records messages sent and dispatched by this wire to [path] until [stop_capture], replaces a running
+		 * capture. Throws if the file can't be opened.
+		 */
+		void start_capture(std::string const& path);
+
+		void stop_capture();
+
+		/**
+		 * \brief Where the counterpart connects to, written into the port file: the port number for TCP,
+		 * `unix:<path>` or `shm:<name>` for the local transports.
+		 */
+		virtual std::string get_address() const = 0;
 		
 	private:		
 		LifetimeDefinition lifetimeDef;
@@ -152,8 +304,10 @@ public:
 		virtual ~Client() override;
 		// endregion
 
-		std::condition_variable_any cv;
-	private:		
+		std::string get_address() const override;
+
+	private:
+		
 		LifetimeDefinition clientLifetimeDefinition;
 	};
 
@@ -170,6 +324,8 @@ public:
 
 		virtual ~Server() override;
 		// endregion
+
+		std::string get_address() const override;
 	private:
 		LifetimeDefinition serverLifetimeDefinition;
 	};
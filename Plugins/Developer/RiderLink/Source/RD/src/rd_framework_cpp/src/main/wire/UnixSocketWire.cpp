@@ -0,0 +1,324 @@
+#include "wire/UnixSocketWire.h"
+
+#include <util/thread_util.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace rd
+{
+std::chrono::milliseconds UnixSocketWire::timeout = std::chrono::milliseconds(500);
+
+#if !defined(_WIN32)
+namespace
+{
+/**
+ * \brief ByteStream over a connected AF_UNIX socket, owns the descriptor.
+ */
+class UnixByteStream final : public ByteStream
+{
+	int fd;
+	std::atomic<bool> valid{true};
+	std::atomic<int> last_error{0};
+
+public:
+	explicit UnixByteStream(int fd) : fd(fd)
+	{
+#if defined(SO_NOSIGPIPE)
+		int on = 1;
+		setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+	}
+
+	~UnixByteStream() override
+	{
+		::close(fd);
+	}
+
+	int32_t send(uint8_t const* data, int32_t len) override
+	{
+#if defined(MSG_NOSIGNAL)
+		constexpr int flags = MSG_NOSIGNAL;
+#else
+		constexpr int flags = 0;
+#endif
+		int32_t sent = 0;
+		while (sent < len)
+		{
+			const ssize_t n = ::send(fd, data + sent, static_cast<size_t>(len - sent), flags);
+			if (n < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				last_error = errno;
+				valid = false;
+				break;
+			}
+			sent += static_cast<int32_t>(n);
+		}
+		return sent;
+	}
+
+	int32_t receive(uint8_t* data, int32_t len) override
+	{
+		while (true)
+		{
+			const ssize_t n = ::recv(fd, data, static_cast<size_t>(len), 0);
+			if (n < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (n < 0)
+			{
+				last_error = errno;
+				valid = false;
+				return -1;
+			}
+			return static_cast<int32_t>(n);
+		}
+	}
+
+	bool is_valid() const override
+	{
+		return valid;
+	}
+
+	bool shutdown() override
+	{
+		valid = false;
+		return ::shutdown(fd, SHUT_RDWR) == 0;
+	}
+
+	std::string describe_error() const override
+	{
+		return std::strerror(last_error);
+	}
+};
+
+sockaddr_un make_address(std::string const& path)
+{
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	RD_ASSERT_THROW_MSG(path.size() < sizeof(address.sun_path), "unix socket path is too long: " + path);
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+	return address;
+}
+
+std::string make_default_path()
+{
+	static std::atomic<int32_t> counter{0};
+	char const* tmp = std::getenv("TMPDIR");
+	std::string dir = tmp != nullptr && *tmp != '\0' ? tmp : "/tmp";
+	if (dir.back() == '/')
+	{
+		dir.pop_back();
+	}
+	return dir + "/rd-" + std::to_string(getpid()) + "-" + std::to_string(counter++) + ".sock";
+}
+}	 // namespace
+
+bool UnixSocketWire::is_supported()
+{
+	return true;
+}
+
+UnixSocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, std::string path, const std::string& id)
+	: Base(id, parentLifetime, scheduler), path(std::move(path)), clientLifetimeDefinition(parentLifetime)
+{
+	Lifetime lifetime = clientLifetimeDefinition.lifetime;
+	thread = std::thread([this, lifetime]() mutable {
+		rd::util::set_thread_name(this->id.empty() ? "UnixSocketWire::Client Thread" : this->id.c_str());
+
+		logger->info("{}: started, path: {}.", this->id, this->path);
+		while (!lifetime->is_terminated())
+		{
+			try
+			{
+				const sockaddr_un address = make_address(this->path);
+				const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+				RD_ASSERT_THROW_MSG(fd >= 0, fmt::format("{}: failed to create socket, reason: {}", this->id, std::strerror(errno)));
+				auto stream = std::make_shared<UnixByteStream>(fd);
+				RD_ASSERT_THROW_MSG(::connect(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) == 0,
+					fmt::format("{}: failed to connect to {}, reason: {}", this->id, this->path, std::strerror(errno)));
+				{
+					std::lock_guard<decltype(lock)> guard(lock);
+					if (lifetime->is_terminated())
+					{
+						break;
+					}
+					connection = stream;
+				}
+
+				set_socket_provider(std::static_pointer_cast<ByteStream>(stream));
+			}
+			catch (std::exception const& e)
+			{
+				logger->debug("{}: connection error for {} ({}).", this->id, this->path, e.what());
+			}
+			if (!wait_for_reconnect(lifetime, timeout))
+			{
+				break;
+			}
+		}
+		logger->info("{}: terminated, path: {}.", this->id, this->path);
+	});
+
+	lifetime->add_action([this]() {
+		logger->info("{}: starts terminating lifetime", this->id);
+
+		const bool send_buffer_stopped = async_send_buffer.stop(timeout);
+		logger->debug("{}: send buffer stopped, success: {}", this->id, send_buffer_stopped);
+
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			if (connection != nullptr)
+			{
+				connection->shutdown();
+			}
+		}
+		reconnect_cv.notify_all();
+
+		thread.join();
+		logger->info("{}: termination finished", this->id);
+	});
+}
+
+UnixSocketWire::Client::~Client()
+{
+	if (!clientLifetimeDefinition.is_terminated())
+	{
+		clientLifetimeDefinition.terminate();
+	}
+}
+
+UnixSocketWire::Server::Server(Lifetime parentLifetime, IScheduler* scheduler, std::string path, const std::string& id)
+	: Base(id, parentLifetime, scheduler)
+	, path(path.empty() ? make_default_path() : std::move(path))
+	, serverLifetimeDefinition(parentLifetime)
+{
+	const sockaddr_un address = make_address(this->path);
+	listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	RD_ASSERT_THROW_MSG(listen_fd >= 0, fmt::format("{}: failed to create socket, reason: {}", this->id, std::strerror(errno)));
+
+	// stale file of a crashed process would make bind fail
+	::unlink(this->path.c_str());
+	if (::bind(listen_fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 || ::listen(listen_fd, 1) != 0)
+	{
+		const std::string reason = std::strerror(errno);
+		::close(listen_fd);
+		RD_ASSERT_THROW_MSG(false, fmt::format("{}: failed to listen on {}, reason: {}", this->id, this->path, reason));
+	}
+	logger->info("{}: listening {}", this->id, this->path);
+
+	Lifetime lifetime = serverLifetimeDefinition.lifetime;
+	thread = std::thread([this, lifetime]() mutable {
+		rd::util::set_thread_name(this->id.empty() ? "UnixSocketWire::Server Thread" : this->id.c_str());
+
+		logger->info("{}: started, path: {}.", this->id, this->path);
+		while (!lifetime->is_terminated())
+		{
+			try
+			{
+				// polled with timeout, so termination is noticed without closing the descriptor under accept
+				pollfd pending{listen_fd, POLLIN, 0};
+				const int ready = ::poll(&pending, 1, 300);
+				if (ready <= 0)
+				{
+					continue;
+				}
+				const int fd = ::accept(listen_fd, nullptr, nullptr);
+				RD_ASSERT_THROW_MSG(fd >= 0, fmt::format("{}: accepting failed, reason: {}", this->id, std::strerror(errno)));
+				auto stream = std::make_shared<UnixByteStream>(fd);
+				logger->info("{}: accepted connection", this->id);
+				{
+					std::lock_guard<decltype(lock)> guard(lock);
+					if (lifetime->is_terminated())
+					{
+						break;
+					}
+					connection = stream;
+				}
+
+				set_socket_provider(std::static_pointer_cast<ByteStream>(stream));
+			}
+			catch (std::exception const& e)
+			{
+				logger->info("{}: closed with exception: {}", this->id, e.what());
+			}
+		}
+		logger->info("{}: terminated, path: {}.", this->id, this->path);
+	});
+
+	lifetime->add_action([this] {
+		logger->info("{}: start terminating lifetime", this->id);
+
+		const bool send_buffer_stopped = async_send_buffer.stop(timeout);
+		logger->debug("{}: send buffer stopped, success: {}", this->id, send_buffer_stopped);
+
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			if (connection != nullptr)
+			{
+				connection->shutdown();
+			}
+		}
+
+		thread.join();
+		::close(listen_fd);
+		::unlink(this->path.c_str());
+		logger->info("{}: termination finished", this->id);
+	});
+}
+
+UnixSocketWire::Server::~Server()
+{
+	if (!serverLifetimeDefinition.is_terminated())
+	{
+		serverLifetimeDefinition.terminate();
+	}
+}
+#else
+bool UnixSocketWire::is_supported()
+{
+	return false;
+}
+
+UnixSocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, std::string path, const std::string& id)
+	: Base(id, parentLifetime, scheduler), path(std::move(path)), clientLifetimeDefinition(parentLifetime)
+{
+	throw std::runtime_error("unix domain socket wire isn't supported on this platform");
+}
+
+UnixSocketWire::Client::~Client() = default;
+
+UnixSocketWire::Server::Server(Lifetime parentLifetime, IScheduler* scheduler, std::string path, const std::string& id)
+	: Base(id, parentLifetime, scheduler), path(std::move(path)), serverLifetimeDefinition(parentLifetime)
+{
+	throw std::runtime_error("unix domain socket wire isn't supported on this platform");
+}
+
+UnixSocketWire::Server::~Server() = default;
+#endif
+
+std::string UnixSocketWire::Client::get_address() const
+{
+	return "unix:" + path;
+}
+
+std::string UnixSocketWire::Server::get_address() const
+{
+	return "unix:" + path;
+}
+}	 // namespace rd
@@ -0,0 +1,78 @@
+#ifndef RD_CPP_UNIXSOCKETWIRE_H
+#define RD_CPP_UNIXSOCKETWIRE_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "SocketWire.h"
+
+#include <string>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief SocketWire protocol (same framing, acknowledges and heartbeats) over an AF_UNIX stream socket, for
+ * counterparts on the same machine. Skips the TCP stack and needs no Nagle workaround.
+ *
+ * Available on POSIX platforms, see [is_supported].
+ */
+class RD_FRAMEWORK_API UnixSocketWire
+{
+	static std::chrono::milliseconds timeout;
+
+public:
+	static bool is_supported();
+
+	class RD_FRAMEWORK_API Client : public SocketWire::Base
+	{
+	public:
+		std::string path;
+
+		// region ctor/dtor
+
+		Client(Lifetime parentLifetime, IScheduler* scheduler, std::string path, const std::string& id = "UnixClientSocket");
+
+		virtual ~Client() override;
+		// endregion
+
+		std::string get_address() const override;
+
+	private:
+		std::shared_ptr<ByteStream> connection;
+		LifetimeDefinition clientLifetimeDefinition;
+	};
+
+	class RD_FRAMEWORK_API Server : public SocketWire::Base
+	{
+	public:
+		/**
+		 * \brief Socket file, a fresh one in the temp directory if empty path was given.
+		 */
+		std::string path;
+
+		// region ctor/dtor
+
+		Server(Lifetime parentLifetime, IScheduler* scheduler, std::string path = "", const std::string& id = "UnixServerSocket");
+
+		virtual ~Server() override;
+		// endregion
+
+		std::string get_address() const override;
+
+	private:
+		int listen_fd = -1;
+		std::shared_ptr<ByteStream> connection;
+		LifetimeDefinition serverLifetimeDefinition;
+	};
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_UNIXSOCKETWIRE_H
@@ -0,0 +1,93 @@
+#include "wire/WireCapture.h"
+
+#include "util/core_util.h"
+
+#include <stdexcept>
+
+namespace rd
+{
+namespace
+{
+template <typename T>
+void write_integral(std::ofstream& out, T value)
+{
+	out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_integral(std::ifstream& in, T& value)
+{
+	return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}	 // namespace
+
+constexpr uint32_t WireCapture::MAGIC;
+constexpr uint32_t WireCapture::VERSION;
+constexpr uint8_t WireCapture::FLAG_COMPACT;
+
+WireCapture::WireCapture(std::string const& path)
+	: out(path, std::ios::binary | std::ios::trunc), start(std::chrono::steady_clock::now())
+{
+	RD_ASSERT_THROW_MSG(out.is_open(), "failed to open wire capture file: " + path);
+	write_integral(out, MAGIC);
+	write_integral(out, VERSION);
+}
+
+WireCapture::~WireCapture()
+{
+	flush();
+}
+
+void WireCapture::record(
+	Direction direction, sequence_number_t seqn, RdId const& id, bool compact, Buffer::word_t const* data, size_t len)
+{
+	const auto timestamp =
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	write_integral(out, static_cast<uint8_t>(direction));
+	write_integral(out, static_cast<uint8_t>(compact ? FLAG_COMPACT : 0));
+	write_integral(out, static_cast<int64_t>(timestamp));
+	write_integral(out, static_cast<int64_t>(seqn));
+	write_integral(out, id.get_hash());
+	write_integral(out, static_cast<int32_t>(len));
+	out.write(reinterpret_cast<char const*>(data), static_cast<std::streamsize>(len));
+}
+
+void WireCapture::flush()
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	out.flush();
+}
+
+WireCaptureReader::WireCaptureReader(std::string const& path) : in(path, std::ios::binary)
+{
+	RD_ASSERT_THROW_MSG(in.is_open(), "failed to open wire capture file: " + path);
+	uint32_t magic = 0;
+	RD_ASSERT_THROW_MSG(read_integral(in, magic) && magic == WireCapture::MAGIC, "not a wire capture file: " + path);
+	RD_ASSERT_THROW_MSG(read_integral(in, version) && version >= 1 && version <= WireCapture::VERSION,
+		"unsupported wire capture version " + std::to_string(version) + ": " + path);
+}
+
+bool WireCaptureReader::next(WireCapture::Record& record)
+{
+	uint8_t direction = 0;
+	uint8_t flags = 0;
+	int64_t timestamp = 0;
+	int64_t seqn = 0;
+	RdId::hash_t id = 0;
+	int32_t len = 0;
+	if (!read_integral(in, direction) || (version >= 2 && !read_integral(in, flags)) || !read_integral(in, timestamp) ||
+		!read_integral(in, seqn) || !read_integral(in, id) || !read_integral(in, len) || len < 0)
+	{
+		return false;
+	}
+	record.direction = static_cast<WireCapture::Direction>(direction);
+	record.timestamp = std::chrono::microseconds(timestamp);
+	record.seqn = seqn;
+	record.id = RdId(id);
+	record.compact = (flags & WireCapture::FLAG_COMPACT) != 0;
+	record.payload.resize(static_cast<size_t>(len));
+	return len == 0 || static_cast<bool>(in.read(reinterpret_cast<char*>(record.payload.data()), len));
+}
+}	 // namespace rd
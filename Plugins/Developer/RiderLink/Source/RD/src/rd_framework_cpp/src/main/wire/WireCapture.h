@@ -0,0 +1,102 @@
+#ifndef RD_CPP_WIRECAPTURE_H
+#define RD_CPP_WIRECAPTURE_H
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4251)
+#endif
+
+#include "protocol/Buffer.h"
+#include "protocol/RdId.h"
+#include "ByteBufferAsyncProcessor.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Binary recording of the messages passed through a wire, read back by [WireCaptureReader].
+ *
+ * File is the magic "RDCP" and the format version, followed by records of direction (uint8), flags (uint8, [FLAG_COMPACT]
+ * if the payload is in [Buffer::is_compact] mode), microseconds since the capture start (int64), package sequence number
+ * (int64), RdId (int64), payload length (int32) and the payload as [MessageBroker::dispatch] receives it. Version 1
+ * captures have no flags. Outgoing messages are recorded before sequence numbers are assigned, so
+ * their [seqn] is 0.
+ */
+class RD_FRAMEWORK_API WireCapture
+{
+public:
+	enum class Direction : uint8_t
+	{
+		Incoming = 0,
+		Outgoing = 1
+	};
+
+	struct Record
+	{
+		Direction direction = Direction::Incoming;
+		std::chrono::microseconds timestamp{0};
+		sequence_number_t seqn = 0;
+		RdId id = RdId::Null();
+		bool compact = false;
+		Buffer::ByteArray payload;
+	};
+
+	static constexpr uint32_t MAGIC = 0x50434452;	 // "RDCP"
+	static constexpr uint32_t VERSION = 2;
+	static constexpr uint8_t FLAG_COMPACT = 1;
+
+private:
+	std::mutex lock;
+	std::ofstream out;
+	std::chrono::steady_clock::time_point start;
+
+public:
+	// region ctor/dtor
+
+	/**
+	 * \brief Creates or truncates the file at [path], throws if it can't be opened.
+	 */
+	explicit WireCapture(std::string const& path);
+
+	~WireCapture();
+	// endregion
+
+	void record(
+		Direction direction, sequence_number_t seqn, RdId const& id, bool compact, Buffer::word_t const* data, size_t len);
+
+	void flush();
+};
+
+class RD_FRAMEWORK_API WireCaptureReader
+{
+	std::ifstream in;
+	uint32_t version = 0;
+
+public:
+	// region ctor/dtor
+
+	/**
+	 * \brief Opens a capture written by [WireCapture], throws if it can't be opened or isn't a capture.
+	 */
+	explicit WireCaptureReader(std::string const& path);
+	// endregion
+
+	/**
+	 * \brief Reads the next record into [record].
+	 * \return false at the end of the capture, a truncated last record is treated as the end.
+	 */
+	bool next(WireCapture::Record& record);
+};
+}	 // namespace rd
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+
+#endif	  // RD_CPP_WIRECAPTURE_H
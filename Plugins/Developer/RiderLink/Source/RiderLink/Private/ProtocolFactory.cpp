@@ -1,7 +1,9 @@
 #include "ProtocolFactory.h"
 
 #include "scheduler/base/IScheduler.h"
+#include "wire/ShmWire.h"
 #include "wire/SocketWire.h"
+#include "wire/UnixSocketWire.h"
 
 #include "Runtime/Launch/Resources/Version.h"
 
@@ -28,6 +30,17 @@
 
 #include "spdlog/sinks/daily_file_sink.h"
 
+static FString ReadEnvironmentVariable(const FString& EnvironmentVarName)
+{
+#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION <= 20
+    TCHAR Value[4096];
+    FPlatformMisc::GetEnvironmentVariable(*EnvironmentVarName, Value, ARRAY_COUNT(Value));
+    return Value;
+#else
+    return FPlatformMisc::GetEnvironmentVariable(*EnvironmentVarName);
+#endif
+}
+
 static FString GetLocalAppdataFolder()
 {
     const FString EnvironmentVarName =
@@ -36,13 +49,7 @@ TEXT("LOCALAPPDATA");
 #else
     TEXT("HOME");
 #endif
-#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION <= 20
-    TCHAR CAppDataLocalPath[4096];
-    FPlatformMisc::GetEnvironmentVariable(*EnvironmentVarName, CAppDataLocalPath, ARRAY_COUNT(CAppDataLocalPath));
-    return CAppDataLocalPath;
-#else
-    return FPlatformMisc::GetEnvironmentVariable(*EnvironmentVarName);
-#endif
+    return ReadEnvironmentVariable(EnvironmentVarName);
 }
 
 static FString GetMiscFilesFolder()
@@ -96,16 +103,69 @@ void ProtocolFactory::InitRdLogging()
 #endif
 }
 
-std::shared_ptr<rd::SocketWire::Server> ProtocolFactory::CreateWire(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime)
+std::shared_ptr<rd::SocketWire::Base> ProtocolFactory::CreateWire(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime)
 {
     const FString ProjectName = GetProjectName();
-    return std::make_shared<rd::SocketWire::Server>(SocketLifetime, Scheduler, 0,
-                                                         TCHAR_TO_UTF8(*FString::Printf(TEXT("UnrealEditorServer-%s"),
-                                                             *ProjectName)));
+    const FString Transport = ReadEnvironmentVariable(TEXT("RIDER_LINK_TRANSPORT"));
+    std::shared_ptr<rd::SocketWire::Base> Wire;
+    std::string WireId;
+    if (Transport == TEXT("unix") && rd::UnixSocketWire::is_supported())
+    {
+        WireId = TCHAR_TO_UTF8(*FString::Printf(TEXT("UnrealEditorUnixServer-%s"), *ProjectName));
+        Wire = std::make_shared<rd::UnixSocketWire::Server>(SocketLifetime, Scheduler, "", WireId);
+    }
+    else if (Transport == TEXT("shm") && rd::ShmWire::is_supported())
+    {
+        WireId = TCHAR_TO_UTF8(*FString::Printf(TEXT("UnrealEditorShmServer-%s"), *ProjectName));
+        Wire = std::make_shared<rd::ShmWire::Server>(SocketLifetime, Scheduler, "", rd::ShmWire::DEFAULT_CAPACITY, WireId);
+    }
+    else
+    {
+        WireId = TCHAR_TO_UTF8(*FString::Printf(TEXT("UnrealEditorServer-%s"), *ProjectName));
+        Wire = std::make_shared<rd::SocketWire::Server>(SocketLifetime, Scheduler, 0, WireId);
+    }
+    // Rider connects after reading the port file, so the wire isn't connected yet
+    if (ReadEnvironmentVariable(TEXT("RIDER_LINK_COMPRESSION")) == TEXT("1"))
+    {
+        Wire->set_compression_enabled(true);
+    }
+    if (ReadEnvironmentVariable(TEXT("RIDER_LINK_COMPACT")) == TEXT("1"))
+    {
+        Wire->set_compact_encoding_enabled(true);
+    }
+    if (ReadEnvironmentVariable(TEXT("RIDER_LINK_BATCH")) == TEXT("1"))
+    {
+        Wire->set_batch_messages_enabled(true);
+    }
+    const FString CapturePath = ReadEnvironmentVariable(TEXT("RIDER_LINK_CAPTURE"));
+    if (!CapturePath.IsEmpty())
+    {
+        Wire->start_capture(TCHAR_TO_UTF8(*CapturePath));
+    }
+    const FString TracePath = ReadEnvironmentVariable(TEXT("RIDER_LINK_TRACE"));
+    if (!TracePath.IsEmpty())
+    {
+        Wire->start_trace(1 << 16);
+        const std::weak_ptr<rd::SocketWire::Base> WeakWire = Wire;
+        SocketLifetime->add_action([WeakWire, Path = std::string(TCHAR_TO_UTF8(*TracePath))]()
+        {
+            if (const auto TracedWire = WeakWire.lock())
+            {
+                TracedWire->get_trace_ring().save(Path);
+            }
+        });
+    }
+    const int32 MetricsInterval = FCString::Atoi(*ReadEnvironmentVariable(TEXT("RIDER_LINK_METRICS")));
+    if (MetricsInterval > 0)
+    {
+        Wire->set_metrics_enabled(true);
+        Wire->start_metrics_dump(SocketLifetime, std::chrono::seconds(MetricsInterval), WireId);
+    }
+    return Wire;
 }
 
 
-TUniquePtr<rd::Protocol> ProtocolFactory::CreateProtocol(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime, std::shared_ptr<rd::SocketWire::Server> wire)
+TUniquePtr<rd::Protocol> ProtocolFactory::CreateProtocol(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime, std::shared_ptr<rd::SocketWire::Base> wire)
 {
     const FString ProjectName = GetProjectName();
 
@@ -117,7 +177,8 @@ TUniquePtr<rd::Protocol> ProtocolFactory::CreateProtocol(rd::IScheduler* Schedul
     {
         const FString TmpPortFile = TEXT("~") + ProjectName;
         const FString TmpPortFileFullPath = FPaths::Combine(*PortFullDirectoryPath, *TmpPortFile);
-        FFileHelper::SaveStringToFile(FString::FromInt(wire->port), *TmpPortFileFullPath);
+        // bare port number for TCP, as before; "unix:<path>" or "shm:<name>" for the local transports
+        FFileHelper::SaveStringToFile(UTF8_TO_TCHAR(wire->get_address().c_str()), *TmpPortFileFullPath);
         const FString PortFileFullPath = FPaths::Combine(*PortFullDirectoryPath, *ProjectName);
         IFileManager::Get().Move(*PortFileFullPath, *TmpPortFileFullPath, true, true);
     }
@@ -7,6 +7,16 @@
 
 namespace ProtocolFactory {
     void InitRdLogging();
-    std::shared_ptr<rd::SocketWire::Server> CreateWire(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime);
-    TUniquePtr<rd::Protocol> CreateProtocol(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime, std::shared_ptr<rd::SocketWire::Server> wire);
+    // Transport is chosen by RIDER_LINK_TRANSPORT (tcp, unix or shm), TCP if unset or unsupported on this platform.
+    // Port file receives the wire address, so counterpart learns the transport from it.
+    // RIDER_LINK_COMPRESSION=1 compresses packages for counterparts that announce support for it.
+    // RIDER_LINK_COMPACT=1 writes lengths, enums and versions as varints for counterparts that announce support for it.
+    // RIDER_LINK_BATCH=1 sends the changes a collection makes in a batch as one message, for counterparts that announce
+    // support for it.
+    // RIDER_LINK_CAPTURE=<file> records the session's messages for offline replay with rd::ReplayWire.
+    // RIDER_LINK_TRACE=<file> keeps the last 65536 messages' entity, direction and size, saved to the file when the
+    // connection ends and decoded with rd::TraceRing::load.
+    // RIDER_LINK_METRICS=<seconds> counts messages per entity and dumps the counters to the rd log at that interval.
+    std::shared_ptr<rd::SocketWire::Base> CreateWire(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime);
+    TUniquePtr<rd::Protocol> CreateProtocol(rd::IScheduler* Scheduler, rd::Lifetime SocketLifetime, std::shared_ptr<rd::SocketWire::Base> wire);
 };
@@ -35,7 +35,7 @@ void FRiderLinkModule::InitProtocol()
 {
 	WireLifetimeDef = MakeUnique<rd::LifetimeDefinition>(ModuleLifetimeDef.lifetime);
 	rd::Lifetime WireLifetime = WireLifetimeDef->lifetime;
-	std::shared_ptr<rd::SocketWire::Server> Wire = ProtocolFactory::CreateWire(&Scheduler, WireLifetime);
+	std::shared_ptr<rd::SocketWire::Base> Wire = ProtocolFactory::CreateWire(&Scheduler, WireLifetime);
 	Protocol = ProtocolFactory::CreateProtocol(&Scheduler, WireLifetime.create_nested(), Wire);
 	// Exception fired for Server::Base::~Base() when trying to invoke it this way
 //	WireLifetime->add_action([this]()
@@ -56,6 +56,9 @@ void FRiderLinkModule::InitProtocol()
 
 			FRWScopeLock LockOnConnect(ModelLock, SLT_Write);
 			EditorModel = MakeUnique<JetBrains::EditorPlugin::RdEditorModel>();
+			// lanes aren't part of the model definition, so they are set here before the model is bound
+			dynamic_cast<rd::RdReactiveBase const&>(EditorModel->get_unrealLog()).priority = rd::MessagePriority::Bulk;
+			EditorModel->get_allowSetForegroundWindow().priority = rd::MessagePriority::Interactive;
 			EditorModel->connect(ConnectionLifetime, Protocol.Get());
 			JetBrains::EditorPlugin::UE4Library::serializersOwner.registerSerializersCore(
 				EditorModel->get_serialization_context().get_serializers()
@@ -3,7 +3,11 @@
 #include "IRiderLink.hpp"
 #include "impl/RdProperty.h"
 #include "lifetime/LifetimeDefinition.h"
+#if defined(ENABLE_MPSC_SCHEDULER) && ENABLE_MPSC_SCHEDULER == 1
+#include "scheduler/MpscScheduler.h"
+#else
 #include "scheduler/SingleThreadScheduler.h"
+#endif
 #include "wire/SocketWire.h"
 
 #include "Logging/LogMacros.h"
@@ -45,7 +49,11 @@ private:
 	void InitProtocol();
 
 	rd::LifetimeDefinition ModuleLifetimeDef{rd::Lifetime::Eternal()};
+#if defined(ENABLE_MPSC_SCHEDULER) && ENABLE_MPSC_SCHEDULER == 1
+	rd::MpscScheduler Scheduler{ModuleLifetimeDef.lifetime, "MainScheduler"};
+#else
 	rd::SingleThreadScheduler Scheduler{ModuleLifetimeDef.lifetime, "MainScheduler"};
+#endif
 	TUniquePtr<rd::LifetimeDefinition> WireLifetimeDef;
 	TUniquePtr<rd::Protocol> Protocol;
 	rd::RdProperty<bool> RdIsModelAlive;
@@ -9,10 +9,16 @@
 namespace rd {
 
     FString Polymorphic<FString, void>::read(SerializationCtx& ctx, Buffer& buffer) {
-        UCS2CHAR * str = buffer.read_char16_string();
-        FString tmp{str};
-        delete str;
-        return tmp;
+        static_assert(sizeof(TCHAR) == sizeof(uint16_t), "FString is read as UTF-16 straight from the buffer");
+        const int32_t Len = buffer.read_string_length();
+        FString Result;
+        if (Len > 0) {
+            TArray<TCHAR>& Chars = Result.GetCharArray();
+            Chars.SetNumUninitialized(Len + 1);
+            buffer.read_char16_data(reinterpret_cast<uint16_t*>(Chars.GetData()), Len);
+            Chars[Len] = TEXT('\0');
+        }
+        return Result;
     }
 
     void Polymorphic<FString, void>::write(SerializationCtx& ctx, Buffer& buffer, FString const& value) {
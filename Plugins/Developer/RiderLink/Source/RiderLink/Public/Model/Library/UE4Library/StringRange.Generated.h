@@ -167,6 +167,27 @@ struct hash<JetBrains::EditorPlugin::StringRange> {
 
 }
 
+// fixed layout trait
+namespace rd {
+
+template <>
+struct fixed_layout<JetBrains::EditorPlugin::StringRange> {
+    static constexpr size_t size = sizeof(int32_t) + sizeof(int32_t);
+    
+    static void store(const JetBrains::EditorPlugin::StringRange & value, uint8_t* out) {
+        out = fixed_layout_util::store(out, value.get_first());
+        out = fixed_layout_util::store(out, value.get_last());
+    }
+    
+    static JetBrains::EditorPlugin::StringRange load(uint8_t const* in) {
+        auto first_ = fixed_layout_util::load<int32_t>(in);
+        auto last_ = fixed_layout_util::load<int32_t>(in);
+        return JetBrains::EditorPlugin::StringRange{std::move(first_), std::move(last_)};
+    }
+};
+
+}
+
 #ifdef __cpp_structured_bindings
 // tuple trait
 namespace std {
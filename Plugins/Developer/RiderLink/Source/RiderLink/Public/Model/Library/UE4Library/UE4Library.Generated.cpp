@@ -73,7 +73,7 @@ void UE4Library::connect(rd::Lifetime lifetime, rd::IProtocol const * protocol)
 {
     UE4Library::serializersOwner.registry(protocol->get_serializers());
     
-    identify(*(protocol->get_identity()), rd::RdId::Null().mix("UE4Library"));
+    identify(*(protocol->get_identity()), rd::RdId::Null().mix(RD_ID_SUFFIX("UE4Library")));
     bind(lifetime, protocol, "UE4Library");
 }
 
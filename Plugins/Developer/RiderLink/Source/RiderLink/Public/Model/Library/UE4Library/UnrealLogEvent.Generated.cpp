@@ -41,14 +41,8 @@ UnrealLogEvent UnrealLogEvent::read(rd::SerializationCtx& ctx, rd::Buffer & buff
 {
     auto info_ = LogMessageInfo::read(ctx, buffer);
     auto text_ = rd::Polymorphic<FString>::read(ctx, buffer);
-    auto bpPathRanges_ = buffer.read_array<TArray, StringRange, FDefaultAllocator>(
-    [&ctx, &buffer]() mutable  
-    { return StringRange::read(ctx, buffer); }
-    );
-    auto methodRanges_ = buffer.read_array<TArray, StringRange, FDefaultAllocator>(
-    [&ctx, &buffer]() mutable  
-    { return StringRange::read(ctx, buffer); }
-    );
+    auto bpPathRanges_ = buffer.read_array<TArray, StringRange, FDefaultAllocator>();
+    auto methodRanges_ = buffer.read_array<TArray, StringRange, FDefaultAllocator>();
     UnrealLogEvent res{std::move(info_), std::move(text_), std::move(bpPathRanges_), std::move(methodRanges_)};
     return res;
 }
@@ -57,14 +51,8 @@ void UnrealLogEvent::write(rd::SerializationCtx& ctx, rd::Buffer& buffer) const
 {
     rd::Polymorphic<std::decay_t<decltype(info_)>>::write(ctx, buffer, info_);
     rd::Polymorphic<std::decay_t<decltype(text_)>>::write(ctx, buffer, text_);
-    buffer.write_array<TArray, StringRange, FDefaultAllocator>(bpPathRanges_, 
-    [&ctx, &buffer](StringRange const & it) mutable  -> void 
-    { rd::Polymorphic<std::decay_t<decltype(it)>>::write(ctx, buffer, it); }
-    );
-    buffer.write_array<TArray, StringRange, FDefaultAllocator>(methodRanges_, 
-    [&ctx, &buffer](StringRange const & it) mutable  -> void 
-    { rd::Polymorphic<std::decay_t<decltype(it)>>::write(ctx, buffer, it); }
-    );
+    buffer.write_array<TArray, StringRange, FDefaultAllocator>(bpPathRanges_);
+    buffer.write_array<TArray, StringRange, FDefaultAllocator>(methodRanges_);
 }
 // virtual init
 // identify
@@ -34,7 +34,7 @@ void RdEditorModel::connect(rd::Lifetime lifetime, rd::IProtocol const * protoco
 {
     RdEditorRoot::serializersOwner.registry(protocol->get_serializers());
     
-    identify(*(protocol->get_identity()), rd::RdId::Null().mix("RdEditorModel"));
+    identify(*(protocol->get_identity()), rd::RdId::Null().mix(RD_ID_SUFFIX("RdEditorModel")));
     bind(lifetime, protocol, "RdEditorModel");
 }
 
@@ -87,22 +87,22 @@ void RdEditorModel::init(rd::Lifetime lifetime) const
 void RdEditorModel::identify(const rd::Identities &identities, rd::RdId const &id) const
 {
     rd::RdBindableBase::identify(identities, id);
-    identifyPolymorphic(unrealLog_, identities, id.mix(".unrealLog"));
-    identifyPolymorphic(openBlueprint_, identities, id.mix(".openBlueprint"));
-    identifyPolymorphic(onBlueprintAdded_, identities, id.mix(".onBlueprintAdded"));
-    identifyPolymorphic(isBlueprintPathName_, identities, id.mix(".isBlueprintPathName"));
-    identifyPolymorphic(getPathNameByPath_, identities, id.mix(".getPathNameByPath"));
-    identifyPolymorphic(allowSetForegroundWindow_, identities, id.mix(".allowSetForegroundWindow"));
-    identifyPolymorphic(isGameControlModuleInitialized_, identities, id.mix(".isGameControlModuleInitialized"));
-    identifyPolymorphic(playStateFromEditor_, identities, id.mix(".playStateFromEditor"));
-    identifyPolymorphic(requestPlayFromRider_, identities, id.mix(".requestPlayFromRider"));
-    identifyPolymorphic(requestPauseFromRider_, identities, id.mix(".requestPauseFromRider"));
-    identifyPolymorphic(requestResumeFromRider_, identities, id.mix(".requestResumeFromRider"));
-    identifyPolymorphic(requestStopFromRider_, identities, id.mix(".requestStopFromRider"));
-    identifyPolymorphic(requestFrameSkipFromRider_, identities, id.mix(".requestFrameSkipFromRider"));
-    identifyPolymorphic(notificationReplyFromEditor_, identities, id.mix(".notificationReplyFromEditor"));
-    identifyPolymorphic(playModeFromEditor_, identities, id.mix(".playModeFromEditor"));
-    identifyPolymorphic(playModeFromRider_, identities, id.mix(".playModeFromRider"));
+    identifyPolymorphic(unrealLog_, identities, id.mix(RD_ID_SUFFIX(".unrealLog")));
+    identifyPolymorphic(openBlueprint_, identities, id.mix(RD_ID_SUFFIX(".openBlueprint")));
+    identifyPolymorphic(onBlueprintAdded_, identities, id.mix(RD_ID_SUFFIX(".onBlueprintAdded")));
+    identifyPolymorphic(isBlueprintPathName_, identities, id.mix(RD_ID_SUFFIX(".isBlueprintPathName")));
+    identifyPolymorphic(getPathNameByPath_, identities, id.mix(RD_ID_SUFFIX(".getPathNameByPath")));
+    identifyPolymorphic(allowSetForegroundWindow_, identities, id.mix(RD_ID_SUFFIX(".allowSetForegroundWindow")));
+    identifyPolymorphic(isGameControlModuleInitialized_, identities, id.mix(RD_ID_SUFFIX(".isGameControlModuleInitialized")));
+    identifyPolymorphic(playStateFromEditor_, identities, id.mix(RD_ID_SUFFIX(".playStateFromEditor")));
+    identifyPolymorphic(requestPlayFromRider_, identities, id.mix(RD_ID_SUFFIX(".requestPlayFromRider")));
+    identifyPolymorphic(requestPauseFromRider_, identities, id.mix(RD_ID_SUFFIX(".requestPauseFromRider")));
+    identifyPolymorphic(requestResumeFromRider_, identities, id.mix(RD_ID_SUFFIX(".requestResumeFromRider")));
+    identifyPolymorphic(requestStopFromRider_, identities, id.mix(RD_ID_SUFFIX(".requestStopFromRider")));
+    identifyPolymorphic(requestFrameSkipFromRider_, identities, id.mix(RD_ID_SUFFIX(".requestFrameSkipFromRider")));
+    identifyPolymorphic(notificationReplyFromEditor_, identities, id.mix(RD_ID_SUFFIX(".notificationReplyFromEditor")));
+    identifyPolymorphic(playModeFromEditor_, identities, id.mix(RD_ID_SUFFIX(".playModeFromEditor")));
+    identifyPolymorphic(playModeFromRider_, identities, id.mix(RD_ID_SUFFIX(".playModeFromRider")));
 }
 // getters
 rd::ISignal<UnrealLogEvent> const & RdEditorModel::get_unrealLog() const
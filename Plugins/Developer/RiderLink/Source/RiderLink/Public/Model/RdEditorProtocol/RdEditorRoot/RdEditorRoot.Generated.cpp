@@ -37,7 +37,7 @@ void RdEditorRoot::connect(rd::Lifetime lifetime, rd::IProtocol const * protocol
 {
     RdEditorRoot::serializersOwner.registry(protocol->get_serializers());
     
-    identify(*(protocol->get_identity()), rd::RdId::Null().mix("RdEditorRoot"));
+    identify(*(protocol->get_identity()), rd::RdId::Null().mix(RD_ID_SUFFIX("RdEditorRoot")));
     bind(lifetime, protocol, "RdEditorRoot");
 }
 
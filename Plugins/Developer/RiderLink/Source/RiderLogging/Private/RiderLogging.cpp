@@ -102,7 +102,11 @@ void FRiderLoggingModule::StartupModule()
 	};
 
 	ModuleLifetimeDef = IRiderLinkModule::Get().CreateNestedLifetimeDefinition();
+#if defined(ENABLE_MPSC_SCHEDULER) && ENABLE_MPSC_SCHEDULER == 1
+	LoggingScheduler = MakeUnique<rd::MpscScheduler>(ModuleLifetimeDef.lifetime, "LoggingScheduler");
+#else
 	LoggingScheduler = MakeUnique<rd::SingleThreadScheduler>(ModuleLifetimeDef.lifetime, "LoggingScheduler");
+#endif
 	ModuleLifetimeDef.lifetime->bracket(
 	[this]()
 	{
@@ -9,7 +9,11 @@
 #include "Logging/LogMacros.h"
 #include "Logging/LogVerbosity.h"
 #include "Modules/ModuleInterface.h"
+#if defined(ENABLE_MPSC_SCHEDULER) && ENABLE_MPSC_SCHEDULER == 1
+#include "scheduler/MpscScheduler.h"
+#else
 #include "scheduler/SingleThreadScheduler.h"
+#endif
 
 DECLARE_LOG_CATEGORY_EXTERN(FLogRiderLoggingModule, Log, All);
 
@@ -25,7 +29,11 @@ public:
     virtual bool SupportsDynamicReloading() override { return true; }
 
 private:
+#if defined(ENABLE_MPSC_SCHEDULER) && ENABLE_MPSC_SCHEDULER == 1
+    TUniquePtr<rd::MpscScheduler> LoggingScheduler;
+#else
     TUniquePtr<rd::SingleThreadScheduler> LoggingScheduler;
+#endif
     FRiderOutputDevice OutputDevice;
     rd::LifetimeDefinition ModuleLifetimeDef;
 };
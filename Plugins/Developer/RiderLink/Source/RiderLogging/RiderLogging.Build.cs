@@ -14,6 +14,8 @@ public class RiderLogging : ModuleRules
 		
 		bUseRTTI = true;
 
+		PrivateDefinitions.Add("ENABLE_MPSC_SCHEDULER=0");
+
 		PrivateDependencyModuleNames.AddRange(new []
 		{
 			"Core",